@@ -0,0 +1,210 @@
+// jobshop_bench.c
+// Benchmark driver over libjobshop: times every requested algorithm and thread count on one
+// instance with the monotonic wall clock (wall_time_seconds: CLOCK_MONOTONIC / QPC), after a
+// warmup, and writes min/median/p95/mean/stddev plus speedup and parallel efficiency against
+// the sequential baseline of the same family as JSON for ultimate_analysis.ps1. Every timed
+// schedule is validated (schedule_validate), so a fast but wrong change cannot pass as a win.
+
+#include "../../Library/jobshop_solver.h"
+#include "../../Common/jobshop_schedule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define DEFAULT_WARMUP 1
+#define DEFAULT_REPETITIONS 10
+#define MAX_THREAD_COUNTS 16
+#define MAX_CASES 64
+
+typedef struct {
+    int algorithm;
+    int threads;
+    int best_makespan;
+    int worst_makespan;
+    int runs;
+    int invalid_runs;              // Timed runs whose schedule failed schedule_validate
+    double min_ms, median_ms, p95_ms, mean_ms, stddev_ms;
+    double speedup;                // 0 when no baseline was measured
+    double efficiency;             // Percent
+} BenchCase;
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of a sorted sample
+static double percentile(const double *sorted, int n, double p) {
+    int rank = (int)ceil(p * n);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return sorted[rank - 1];
+}
+
+static const char *family_name(int algorithm) {
+    return (algorithm == JOBSHOP_ALGO_SB_SEQ || algorithm == JOBSHOP_ALGO_SB_PAR) ? "ShiftingBottleneck" : "BranchAndBound";
+}
+
+static int is_sequential(int algorithm) {
+    return algorithm == JOBSHOP_ALGO_SB_SEQ || algorithm == JOBSHOP_ALGO_BB_SEQ;
+}
+
+static int measure(JobshopSolver *solver, BenchCase *c, int warmup, int repetitions, double *samples) {
+    JobshopOptions opt;
+    JobshopResult result;
+    jobshop_options_init(&opt);
+    opt.algorithm = c->algorithm;
+    opt.threads = c->threads;
+    for (int w = 0; w < warmup; w++) {
+        if (!jobshop_solver_solve(solver, &opt, &result)) return 0;
+    }
+    c->best_makespan = 0;
+    c->worst_makespan = 0;
+    c->invalid_runs = 0;
+    for (int r = 0; r < repetitions; r++) {
+        if (!jobshop_solver_solve(solver, &opt, &result)) return 0;
+        samples[r] = result.seconds * 1000.0;
+        ScheduleCheck check; // Outside the timed region
+        if (!schedule_validate(jobshop_solver_shop(solver), &check) || check.makespan != result.makespan) c->invalid_runs++;
+        if (r == 0 || result.makespan < c->best_makespan) c->best_makespan = result.makespan;
+        if (result.makespan > c->worst_makespan) c->worst_makespan = result.makespan;
+    }
+    double sum = 0.0, sq = 0.0;
+    for (int r = 0; r < repetitions; r++) sum += samples[r];
+    c->mean_ms = sum / repetitions;
+    for (int r = 0; r < repetitions; r++) sq += (samples[r] - c->mean_ms) * (samples[r] - c->mean_ms);
+    c->stddev_ms = repetitions > 1 ? sqrt(sq / (repetitions - 1)) : 0.0;
+    qsort(samples, repetitions, sizeof(double), compare_double);
+    c->min_ms = samples[0];
+    c->median_ms = (repetitions % 2) ? samples[repetitions / 2]
+                                     : 0.5 * (samples[repetitions / 2 - 1] + samples[repetitions / 2]);
+    c->p95_ms = percentile(samples, repetitions, 0.95);
+    c->runs = repetitions;
+    return 1;
+}
+
+static int write_json(const char *filename, const char *instance, const Shop *shop, int warmup, int repetitions,
+                      const BenchCase *cases, int ncases) {
+    FILE *f = fopen(filename, "w");
+    if (!f) return 0;
+    fprintf(f, "{\n  \"instance\": \"%s\",\n  \"jobs\": %d,\n  \"machines\": %d,\n", instance, shop->njobs, shop->nmachs);
+    fprintf(f, "  \"clock\": \"monotonic wall clock\",\n  \"warmup\": %d,\n  \"repetitions\": %d,\n  \"results\": [", warmup, repetitions);
+    for (int i = 0; i < ncases; i++) {
+        const BenchCase *c = &cases[i];
+        char implementation[32];
+        if (is_sequential(c->algorithm)) snprintf(implementation, sizeof(implementation), "Sequential");
+        else snprintf(implementation, sizeof(implementation), "Parallel_%dthreads", c->threads);
+        fprintf(f, "%s\n    {\"algorithm\": \"%s\", \"implementation\": \"%s\", \"threads\": %d, \"runs\": %d, "
+                "\"valid\": %s, \"makespan\": %d, \"makespan_worst\": %d, "
+                "\"time_ms\": {\"min\": %.6f, \"median\": %.6f, \"p95\": %.6f, \"mean\": %.6f, \"stddev\": %.6f}, ",
+                i ? "," : "", family_name(c->algorithm), implementation, c->threads, c->runs,
+                c->invalid_runs ? "false" : "true", c->best_makespan, c->worst_makespan, c->min_ms, c->median_ms, c->p95_ms, c->mean_ms, c->stddev_ms);
+        if (c->speedup > 0.0) fprintf(f, "\"speedup\": %.4f, \"efficiency\": %.2f}", c->speedup, c->efficiency);
+        else fprintf(f, "\"speedup\": null, \"efficiency\": null}");
+    }
+    fprintf(f, "\n  ]\n}\n");
+    fclose(f);
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3 || argc > 7) {
+        printf("Usage: %s <input_file> <output_json> [warmup] [repetitions] [thread_counts] [algorithms]\n", argv[0]);
+        printf("  warmup: untimed runs before each measurement (default %d)\n", DEFAULT_WARMUP);
+        printf("  repetitions: timed runs per algorithm and thread count (default %d)\n", DEFAULT_REPETITIONS);
+        printf("  thread_counts: comma list for the parallel algorithms (default 1,2,4,8,16)\n");
+        printf("  algorithms: comma list of sb_seq, sb_par, bb_seq, bb_par (default all four)\n");
+        return 1;
+    }
+    const char *input_file = argv[1];
+    const char *output_file = argv[2];
+    int warmup = (argc > 3) ? atoi(argv[3]) : DEFAULT_WARMUP;
+    int repetitions = (argc > 4) ? atoi(argv[4]) : DEFAULT_REPETITIONS;
+    char thread_list[128] = "1,2,4,8,16", algorithm_list[128] = "sb_seq,sb_par,bb_seq,bb_par";
+    if (argc > 5) snprintf(thread_list, sizeof(thread_list), "%s", argv[5]);
+    if (argc > 6) snprintf(algorithm_list, sizeof(algorithm_list), "%s", argv[6]);
+    if (warmup < 0) warmup = 0;
+    if (repetitions < 1) repetitions = 1;
+
+    int thread_counts[MAX_THREAD_COUNTS], nthread_counts = 0;
+    for (char *tok = strtok(thread_list, ","); tok && nthread_counts < MAX_THREAD_COUNTS; tok = strtok(NULL, ",")) {
+        if (atoi(tok) > 0) thread_counts[nthread_counts++] = atoi(tok);
+    }
+    BenchCase cases[MAX_CASES];
+    int ncases = 0;
+    for (char *tok = strtok(algorithm_list, ","); tok; tok = strtok(NULL, ",")) {
+        int algorithm = jobshop_algorithm_from_name(tok);
+        if (!algorithm || algorithm == JOBSHOP_ALGO_PORTFOLIO) {
+            printf("Error: unknown algorithm %s (sb_seq, sb_par, bb_seq, bb_par)\n", tok);
+            return 1;
+        }
+        int n = is_sequential(algorithm) ? 1 : nthread_counts;
+        for (int t = 0; t < n && ncases < MAX_CASES; t++) {
+            memset(&cases[ncases], 0, sizeof(BenchCase));
+            cases[ncases].algorithm = algorithm;
+            cases[ncases].threads = is_sequential(algorithm) ? 1 : thread_counts[t];
+            ncases++;
+        }
+    }
+    if (ncases == 0) {
+        printf("Error: nothing to benchmark\n");
+        return 1;
+    }
+
+    JobshopSolver *solver = jobshop_solver_create();
+    double *samples = (double*)malloc(sizeof(double) * repetitions);
+    if (!solver || !samples || !jobshop_solver_load(solver, input_file)) {
+        printf("Error loading input file: %s\n", input_file);
+        jobshop_solver_destroy(solver);
+        free(samples);
+        return 1;
+    }
+    const Shop *shop = jobshop_solver_shop(solver);
+    printf("Benchmark %s: %d jobs, %d machines, warmup %d, %d repetitions\n",
+           input_file, shop->njobs, shop->nmachs, warmup, repetitions);
+
+    for (int i = 0; i < ncases; i++) {
+        if (!measure(solver, &cases[i], warmup, repetitions, samples)) {
+            printf("Error: %s with %d thread(s) found no schedule\n", jobshop_algorithm_name(cases[i].algorithm), cases[i].threads);
+            jobshop_solver_destroy(solver);
+            free(samples);
+            return 1;
+        }
+    }
+    // Speedup against the sequential run of the same family (median times)
+    for (int i = 0; i < ncases; i++) {
+        if (is_sequential(cases[i].algorithm)) continue;
+        int baseline = cases[i].algorithm == JOBSHOP_ALGO_SB_PAR ? JOBSHOP_ALGO_SB_SEQ : JOBSHOP_ALGO_BB_SEQ;
+        for (int b = 0; b < ncases; b++) {
+            if (cases[b].algorithm == baseline && cases[i].median_ms > 0.0) {
+                cases[i].speedup = cases[b].median_ms / cases[i].median_ms;
+                cases[i].efficiency = cases[i].speedup / cases[i].threads * 100.0;
+            }
+        }
+    }
+
+    printf("%-32s %-8s %-9s %-11s %-11s %-11s %-11s %-8s %s\n", "Algorithm", "Threads", "Makespan",
+           "Min(ms)", "Median(ms)", "P95(ms)", "Stddev(ms)", "Speedup", "Efficiency");
+    for (int i = 0; i < ncases; i++) {
+        const BenchCase *c = &cases[i];
+        printf("%-32s %-8d %-9d %-11.3f %-11.3f %-11.3f %-11.3f ", jobshop_algorithm_name(c->algorithm), c->threads,
+               c->best_makespan, c->min_ms, c->median_ms, c->p95_ms, c->stddev_ms);
+        if (c->speedup > 0.0) printf("%-8.2f %.1f%%\n", c->speedup, c->efficiency);
+        else printf("%-8s %s\n", "-", "-");
+    }
+    int ok = write_json(output_file, input_file, shop, warmup, repetitions, cases, ncases);
+    if (ok) printf("Benchmark saved to %s\n", output_file);
+    else printf("Error: cannot write %s\n", output_file);
+    for (int i = 0; i < ncases; i++) {
+        if (cases[i].invalid_runs) {
+            printf("Error: %s with %d thread(s) produced %d invalid schedule(s)\n",
+                   jobshop_algorithm_name(cases[i].algorithm), cases[i].threads, cases[i].invalid_runs);
+            ok = 0;
+        }
+    }
+
+    jobshop_solver_destroy(solver);
+    free(samples);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+// jobshop_suite.c
+// Quality-vs-time runner for the classic instances of Data/Classic/bks.csv: every instance
+// present in the instance directory is solved by each algorithm and thread count under one
+// wall-clock budget. Per run it reports the relative gap to the best-known makespan and the
+// time to target (first schedule within target_gap percent of it), so SB and B&B changes
+// can be compared on a gap/time frontier rather than on speed alone.
+
+#include "../../Library/jobshop_solver.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#define DEFAULT_BUDGET_SECONDS 10.0
+#define DEFAULT_TARGET_GAP 5.0     // Percent above the best-known makespan
+#define MAX_THREAD_COUNTS 16
+#define MAX_ALGORITHMS 8
+
+typedef struct {
+    char name[64];
+    int jobs;
+    int machines;
+    int bks;
+    int optimal;
+} ClassicInstance;
+
+// Aggregate of one (algorithm, threads) pair over all instances
+typedef struct {
+    int algorithm;
+    int threads;
+    int instances;
+    int reached;                   // Runs that hit the target
+    int matched;                   // Runs that reached the best-known makespan
+    double gap_sum;
+    double ttt_sum;                // Over the runs that reached the target
+} SuiteSummary;
+
+static int is_sequential(int algorithm) {
+    return algorithm == JOBSHOP_ALGO_SB_SEQ || algorithm == JOBSHOP_ALGO_BB_SEQ;
+}
+
+static ClassicInstance *load_bks(const char *filename, int *count) {
+    FILE *f = fopen(filename, "r");
+    if (!f) return NULL;
+    int cap = 64, n = 0;
+    ClassicInstance *list = (ClassicInstance*)malloc(sizeof(ClassicInstance) * cap);
+    char line[256];
+    while (list && fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || strncmp(line, "name,", 5) == 0) continue;
+        ClassicInstance inst;
+        if (sscanf(line, "%63[^,],%d,%d,%d,%d", inst.name, &inst.jobs, &inst.machines, &inst.bks, &inst.optimal) != 5) continue;
+        if (n == cap) {
+            ClassicInstance *grown = (ClassicInstance*)realloc(list, sizeof(ClassicInstance) * cap * 2);
+            if (!grown) { free(list); list = NULL; break; }
+            list = grown;
+            cap *= 2;
+        }
+        list[n++] = inst;
+    }
+    fclose(f);
+    *count = n;
+    return list;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 4 || argc > 8) {
+        printf("Usage: %s <bks_file> <instance_dir> <output_json> [budget_seconds] [thread_counts] [algorithms] [target_gap_percent]\n", argv[0]);
+        printf("  budget_seconds: wall-clock limit per run (default %.0f)\n", DEFAULT_BUDGET_SECONDS);
+        printf("  thread_counts: comma list for the parallel algorithms (default 1,2,4)\n");
+        printf("  algorithms: comma list of sb_seq, sb_par, bb_seq, bb_par, portfolio (default sb_seq,sb_par,bb_seq,bb_par)\n");
+        printf("  target_gap_percent: time to target counts the first schedule within this gap (default %.0f)\n", DEFAULT_TARGET_GAP);
+        printf("Example: %s ..\\..\\Data\\Classic\\bks.csv ..\\..\\Data\\Classic suite.json 10 1,4\n", argv[0]);
+        return 1;
+    }
+    const char *bks_file = argv[1];
+    const char *instance_dir = argv[2];
+    const char *output_file = argv[3];
+    double budget = (argc > 4) ? atof(argv[4]) : DEFAULT_BUDGET_SECONDS;
+    char thread_list[128] = "1,2,4", algorithm_list[128] = "sb_seq,sb_par,bb_seq,bb_par";
+    if (argc > 5) snprintf(thread_list, sizeof(thread_list), "%s", argv[5]);
+    if (argc > 6) snprintf(algorithm_list, sizeof(algorithm_list), "%s", argv[6]);
+    double target_gap = (argc > 7) ? atof(argv[7]) : DEFAULT_TARGET_GAP;
+    if (budget <= 0.0) budget = DEFAULT_BUDGET_SECONDS;
+
+    int thread_counts[MAX_THREAD_COUNTS], nthread_counts = 0;
+    for (char *tok = strtok(thread_list, ","); tok && nthread_counts < MAX_THREAD_COUNTS; tok = strtok(NULL, ",")) {
+        if (atoi(tok) > 0) thread_counts[nthread_counts++] = atoi(tok);
+    }
+    int algorithms[MAX_ALGORITHMS], nalgorithms = 0;
+    for (char *tok = strtok(algorithm_list, ","); tok && nalgorithms < MAX_ALGORITHMS; tok = strtok(NULL, ",")) {
+        algorithms[nalgorithms] = jobshop_algorithm_from_name(tok);
+        if (!algorithms[nalgorithms]) {
+            printf("Error: unknown algorithm %s\n", tok);
+            return 1;
+        }
+        nalgorithms++;
+    }
+    SuiteSummary summaries[MAX_ALGORITHMS * MAX_THREAD_COUNTS];
+    int nsummaries = 0;
+    for (int a = 0; a < nalgorithms; a++) {
+        int n = is_sequential(algorithms[a]) ? 1 : nthread_counts;
+        for (int t = 0; t < n; t++) {
+            memset(&summaries[nsummaries], 0, sizeof(SuiteSummary));
+            summaries[nsummaries].algorithm = algorithms[a];
+            summaries[nsummaries].threads = is_sequential(algorithms[a]) ? 1 : thread_counts[t];
+            nsummaries++;
+        }
+    }
+
+    int ninstances = 0;
+    ClassicInstance *instances = load_bks(bks_file, &ninstances);
+    if (!instances || ninstances == 0) {
+        printf("Error: no instances read from %s\n", bks_file);
+        free(instances);
+        return 1;
+    }
+    FILE *out = fopen(output_file, "w");
+    JobshopSolver *solver = jobshop_solver_create();
+    if (!out || !solver) {
+        printf("Error: cannot write %s\n", output_file);
+        if (out) fclose(out);
+        jobshop_solver_destroy(solver);
+        free(instances);
+        return 1;
+    }
+    fprintf(out, "{\n  \"bks_file\": \"%s\",\n  \"budget_seconds\": %.3f,\n  \"target_gap_percent\": %.3f,\n  \"runs\": [",
+            bks_file, budget, target_gap);
+
+    printf("%-8s %-30s %-8s %-9s %-6s %-9s %-10s %s\n", "Instance", "Algorithm", "Threads", "Makespan", "BKS", "Gap(%)", "Time(s)", "TTT(s)");
+    int present = 0, rows = 0;
+    for (int i = 0; i < ninstances; i++) {
+        const ClassicInstance *inst = &instances[i];
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%s.jss", instance_dir, inst->name);
+        FILE *probe = fopen(path, "r");
+        if (!probe) continue; // Not fetched; see Scripts/fetch_classic_instances.ps1
+        fclose(probe);
+        if (inst->jobs > JMAX || inst->machines > MMAX || !jobshop_solver_load(solver, path)) {
+            printf("%-8s skipped (cannot load or larger than JMAX x MMAX)\n", inst->name);
+            continue;
+        }
+        present++;
+        int target = (int)(inst->bks * (1.0 + target_gap / 100.0));
+        for (int s = 0; s < nsummaries; s++) {
+            SuiteSummary *sum = &summaries[s];
+            JobshopOptions opt;
+            JobshopResult result;
+            jobshop_options_init(&opt);
+            opt.algorithm = sum->algorithm;
+            opt.threads = sum->threads;
+            opt.budget_seconds = budget;
+            opt.node_limit = LONG_MAX; // The budget is the limit
+            opt.target_makespan = target;
+            int solved = jobshop_solver_solve(solver, &opt, &result);
+            double gap = solved ? 100.0 * (result.makespan - inst->bks) / inst->bks : -1.0;
+
+            sum->instances++;
+            if (solved) sum->gap_sum += gap;
+            if (solved && result.makespan <= inst->bks) sum->matched++;
+            if (result.time_to_target >= 0.0) {
+                sum->reached++;
+                sum->ttt_sum += result.time_to_target;
+            }
+            printf("%-8s %-30s %-8d %-9d %-6d %-9.2f %-10.3f ", inst->name, jobshop_algorithm_name(sum->algorithm),
+                   sum->threads, solved ? result.makespan : -1, inst->bks, gap, result.seconds);
+            if (result.time_to_target >= 0.0) printf("%.3f\n", result.time_to_target);
+            else printf("-\n");
+
+            fprintf(out, "%s\n    {\"instance\": \"%s\", \"jobs\": %d, \"machines\": %d, \"bks\": %d, \"bks_optimal\": %d, "
+                    "\"algorithm\": \"%s\", \"threads\": %d, \"makespan\": %d, \"gap_percent\": %.4f, \"lower_bound\": %d, "
+                    "\"proven_optimal\": %d, \"seconds\": %.6f, \"target\": %d, ",
+                    rows ? "," : "", inst->name, inst->jobs, inst->machines, inst->bks, inst->optimal,
+                    jobshop_algorithm_name(sum->algorithm), sum->threads, solved ? result.makespan : -1, gap,
+                    result.lower_bound, result.optimal, result.seconds, target);
+            if (result.time_to_target >= 0.0) fprintf(out, "\"time_to_target\": %.6f}", result.time_to_target);
+            else fprintf(out, "\"time_to_target\": null}");
+            rows++;
+        }
+        fflush(out);
+    }
+
+    fprintf(out, "\n  ],\n  \"summary\": [");
+    printf("\n%-30s %-8s %-10s %-12s %-12s %s\n", "Algorithm", "Threads", "Instances", "MeanGap(%)", "AtBKS", "Reached (mean TTT)");
+    for (int s = 0; s < nsummaries; s++) {
+        const SuiteSummary *sum = &summaries[s];
+        double mean_gap = sum->instances ? sum->gap_sum / sum->instances : 0.0;
+        double mean_ttt = sum->reached ? sum->ttt_sum / sum->reached : 0.0;
+        printf("%-30s %-8d %-10d %-12.2f %-12d %d (%.3fs)\n", jobshop_algorithm_name(sum->algorithm), sum->threads,
+               sum->instances, mean_gap, sum->matched, sum->reached, mean_ttt);
+        fprintf(out, "%s\n    {\"algorithm\": \"%s\", \"threads\": %d, \"instances\": %d, \"mean_gap_percent\": %.4f, "
+                "\"at_bks\": %d, \"reached_target\": %d, \"mean_time_to_target\": %.6f}",
+                s ? "," : "", jobshop_algorithm_name(sum->algorithm), sum->threads, sum->instances, mean_gap,
+                sum->matched, sum->reached, mean_ttt);
+    }
+    fprintf(out, "\n  ]\n}\n");
+    fclose(out);
+
+    if (present == 0) {
+        printf("No instance of %s found in %s; run Scripts/fetch_classic_instances.ps1 first\n", bks_file, instance_dir);
+    }
+    printf("Suite results saved to %s (%d instance(s), %d run(s))\n", output_file, present, rows);
+    jobshop_solver_destroy(solver);
+    free(instances);
+    return present ? 0 : 1;
+}
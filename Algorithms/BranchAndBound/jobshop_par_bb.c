@@ -1,295 +1,129 @@
+// jobshop_par_bb.c
+// OpenMP Branch & Bound: every first-level child of the root is searched depth-first by its
+// own thread. The subtrees share their best makespan as a pruning bound; in deterministic
+// mode (BBRun.deterministic) it is only updated between epochs of DETERMINISTIC_EPOCH
+// subtrees and equal makespans go to the first subtree, so the schedule, makespan and node
+// count do not depend on the thread count or timing (unless a budget stops the search).
+// Engine only: the jobshop_par_bb executable is the thin CLI in jobshop_par_bb_cli.c.
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
-#include <time.h>
+#include <stdint.h>
+#include <math.h>
 #include <omp.h>
 #include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_propagate.h"
+#include "../../Common/jobshop_trace.h"
+#include "../../Common/jobshop_timeline.h"
+#include "../../Common/jobshop_parallel.h"
+#include "jobshop_par_bb.h"
 
 #define MAX_STACK_SIZE 1000
-#define MAX_SCHEDULE_ENTRIES (JMAX * OPMAX)
+#define DETERMINISTIC_EPOCH 4 // Subtrees searched between two updates of the bound (run->deterministic)
 
-// Simplified Branch and Bound Node Structure
+// Best complete schedule over all subtrees of one solve
 typedef struct {
-    int job_progress[JMAX];    // Next operation for each job
-    int machine_time[MMAX];    // Current completion time for each machine
-    int lower_bound;           // Lower bound for this node
-    int depth;                 // Number of operations scheduled
-} BBNode;
+    int makespan;
+    int subtree;               // First-level subtree it came from, the tie-break among equal makespans
+    int bound;                 // Pruning bound shared by the subtrees
+    int *stime;                // [job * nops + op]
+} ParBest;
 
-typedef struct {
-    int job;
-    int op;
-    int machine;
-    int start_time;
-    int duration;
-} ScheduleEntry;
+// Search kernels specialized by size, as in jobshop_seq_bb.c (see jobshop_bb_kernel.inc)
+#define BB_CAT_(a, b) a##b
+#define BB_CAT(a, b) BB_CAT_(a, b)
+#define BB_FN(name) BB_CAT(name, BB_SUFFIX)
 
-// Global variables
-Shop global_shop;
-int best_makespan = INT_MAX;
-ScheduleEntry best_schedule[MAX_SCHEDULE_ENTRIES];
-int best_schedule_len = 0;
+#define BB_DIM 8
+#define BB_PROGRESS_T uint8_t
+#define BB_TIME_T uint16_t
+#define BB_SUFFIX _8
+#include "jobshop_par_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-// Initialize a node with empty schedule
-void initialize_node(BBNode* node) {
-    for (int j = 0; j < JMAX; j++) {
-        node->job_progress[j] = 0;
-    }
-    for (int m = 0; m < MMAX; m++) {
-        node->machine_time[m] = 0;
-    }
-    node->lower_bound = 0;
-    node->depth = 0;
-}
+#define BB_DIM 16
+#define BB_PROGRESS_T uint8_t
+#define BB_TIME_T uint16_t
+#define BB_SUFFIX _16
+#include "jobshop_par_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-// Calculate lower bound using critical path analysis
-int calculate_lower_bound(BBNode* node) {
-    int max_bound = 0;
-    // Job-based lower bound
-    for (int j = 0; j < global_shop.njobs; j++) {
-        int remaining_time = 0;
-        for (int op = node->job_progress[j]; op < global_shop.nops; op++) {
-            remaining_time += global_shop.plan[j][op].len;
-        }
-        if (remaining_time > max_bound) max_bound = remaining_time;
-    }
-    // Machine-based lower bound
-    for (int m = 0; m < global_shop.nmachs; m++) {
-        int machine_load = node->machine_time[m];
-        for (int j = 0; j < global_shop.njobs; j++) {
-            for (int op = node->job_progress[j]; op < global_shop.nops; op++) {
-                if (global_shop.plan[j][op].mach == m + 1) {
-                    machine_load += global_shop.plan[j][op].len;
-                }
-            }
-        }
-        if (machine_load > max_bound) max_bound = machine_load;
-    }
-    return max_bound;
-}
+#define BB_DIM 32
+#define BB_PROGRESS_T uint8_t
+#define BB_TIME_T uint32_t
+#define BB_SUFFIX _32
+#include "jobshop_par_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-int is_complete(BBNode* node) {
-    for (int j = 0; j < global_shop.njobs; j++) {
-        if (node->job_progress[j] < global_shop.nops) {
-            return 0;
-        }
-    }
-    return 1;
-}
+#define BB_DIM 64
+#define BB_PROGRESS_T uint8_t
+#define BB_TIME_T uint32_t
+#define BB_SUFFIX _64
+#include "jobshop_par_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-int calculate_makespan(BBNode* node) {
-    int makespan = 0;
-    for (int m = 0; m < global_shop.nmachs; m++) {
-        if (node->machine_time[m] > makespan) {
-            makespan = node->machine_time[m];
-        }
-    }
-    return makespan;
-}
+#define BB_DIM JMAX // JMAX == OPMAX == MMAX
+#define BB_PROGRESS_T int
+#define BB_TIME_T int
+#define BB_SUFFIX _generic
+#include "jobshop_par_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-// Parallel B&B: Each thread explores a different first-level child node
-void expand_and_solve_parallel(BBNode* root, int num_threads) {
-    BBNode children[JMAX];
-    int child_count = 0;
-    int job_indices[JMAX];
-    // Generate all possible first-level children
-    for (int j = 0; j < global_shop.njobs; j++) {
-        int next_op = root->job_progress[j];
-        if (next_op < global_shop.nops) {
-            BBNode child = *root;
-            int machine = global_shop.plan[j][next_op].mach - 1;
-            int duration = global_shop.plan[j][next_op].len;
-            int earliest_start = child.machine_time[machine];
-            if (next_op > 0) {
-                int prev_machine = global_shop.plan[j][next_op-1].mach - 1;
-                if (child.machine_time[prev_machine] > earliest_start) {
-                    earliest_start = child.machine_time[prev_machine];
-                }
-            }
-            child.job_progress[j]++;
-            child.machine_time[machine] = earliest_start + duration;
-            child.depth++;
-            child.lower_bound = calculate_lower_bound(&child);
-            if (child.lower_bound < best_makespan) {
-                children[child_count] = child;
-                job_indices[child_count] = j;
-                child_count++;
-            }
-        }
-    }
-    // printf("[DEBUG] First-level children generated: %d\n", child_count);
-    if (child_count == 0) {
-        // printf("[ERROR] No valid first-level children to explore. Exiting.\n");
-        return;
-    }
-    // Parallel region: each thread explores a subtree
-    #define MAX_NODES_EXPLORED 10000
-    #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
-    for (int i = 0; i < child_count; i++) {
-        BBNode* node_stack = (BBNode*)malloc(MAX_STACK_SIZE * sizeof(BBNode));
-        int* schedule_len_stack = (int*)malloc(MAX_STACK_SIZE * sizeof(int));
-        ScheduleEntry* local_schedule = (ScheduleEntry*)malloc(MAX_SCHEDULE_ENTRIES * sizeof(ScheduleEntry));
-        ScheduleEntry* local_best_schedule = (ScheduleEntry*)malloc(MAX_SCHEDULE_ENTRIES * sizeof(ScheduleEntry));
-        // Add a stack to hold a copy of the schedule for each node
-        ScheduleEntry** schedule_stack = (ScheduleEntry**)malloc(MAX_STACK_SIZE * sizeof(ScheduleEntry*));
-        for (int s = 0; s < MAX_STACK_SIZE; s++) {
-            schedule_stack[s] = (ScheduleEntry*)malloc(MAX_SCHEDULE_ENTRIES * sizeof(ScheduleEntry));
-        }
-        if (!node_stack || !schedule_len_stack || !local_schedule || !local_best_schedule || !schedule_stack) {
-            free(node_stack); free(schedule_len_stack); free(local_schedule); free(local_best_schedule);
-            for (int s = 0; s < MAX_STACK_SIZE; s++) free(schedule_stack[s]);
-            free(schedule_stack);
-            continue;
-        }
-        int stack_top = 0;
-        int local_schedule_len = 0;
-        int local_best_makespan = INT_MAX;
-        int local_best_schedule_len = 0;
-        int nodes_explored = 0;
-        // --- Record the first scheduled operation for this child ---
-        int opidx = root->job_progress[job_indices[i]];
-        local_schedule[local_schedule_len].job = job_indices[i];
-        local_schedule[local_schedule_len].op = opidx;
-        local_schedule[local_schedule_len].machine = global_shop.plan[job_indices[i]][opidx].mach - 1;
-        local_schedule[local_schedule_len].start_time = children[i].machine_time[local_schedule[local_schedule_len].machine] - global_shop.plan[job_indices[i]][opidx].len;
-        local_schedule[local_schedule_len].duration = global_shop.plan[job_indices[i]][opidx].len;
-        local_schedule_len++;
-        memcpy(schedule_stack[stack_top], local_schedule, sizeof(ScheduleEntry) * local_schedule_len);
-        node_stack[stack_top] = children[i];
-        schedule_len_stack[stack_top++] = local_schedule_len;
-        while (stack_top > 0 && nodes_explored < MAX_NODES_EXPLORED) {
-            BBNode current = node_stack[--stack_top];
-            local_schedule_len = schedule_len_stack[stack_top];
-            memcpy(local_schedule, schedule_stack[stack_top], sizeof(ScheduleEntry) * local_schedule_len);
-            nodes_explored++;
-            if (is_complete(&current)) {
-                int makespan = calculate_makespan(&current);
-                if (makespan < local_best_makespan) {
-                    local_best_makespan = makespan;
-                    memcpy(local_best_schedule, local_schedule, sizeof(ScheduleEntry) * local_schedule_len);
-                    local_best_schedule_len = local_schedule_len;
-                }
-                continue;
-            }
-            if (current.lower_bound >= local_best_makespan) {
-                continue;
-            }
-            for (int j = 0; j < global_shop.njobs; j++) {
-                int next_op = current.job_progress[j];
-                if (next_op < global_shop.nops) {
-                    BBNode child = current;
-                    int machine = global_shop.plan[j][next_op].mach - 1;
-                    int duration = global_shop.plan[j][next_op].len;
-                    int earliest_start = child.machine_time[machine];
-                    if (next_op > 0) {
-                        int prev_machine = global_shop.plan[j][next_op-1].mach - 1;
-                        if (child.machine_time[prev_machine] > earliest_start) {
-                            earliest_start = child.machine_time[prev_machine];
-                        }
-                    }
-                    child.job_progress[j]++;
-                    child.machine_time[machine] = earliest_start + duration;
-                    child.depth++;
-                    child.lower_bound = calculate_lower_bound(&child);
-                    if (stack_top < MAX_STACK_SIZE - 1 && child.lower_bound < local_best_makespan) {
-                        node_stack[stack_top] = child;
-                        memcpy(schedule_stack[stack_top], local_schedule, sizeof(ScheduleEntry) * local_schedule_len);
-                        memcpy(&schedule_stack[stack_top][local_schedule_len], &(ScheduleEntry){j, next_op, machine, earliest_start, duration}, sizeof(ScheduleEntry));
-                        schedule_len_stack[stack_top] = local_schedule_len + 1;
-                        stack_top++;
-                    }
-                }
-            }
-        }
-        // Only update global best if a complete schedule was found
-        if (local_best_schedule_len == global_shop.njobs * global_shop.nops) {
-            printf("[DEBUG][OMP][Thread %d] Submitting complete schedule: makespan=%d\n", omp_get_thread_num(), local_best_makespan);
-            #pragma omp critical
-            {
-                if (local_best_makespan < best_makespan) {
-                    best_makespan = local_best_makespan;
-                    memcpy(best_schedule, local_best_schedule, sizeof(ScheduleEntry) * local_best_schedule_len);
-                    best_schedule_len = local_best_schedule_len;
-                }
-            }
-        } else {
-            printf("[DEBUG][OMP][Thread %d] No complete schedule found in this thread. local_best_schedule_len=%d\n", omp_get_thread_num(), local_best_schedule_len);
-        }
-        for (int s = 0; s < MAX_STACK_SIZE; s++) free(schedule_stack[s]);
-        free(schedule_stack);
-        free(node_stack);
-        free(schedule_len_stack);
-        free(local_schedule);
-        free(local_best_schedule);
-    }
+// Work of a search in parallel_team_size units: every subtree explores the node limit, or
+// about all orders of the operations when there are fewer (3x3: 1680), and visits every
+// operation per node
+static double search_work(const Shop *shop, long node_limit) {
+    double ops = (double)shop->njobs * shop->nops;
+    double log_orders = lgamma(ops + 1.0) - shop->njobs * lgamma(shop->nops + 1.0);
+    double nodes = (double)node_limit;
+    if (log_orders + log(ops) < log(nodes)) nodes = ops * exp(log_orders) / shop->njobs;
+    return shop->njobs * nodes * ops;
 }
 
-int main(int argc, char* argv[]) {
-    if (argc != 4) {
-        printf("Usage: %s <input_file> <output_file> <num_threads>\n", argv[0]);
-        return 1;
+// Solve shop with num_threads threads (PARALLEL_AUTO: as many as the estimated work pays
+// for). Fills stime (njobs * nops start times, optional) with the best schedule and returns
+// its makespan, INT_MAX if none was found.
+int branch_and_bound_solve(const Shop *shop, int num_threads, BBRun *run, int *stime) {
+    ParBest best;
+    best.makespan = INT_MAX;
+    best.subtree = INT_MAX;
+    best.bound = INT_MAX;
+    best.stime = (int*)malloc(sizeof(int) * shop->njobs * shop->nops);
+    run->nodes = 0;
+    run->truncated = 0;
+    if (!best.stime) {
+        printf("Out of memory for the Branch & Bound schedule\n");
+        return INT_MAX;
     }
-    const char* input_file = argv[1];
-    const char* output_file = argv[2];
-    int num_threads = atoi(argv[3]);
-    if (num_threads <= 0) num_threads = 1;
-    // Load problem
-    if (!load_problem_seq(input_file, &global_shop)) {
-        printf("Error loading input file: %s\n", input_file);
-        return 1;
+    if (num_threads <= PARALLEL_AUTO) num_threads = parallel_team_size(search_work(shop, run->node_limit), PARALLEL_AUTO);
+    run->threads = num_threads;
+    switch (bb_kernel_dim(shop)) {
+        case 8: expand_and_solve_parallel_8(shop, num_threads, run, &best); break;
+        case 16: expand_and_solve_parallel_16(shop, num_threads, run, &best); break;
+        case 32: expand_and_solve_parallel_32(shop, num_threads, run, &best); break;
+        case 64: expand_and_solve_parallel_64(shop, num_threads, run, &best); break;
+        default: expand_and_solve_parallel_generic(shop, num_threads, run, &best); break;
     }
-    // printf("Loaded problem: %d jobs, %d machines, %d operations per job\n", global_shop.njobs, global_shop.nmachs, global_shop.nops);
-    char *basename = extract_basename(input_file);
-    // printf("Starting OpenMP Parallel Branch & Bound for %s with %d threads...\n", basename ? basename : "unknown", num_threads);
-    clock_t start_time = clock();
-    BBNode root;
-    initialize_node(&root);
-    root.lower_bound = calculate_lower_bound(&root);
-    expand_and_solve_parallel(&root, num_threads);
-    clock_t end_time = clock();
-    double execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
-    // printf("OpenMP Branch & Bound finished for %s.\n", basename ? basename : "unknown");
-    // printf("Best makespan found: %d\n", best_makespan);
-    // printf("Time taken: %.6f seconds\n", execution_time);
-    // Save result
-    FILE* file = fopen(output_file, "w");
-    if (file) {
-        // Output makespan
-        fprintf(file, "%d\n", best_makespan);
-        // Output per-job operation start times (as in Annex II)
-        for (int j = 0; j < global_shop.njobs; j++) {
-            for (int op = 0; op < global_shop.nops; op++) {
-                int found = 0;
-                for (int k = 0; k < best_schedule_len; k++) {
-                    if (best_schedule[k].job == j && best_schedule[k].op == op) {
-                        fprintf(file, "%d ", best_schedule[k].start_time);
-                        found = 1;
-                        break;
-                    }
-                }
-                if (!found) {
-                    // Defensive: try to find the earliest scheduled operation for this job
-                    int min_time = INT_MAX;
-                    for (int k = 0; k < best_schedule_len; k++) {
-                        if (best_schedule[k].job == j && best_schedule[k].start_time < min_time) {
-                            min_time = best_schedule[k].start_time;
-                        }
-                    }
-                    if (min_time != INT_MAX) {
-                        fprintf(file, "%d ", min_time);
-                    } else {
-                        fprintf(file, "-1 "); // Should not happen
-                    }
-                }
-            }
-            fprintf(file, "\n");
-        }
-        fclose(file);
-        printf("Results saved to %s\n", output_file);
-    } else {
-        printf("Error: Could not open output file %s for writing.\n", output_file);
+    if (stime && best.makespan != INT_MAX) {
+        memcpy(stime, best.stime, sizeof(int) * shop->njobs * shop->nops);
     }
-    if (basename) free(basename);
-    return 0;
+    free(best.stime);
+    return best.makespan;
 }
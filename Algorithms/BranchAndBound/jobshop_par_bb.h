@@ -0,0 +1,13 @@
+// jobshop_par_bb.h
+// Entry point of the OpenMP Branch & Bound. Reentrant: the problem, limits, incumbent and
+// result all come in through the arguments, so several searches can run in one process.
+#ifndef JOBSHOP_PAR_BB_H
+#define JOBSHOP_PAR_BB_H
+
+#include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_incumbent.h"
+#include "jobshop_seq_bb.h"
+
+int branch_and_bound_solve(const Shop *shop, int num_threads, BBRun *run, int *stime);
+
+#endif // JOBSHOP_PAR_BB_H
@@ -0,0 +1,90 @@
+// jobshop_par_bb_cli.c
+// Command-line front end of the OpenMP Branch & Bound (libjobshop)
+
+#include "../../Library/jobshop_solver.h"
+#include "../../Library/jobshop_batch.h"
+#include "../../Library/jobshop_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char* argv[]) {
+    if (argc == 4 && strcmp(argv[1], "--batch") == 0) { // Many instances and repetitions in one process
+        return jobshop_batch_run(argv[2], argv[3], JOBSHOP_ALGO_BB_PAR);
+    }
+    char *stats_file = take_option_value(&argc, argv, "--stats"); // Counters of the solve as JSON
+    char *affinity = take_option_value(&argc, argv, "--affinity"); // Pin the threads
+    int replicate = take_option_flag(&argc, argv, "--replicate"); // Instance copy per NUMA node
+    int deterministic = take_option_flag(&argc, argv, "--deterministic"); // Same result for any thread count
+    int use_cache = !take_option_flag(&argc, argv, "--no-cache"); // Always solve, bypassing the solution cache
+    if (argc < 4 || argc > 5 || (argc == 5 && strcmp(argv[4], "--propagate") != 0)) {
+        printf("Usage: %s <input_file> <output_file> <num_threads|auto> [--propagate] [--stats <stats.json>]\n", argv[0]);
+        printf("                [--affinity <compact|scatter|cpu_list>] [--replicate] [--deterministic] [--no-cache]\n");
+        printf("       %s --batch <manifest> <results.csv|results.json>\n", argv[0]);
+        printf("  auto: as many threads as the estimated work pays for (thresholds from jobshop_calibrate)\n");
+        printf("  --propagate: filter every node with edge-finding and not-first/not-last\n");
+        printf("  --stats: write node, pruning and phase-time counters of the solve as JSON\n");
+        printf("  --affinity: compact fills one NUMA node before the next, scatter deals the threads\n");
+        printf("              round-robin over the nodes, a list such as 0,2,4-7 pins thread i to entry i\n");
+        printf("  --replicate: give every NUMA node its own copy of the instance\n");
+        printf("  --deterministic: share the bound between fixed epochs of subtrees only, so the schedule\n");
+        printf("                   and node count are the same for any number of threads\n");
+        printf("  --no-cache: solve even when %s holds the answer\n", jobshop_cache_dir());
+        return 1;
+    }
+    const char* input_file = argv[1];
+    const char* output_file = argv[2];
+    int num_threads = jobshop_threads_from_arg(argv[3]);
+    if (num_threads < 0) num_threads = 1;
+    // Load problem
+    JobshopSolver *solver = jobshop_solver_create();
+    if (!solver || !jobshop_solver_load(solver, input_file)) {
+        printf("Error loading input file: %s\n", input_file);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+    JobshopOptions opt;
+    JobshopResult result;
+    jobshop_options_init(&opt);
+    opt.algorithm = JOBSHOP_ALGO_BB_PAR;
+    opt.threads = num_threads;
+    opt.propagate = (argc == 5);
+    opt.deterministic = deterministic;
+    opt.cache_dir = use_cache ? jobshop_cache_dir() : NULL;
+    opt.cache_max_mb = jobshop_cache_max_mb();
+    opt.placement.replicate = replicate;
+    if (affinity && !parallel_placement_parse(affinity, &opt.placement)) {
+        printf("Invalid --affinity %s: expected compact, scatter, none or a processor list.\n", affinity);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+    if (parallel_placement_active(&opt.placement)) {
+        printf("Thread placement: %s over %d NUMA node(s)%s\n", affinity ? affinity : "none", parallel_numa_nodes(),
+               replicate ? ", instance replicated per node" : "");
+    }
+    int solved = jobshop_solver_solve(solver, &opt, &result);
+    if (solved && result.cached) printf("Solution cache: hit in %s\n", opt.cache_dir);
+    if (result.stats.bb_kernel_dim > 0) {
+        printf("Branch & Bound kernel: up to %d jobs and machines, %d-byte nodes\n",
+               result.stats.bb_kernel_dim, result.stats.bb_node_bytes);
+    }
+    if (solved && !result.cached && opt.threads == JOBSHOP_THREADS_AUTO) {
+        printf("Branch & Bound: %d thread(s) chosen for the estimated work\n", result.bb_threads);
+    }
+    if (stats_file) {
+        if (jobshop_result_save_stats(&result, &opt, input_file, stats_file)) printf("Statistics saved to %s\n", stats_file);
+        else printf("Error: Could not write statistics to %s\n", stats_file);
+    }
+    // Save result (Annex II: makespan, then per-job operation start times)
+    if (solved) printf("Best makespan found: %d\n", result.makespan);
+    bounds_print(&result.bounds, result.makespan);
+    if (!solved) {
+        printf("No complete schedule found.\n");
+    } else if (jobshop_solver_save_start_times(solver, output_file)) {
+        printf("Results saved to %s\n", output_file);
+    } else {
+        printf("Error: Could not open output file %s for writing.\n", output_file);
+    }
+    jobshop_solver_destroy(solver);
+    return 0;
+}
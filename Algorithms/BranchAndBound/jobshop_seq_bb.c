@@ -1,257 +1,224 @@
+// jobshop_seq_bb.c
+// Sequential Branch & Bound (depth-first, placing the next operation of one job in the first
+// idle gap of its machine) and the exact subproblem search used by LNS. Engine only: the
+// jobshop_seq_bb executable is the thin CLI in jobshop_seq_bb_cli.c.
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
-#include <time.h>
+#include <stdint.h>
 #include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_propagate.h"
+#include "../../Common/jobshop_trace.h"
+#include "../../Common/jobshop_timeline.h"
+#include "jobshop_seq_bb.h"
 
 #define MAX_STACK_SIZE 1000
-#define MAX_SCHEDULE_ENTRIES (JMAX * OPMAX)
 
-// Simplified Branch and Bound Node Structure
-typedef struct {
-    int job_progress[JMAX];    // Next operation for each job
-    int machine_time[MMAX];    // Current completion time for each machine
-    int lower_bound;           // Lower bound for this node
-    int depth;                 // Number of operations scheduled
-} BBNode;
+// Search kernels specialized by size (jobshop_bb_kernel.inc): indices and times as narrow
+// as the instance allows, arrays sized to the instance, so a node of a 6x6 instance fits
+// in one cache line instead of taking 1.2 KB. The generic kernel covers everything else.
+#define BB_CAT_(a, b) a##b
+#define BB_CAT(a, b) BB_CAT_(a, b)
+#define BB_FN(name) BB_CAT(name, BB_SUFFIX)
 
-typedef struct {
-    int job;
-    int op;
-    int machine;
-    int start_time;
-    int duration;
-} ScheduleEntry;
+#define BB_DIM 8
+#define BB_PROGRESS_T uint8_t
+#define BB_TIME_T uint16_t
+#define BB_SUFFIX _8
+#include "jobshop_seq_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-// Global variables
-Shop global_shop;
-int best_makespan = INT_MAX;
-typedef struct {
-    BBNode node;
-    ScheduleEntry schedule[MAX_SCHEDULE_ENTRIES];
-    int schedule_len;
-} StackEntry;
+#define BB_DIM 16
+#define BB_PROGRESS_T uint8_t
+#define BB_TIME_T uint16_t
+#define BB_SUFFIX _16
+#include "jobshop_seq_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-StackEntry node_stack[MAX_STACK_SIZE];
-int stack_top = 0;
+#define BB_DIM 32
+#define BB_PROGRESS_T uint8_t
+#define BB_TIME_T uint32_t
+#define BB_SUFFIX _32
+#include "jobshop_seq_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-ScheduleEntry best_schedule[MAX_SCHEDULE_ENTRIES];
-int best_schedule_len = 0;
+#define BB_DIM 64
+#define BB_PROGRESS_T uint8_t
+#define BB_TIME_T uint32_t
+#define BB_SUFFIX _64
+#include "jobshop_seq_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-// Initialize a node with empty schedule
-void initialize_node(BBNode* node) {
-    for (int j = 0; j < JMAX; j++) {
-        node->job_progress[j] = 0;
-    }
-    for (int m = 0; m < MMAX; m++) {
-        node->machine_time[m] = 0;
-    }
-    node->lower_bound = 0;
-    node->depth = 0;
-}
+#define BB_DIM JMAX // JMAX == OPMAX == MMAX
+#define BB_PROGRESS_T int
+#define BB_TIME_T int
+#define BB_SUFFIX _generic
+#include "jobshop_seq_bb_search.inc"
+#undef BB_DIM
+#undef BB_PROGRESS_T
+#undef BB_TIME_T
+#undef BB_SUFFIX
 
-// Calculate lower bound using critical path analysis
-int calculate_lower_bound(BBNode* node) {
-    int max_bound = 0;
-    
-    // Job-based lower bound: remaining processing time for each job
-    for (int j = 0; j < global_shop.njobs; j++) {
-        int remaining_time = 0;
-        for (int op = node->job_progress[j]; op < global_shop.nops; op++) {
-            remaining_time += global_shop.plan[j][op].len;
-        }
-        if (remaining_time > max_bound) max_bound = remaining_time;
-    }
-    
-    // Machine-based lower bound: current machine load + remaining work
-    for (int m = 0; m < global_shop.nmachs; m++) {
-        int machine_load = node->machine_time[m];
-        for (int j = 0; j < global_shop.njobs; j++) {
-            for (int op = node->job_progress[j]; op < global_shop.nops; op++) {
-                if (global_shop.plan[j][op].mach == m + 1) { // Machine numbers are 1-indexed
-                    machine_load += global_shop.plan[j][op].len;
-                }
-            }
-        }
-        if (machine_load > max_bound) max_bound = machine_load;
-    }
-    
-    return max_bound;
+void bb_run_init(BBRun *run) {
+    run->use_propagation = 0;
+    run->node_limit = BB_DEFAULT_NODE_LIMIT;
+    run->incumbent = NULL;
+    run->stats = NULL;
+    run->placement = NULL;
+    run->deterministic = 0;
+    run->stop_at = 0;
+    run->nodes = 0;
+    run->threads = 1;
+    run->truncated = 0;
 }
 
-// Check if all jobs are complete
-int is_complete(BBNode* node) {
-    for (int j = 0; j < global_shop.njobs; j++) {
-        if (node->job_progress[j] < global_shop.nops) {
-            return 0;
-        }
+// Kernel size for an instance: the smallest that holds its jobs, operations and machines,
+// with 16-bit times only while the total work (a bound on every time in the search) fits.
+// 0 selects the generic kernel.
+int bb_kernel_dim(const Shop *shop) {
+    int dim = shop->njobs;
+    if (shop->nops > dim) dim = shop->nops;
+    if (shop->nmachs > dim) dim = shop->nmachs;
+    long work = 0;
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int o = 0; o < shop->nops; o++) work += shop->plan[j][o].len;
     }
-    return 1;
+    if (dim <= 8 && work <= UINT16_MAX) return 8;
+    if (dim <= 16 && work <= UINT16_MAX) return 16;
+    if (work > INT_MAX) return 0;
+    if (dim <= 32) return 32;
+    if (dim <= 64) return 64;
+    return 0;
 }
 
-// Calculate makespan for a complete schedule
-int calculate_makespan(BBNode* node) {
-    int makespan = 0;
-    for (int m = 0; m < global_shop.nmachs; m++) {
-        if (node->machine_time[m] > makespan) {
-            makespan = node->machine_time[m];
-        }
+// Main Branch and Bound algorithm. Fills stime (njobs * nops start times, optional) with the
+// best schedule and returns its makespan, INT_MAX if none was found.
+int solve_branch_and_bound(const Shop *shop, BBRun *run, int *stime) {
+    switch (bb_kernel_dim(shop)) {
+        case 8: return search_8(shop, run, stime);
+        case 16: return search_16(shop, run, stime);
+        case 32: return search_32(shop, run, stime);
+        case 64: return search_64(shop, run, stime);
+        default: return search_generic(shop, run, stime);
     }
-    return makespan;
 }
 
-// Find next available operations and create child nodes
-void expand_node(StackEntry* parent_entry) {
-    for (int j = 0; j < global_shop.njobs; j++) {
-        int next_op = parent_entry->node.job_progress[j];
-        
-        // Check if this job has more operations to schedule
-        if (next_op < global_shop.nops) {
-            // Create child entry
-            StackEntry child_entry = *parent_entry;
-            BBNode* child = &child_entry.node;
-            
-            int machine = global_shop.plan[j][next_op].mach - 1; // Convert to 0-indexed
-            int duration = global_shop.plan[j][next_op].len;
-            
-            // Calculate earliest start time
-            int earliest_start = child->machine_time[machine];
-            
-            // Consider job precedence constraint
-            if (next_op > 0) {
-                int prev_machine = global_shop.plan[j][next_op-1].mach - 1;
-                if (child->machine_time[prev_machine] > earliest_start) {
-                    earliest_start = child->machine_time[prev_machine];
-                }
-            }
-            
-            // Update child node
-            child->job_progress[j]++;
-            child->machine_time[machine] = earliest_start + duration;
-            child->depth++;
-            child->lower_bound = calculate_lower_bound(child);
-            
-            // Add to stack if there's space and it's promising
-            if (stack_top < MAX_STACK_SIZE - 1 && child->lower_bound < best_makespan) {
-                // Record the operation in the child's schedule
-                if (child_entry.schedule_len < MAX_SCHEDULE_ENTRIES) {
-                    child_entry.schedule[child_entry.schedule_len].job = j;
-                    child_entry.schedule[child_entry.schedule_len].op = next_op;
-                    child_entry.schedule[child_entry.schedule_len].machine = machine;
-                    child_entry.schedule[child_entry.schedule_len].start_time = earliest_start;
-                    child_entry.schedule[child_entry.schedule_len].duration = duration;
-                    child_entry.schedule_len++;
-                }
-                node_stack[stack_top++] = child_entry;
+// Subproblem search state, one per call so several windows can be solved concurrently
+typedef struct {
+    BBSubproblem* sub;
+    int pos[SUB_MAX_OPS];          // Next operation of each chain
+    int ready[SUB_MAX_OPS];        // Completion of the chain's last scheduled operation
+    int machine_time[MMAX];
+    int start[SUB_MAX_OPS];
+    long node_limit;
+} SubSearch;
+
+// Head-body-tail bound: every chain must still run its remaining work, every machine its load
+static int subproblem_lower_bound(SubSearch* s, int current_value) {
+    BBSubproblem* sub = s->sub;
+    int bound = current_value;
+    int load[MMAX], min_tail[MMAX], min_release[MMAX], used[SUB_MAX_OPS], nused = 0;
+    for (int c = 0; c < sub->nchains; c++) {
+        if (s->pos[c] >= sub->chain_len[c]) continue;
+        int first = sub->chain_ops[sub->chain_first[c] + s->pos[c]];
+        int head = s->ready[c] > sub->release[first] ? s->ready[c] : sub->release[first];
+        if (head + sub->len[first] + sub->tail[first] > bound) bound = head + sub->len[first] + sub->tail[first];
+        for (int k = s->pos[c]; k < sub->chain_len[c]; k++) {
+            int i = sub->chain_ops[sub->chain_first[c] + k];
+            int m = sub->mach[i];
+            int r = sub->release[i] > head ? sub->release[i] : head;
+            int seen = 0;
+            for (int u = 0; u < nused; u++) if (used[u] == m) { seen = 1; break; }
+            if (!seen) {
+                used[nused++] = m;
+                load[m] = 0;
+                min_tail[m] = INT_MAX;
+                min_release[m] = INT_MAX;
             }
+            load[m] += sub->len[i];
+            if (sub->tail[i] < min_tail[m]) min_tail[m] = sub->tail[i];
+            if (r < min_release[m]) min_release[m] = r;
+            head = r + sub->len[i];
         }
     }
+    for (int u = 0; u < nused; u++) {
+        int m = used[u];
+        int head = s->machine_time[m] > min_release[m] ? s->machine_time[m] : min_release[m];
+        if (head + load[m] + min_tail[m] > bound) bound = head + load[m] + min_tail[m];
+    }
+    return bound;
 }
 
-// Main Branch and Bound algorithm
-int solve_branch_and_bound() {
-    // Initialize root node
-    BBNode root;
-    initialize_node(&root);
-    root.lower_bound = calculate_lower_bound(&root);
-    
-    // Add root to stack
-    StackEntry root_entry;
-    root_entry.node = root;
-    root_entry.schedule_len = 0;
-    node_stack[stack_top++] = root_entry;
-    
-    int nodes_explored = 0;
-    
-    while (stack_top > 0 && nodes_explored < 10000) { // Limit exploration for efficiency
-        StackEntry current_entry = node_stack[--stack_top];
-        BBNode* current = &current_entry.node;
-        nodes_explored++;
-        
-        // Check if complete
-        if (is_complete(current)) {
-            int makespan = calculate_makespan(current);
-            if (makespan < best_makespan) {
-                best_makespan = makespan;
-                memcpy(best_schedule, current_entry.schedule, sizeof(ScheduleEntry) * current_entry.schedule_len);
-                best_schedule_len = current_entry.schedule_len;
-                printf("New best makespan found: %d\n", best_makespan);
-            }
-            continue;
-        }
-        
-        // Prune if lower bound exceeds current best
-        if (current->lower_bound >= best_makespan) {
-            continue;
+static void subproblem_dfs(SubSearch* s, int depth, int current_value) {
+    BBSubproblem* sub = s->sub;
+    if (sub->nodes >= s->node_limit) {
+        sub->truncated = 1;
+        return;
+    }
+    sub->nodes++;
+    if (depth == sub->count) {
+        if (current_value < sub->best_value) {
+            sub->best_value = current_value;
+            memcpy(sub->best_start, s->start, sizeof(int) * sub->count);
         }
-        
-        // Expand node
-        expand_node(&current_entry);
+        return;
+    }
+    if (subproblem_lower_bound(s, current_value) >= sub->best_value) return;
+
+    // Same branching as expand_node: append the next operation of one job to its machine
+    for (int c = 0; c < sub->nchains; c++) {
+        if (s->pos[c] >= sub->chain_len[c]) continue;
+        int i = sub->chain_ops[sub->chain_first[c] + s->pos[c]];
+        int m = sub->mach[i];
+        int start = s->machine_time[m];
+        if (s->ready[c] > start) start = s->ready[c];
+        if (sub->release[i] > start) start = sub->release[i];
+        int end = start + sub->len[i];
+        if (end > sub->deadline[i]) continue; // Would push a fixed operation
+
+        int saved_ready = s->ready[c], saved_machine = s->machine_time[m];
+        s->pos[c]++;
+        s->ready[c] = end;
+        s->machine_time[m] = end;
+        s->start[i] = start;
+        int value = end + sub->tail[i] > current_value ? end + sub->tail[i] : current_value;
+        subproblem_dfs(s, depth + 1, value);
+        s->pos[c]--;
+        s->ready[c] = saved_ready;
+        s->machine_time[m] = saved_machine;
     }
-    
-    printf("Nodes explored: %d\n", nodes_explored);
-    return best_makespan;
 }
 
-int main(int argc, char* argv[]) {
-    if (argc != 3) {
-        printf("Usage: %s <input_file> <output_file>\n", argv[0]);
-        return 1;
+// Re-solve a freed part of a schedule. Looks for a value strictly below incumbent_value;
+// returns 1 and fills best_start when one was found. Reentrant: all state lives in sub.
+int bb_solve_subproblem(BBSubproblem *sub, int incumbent_value, long node_limit) {
+    SubSearch search;
+    search.sub = sub;
+    search.node_limit = node_limit;
+    for (int c = 0; c < sub->nchains; c++) {
+        search.pos[c] = 0;
+        search.ready[c] = 0;
     }
-    
-    const char* input_file = argv[1];
-    const char* output_file = argv[2];
-    
-    // Load problem
-    if (!load_problem_seq(input_file, &global_shop)) {
-        printf("Error loading input file: %s\n", input_file);
-        return 1;
+    for (int i = 0; i < sub->count; i++) {
+        search.machine_time[sub->mach[i]] = sub->mach_release[sub->mach[i]];
     }
-    
-    printf("Loaded problem: %d jobs, %d machines, %d operations per job\n", 
-           global_shop.njobs, global_shop.nmachs, global_shop.nops);
-    
-    char *basename = extract_basename(input_file);
-    printf("Starting Sequential Branch & Bound for %s...\n", basename ? basename : "unknown");
-    
-    // Measure execution time
-    clock_t start_time = clock();
-    
-    int makespan = solve_branch_and_bound();
-    
-    clock_t end_time = clock();
-    double execution_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
-    
-    printf("Sequential Branch & Bound finished for %s.\n", basename ? basename : "unknown");
-    printf("Best makespan found: %d\n", makespan);
-    printf("Time taken: %.6f seconds\n", execution_time);
-    
-    // Save result
-    FILE* file = fopen(output_file, "w");
-    if (file) {
-        // Output makespan
-        fprintf(file, "%d\n", best_makespan);
-        // Output per-job operation start times (as in Annex II)
-        for (int j = 0; j < global_shop.njobs; j++) {
-            for (int op = 0; op < global_shop.nops; op++) {
-                // Find the entry for this job/op
-                int found = 0;
-                for (int k = 0; k < best_schedule_len; k++) {
-                    if (best_schedule[k].job == j && best_schedule[k].op == op) {
-                        fprintf(file, "%d ", best_schedule[k].start_time);
-                        found = 1;
-                        break;
-                    }
-                }
-                if (!found) fprintf(file, "-1 "); // Not scheduled (should not happen)
-            }
-            fprintf(file, "\n");
-        }
-        fclose(file);
-        printf("Results saved to %s\n", output_file);
-    }
-    
-    if (basename) free(basename);
-    return 0;
+    sub->best_value = incumbent_value;
+    sub->nodes = 0;
+    sub->truncated = 0;
+    subproblem_dfs(&search, 0, 0);
+    return sub->best_value < incumbent_value;
 }
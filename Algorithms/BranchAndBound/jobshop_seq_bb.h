@@ -0,0 +1,58 @@
+// jobshop_seq_bb.h
+// Sequential Branch & Bound entry points. Reentrant: every call keeps its search state in
+// its own buffers, so several searches can run concurrently on different problems.
+#ifndef JOBSHOP_SEQ_BB_H
+#define JOBSHOP_SEQ_BB_H
+
+#include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_incumbent.h"
+#include "../../Common/jobshop_stats.h"
+#include "../../Common/jobshop_parallel.h"
+
+#define BB_DEFAULT_NODE_LIMIT 10000
+
+// Settings and statistics of one Branch & Bound run (sequential and parallel search)
+typedef struct {
+    int use_propagation;           // Filter nodes with jobshop_propagate
+    long node_limit;               // Nodes explored (per first-level subtree in the parallel search)
+    Incumbent *incumbent;          // Optional: shared bound, budget and publication of schedules
+    SolverStats *stats;            // Optional: search counters are added here when the run ends
+    const ParallelPlacement *placement; // Optional: thread pinning and instance replicas (parallel search)
+    int deterministic;             // Parallel search: same schedule and node count for any team
+    int stop_at;                   // Stop once a schedule this good is found (a lower bound), 0 = never
+    long nodes;                    // Out: nodes explored
+    int threads;                   // Out: team the search ran with (after auto sizing)
+    int truncated;                 // Out: a limit cut the search, so no optimality proof
+} BBRun;
+
+#define SUB_MAX_OPS 64 // Largest subproblem handed to the exact search
+
+// A piece of a complete schedule that is re-solved while everything else stays fixed.
+// The fixed part only shows up as release times, deadlines and machine release times.
+typedef struct {
+    int count;                     // Number of freed operations
+    int job[SUB_MAX_OPS];
+    int op[SUB_MAX_OPS];
+    int mach[SUB_MAX_OPS];
+    int len[SUB_MAX_OPS];
+    int release[SUB_MAX_OPS];      // Earliest start (fixed job predecessor, window start)
+    int deadline[SUB_MAX_OPS];     // Latest completion (fixed successors, window end)
+    int tail[SUB_MAX_OPS];         // Work left in the job after the operation
+    int mach_release[MMAX];        // Each machine is free from this time on
+    int nchains;                   // Freed operations grouped per job, in job order
+    int chain_first[SUB_MAX_OPS];
+    int chain_len[SUB_MAX_OPS];
+    int chain_ops[SUB_MAX_OPS];
+    // Results
+    int best_value;                // max(completion + tail) over the freed operations
+    int best_start[SUB_MAX_OPS];
+    long nodes;
+    int truncated;                 // Node limit reached, best_value is not proven
+} BBSubproblem;
+
+void bb_run_init(BBRun *run);
+int bb_kernel_dim(const Shop *shop);
+int solve_branch_and_bound(const Shop *shop, BBRun *run, int *stime);
+int bb_solve_subproblem(BBSubproblem *sub, int incumbent_value, long node_limit);
+
+#endif // JOBSHOP_SEQ_BB_H
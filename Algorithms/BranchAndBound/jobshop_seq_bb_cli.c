@@ -0,0 +1,77 @@
+// jobshop_seq_bb_cli.c
+// Command-line front end of the sequential Branch & Bound (libjobshop)
+
+#include "../../Library/jobshop_solver.h"
+#include "../../Library/jobshop_batch.h"
+#include "../../Library/jobshop_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char* argv[]) {
+    if (argc == 4 && strcmp(argv[1], "--batch") == 0) { // Many instances and repetitions in one process
+        return jobshop_batch_run(argv[2], argv[3], JOBSHOP_ALGO_BB_SEQ);
+    }
+    char *stats_file = take_option_value(&argc, argv, "--stats"); // Counters of the solve as JSON
+    int use_cache = !take_option_flag(&argc, argv, "--no-cache"); // Always solve, bypassing the solution cache
+    if (argc < 3 || argc > 4 || (argc == 4 && strcmp(argv[3], "--propagate") != 0)) {
+        printf("Usage: %s <input_file> <output_file> [--propagate] [--stats <stats.json>] [--no-cache]\n", argv[0]);
+        printf("       %s --batch <manifest> <results.csv|results.json>\n", argv[0]);
+        printf("  --propagate: filter every node with edge-finding and not-first/not-last\n");
+        printf("  --stats: write node, pruning and phase-time counters of the solve as JSON\n");
+        printf("  --no-cache: solve even when %s holds the answer\n", jobshop_cache_dir());
+        return 1;
+    }
+    
+    const char* input_file = argv[1];
+    const char* output_file = argv[2];
+    
+    // Load problem
+    JobshopSolver *solver = jobshop_solver_create();
+    if (!solver || !jobshop_solver_load(solver, input_file)) {
+        printf("Error loading input file: %s\n", input_file);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+    const Shop *shop = jobshop_solver_shop(solver);
+    
+    printf("Loaded problem: %d jobs, %d machines, %d operations per job\n", 
+           shop->njobs, shop->nmachs, shop->nops);
+    
+    char *basename = extract_basename(input_file);
+    printf("Starting Sequential Branch & Bound for %s...\n", basename ? basename : "unknown");
+    
+    JobshopOptions opt;
+    JobshopResult result;
+    jobshop_options_init(&opt);
+    opt.algorithm = JOBSHOP_ALGO_BB_SEQ;
+    opt.propagate = (argc == 4);
+    opt.cache_dir = use_cache ? jobshop_cache_dir() : NULL;
+    opt.cache_max_mb = jobshop_cache_max_mb();
+    int solved = jobshop_solver_solve(solver, &opt, &result);
+    if (solved && result.cached) printf("Solution cache: hit in %s\n", opt.cache_dir);
+    if (result.stats.bb_kernel_dim > 0) {
+        printf("Branch & Bound kernel: up to %d jobs and machines, %d-byte nodes\n",
+               result.stats.bb_kernel_dim, result.stats.bb_node_bytes);
+    }
+    if (stats_file) {
+        if (jobshop_result_save_stats(&result, &opt, input_file, stats_file)) printf("Statistics saved to %s\n", stats_file);
+        else printf("Error: Could not write statistics to %s\n", stats_file);
+    }
+    
+    printf("Sequential Branch & Bound finished for %s.\n", basename ? basename : "unknown");
+    printf("Best makespan found: %d\n", result.makespan);
+    bounds_print(&result.bounds, result.makespan);
+    printf("Time taken: %.6f seconds\n", result.seconds);
+    
+    // Save result (Annex II: makespan, then per-job operation start times)
+    if (solved && jobshop_solver_save_start_times(solver, output_file)) {
+        printf("Results saved to %s\n", output_file);
+    } else if (solved) {
+        printf("Error: Could not open output file %s for writing.\n", output_file);
+    }
+    
+    if (basename) free(basename);
+    jobshop_solver_destroy(solver);
+    return 0;
+}
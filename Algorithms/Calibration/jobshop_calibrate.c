@@ -0,0 +1,50 @@
+// jobshop_calibrate.c
+// One-time calibration of the automatic thread counts (num_threads = auto): measures the
+// fork/join cost of an OpenMP region with all of the host's processors and the time of one
+// work unit, and writes the resulting serial cutoff to the thresholds file that the
+// parallel engines read on first use (jobshop_parallel.cfg at the repository root, or
+// $JOBSHOP_PARALLEL).
+
+#include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char *argv[]) {
+    if (argc > 2 || (argc == 2 && argv[1][0] == '-')) {
+        printf("Usage: %s [thresholds_file]\n", argv[0]);
+        printf("  thresholds_file: default %s, or the JOBSHOP_PARALLEL environment variable\n", parallel_config_path());
+        return 1;
+    }
+    const char *filename = argc == 2 ? argv[1] : parallel_config_path();
+
+    ParallelThresholds t;
+    printf("Calibrating OpenMP thresholds...\n");
+    if (!parallel_calibrate(&t)) {
+        printf("Error: out of memory\n");
+        return 1;
+    }
+    printf("  processors:        %d\n", t.max_threads);
+    printf("  fork/join:         %.3f us per region\n", t.fork_join_seconds * 1e6);
+    printf("  work unit:         %.3f ns\n", t.unit_seconds * 1e9);
+    printf("  serial cutoff:     %.0f units\n", t.serial_cutoff);
+    printf("  units per thread:  %.0f\n", t.units_per_thread);
+
+    // What the first SB iteration of a few instance sizes would get
+    static const int sizes[][2] = { {3, 3}, {6, 6}, {20, 15}, {50, 20}, {100, 100} };
+    printf("First Shifting Bottleneck iteration (machines x (operations + jobs^2) units):\n");
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        int jobs = sizes[i][0], machs = sizes[i][1];
+        double work = (double)machs * ((double)jobs * machs + (double)jobs * jobs);
+        int team = parallel_team_size_for(&t, work, PARALLEL_AUTO);
+        if (team == 1) printf("  %3dx%-3d %10.0f units -> serial\n", jobs, machs, work);
+        else printf("  %3dx%-3d %10.0f units -> %d thread(s)\n", jobs, machs, work, team);
+    }
+
+    if (!parallel_save_thresholds(filename, &t)) {
+        printf("Error: cannot write %s\n", filename);
+        return 1;
+    }
+    printf("Thresholds saved to %s\n", filename);
+    return 0;
+}
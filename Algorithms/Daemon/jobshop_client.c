@@ -0,0 +1,166 @@
+// jobshop_client.c
+// Command-line client for jobshop_daemon: submits an instance and writes the returned schedule
+// in the Annex II format, or queries the daemon's statistics / shuts it down.
+
+#include "jobshop_socket.h"
+#include "../../Common/jobshop_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PAYLOAD_BYTES (1 << 20)
+#define MAX_REPLY_BYTES (JMAX * OPMAX * 12 + 4096)
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s <socket_path> solve <instance_file> <algorithm> <threads> <budget_seconds> [output_file] [--binary] [--propagate]\n", prog);
+    printf("       %s <socket_path> stats\n", prog);
+    printf("       %s <socket_path> shutdown\n", prog);
+    printf("  algorithm: sb_seq, sb_par, bb_seq, bb_par or portfolio\n");
+    printf("  --binary: send the parsed instance as little-endian int32 instead of .jss text\n");
+}
+
+static void write_le32(unsigned char *p, int v) {
+    unsigned int u = (unsigned int)v;
+    p[0] = (unsigned char)(u & 0xFF);
+    p[1] = (unsigned char)((u >> 8) & 0xFF);
+    p[2] = (unsigned char)((u >> 16) & 0xFF);
+    p[3] = (unsigned char)((u >> 24) & 0xFF);
+}
+
+static long read_text_payload(const char *filename, char *buffer) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) return -1;
+    long n = (long)fread(buffer, 1, MAX_PAYLOAD_BYTES, f);
+    int too_big = !feof(f) && fgetc(f) != EOF;
+    fclose(f);
+    return too_big ? -1 : n;
+}
+
+static long build_binary_payload(const char *filename, char *buffer) {
+    Shop *shop = (Shop*)malloc(sizeof(Shop));
+    if (!shop) return -1;
+    if (!load_problem_seq(filename, shop)) {
+        free(shop);
+        return -1;
+    }
+    unsigned char *p = (unsigned char*)buffer;
+    write_le32(p, shop->njobs);
+    write_le32(p + 4, shop->nmachs);
+    write_le32(p + 8, shop->nops);
+    p += 12;
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int o = 0; o < shop->nops; o++, p += 8) {
+            write_le32(p, shop->plan[j][o].mach);
+            write_le32(p + 4, shop->plan[j][o].len);
+        }
+    }
+    long n = (long)(p - (unsigned char*)buffer);
+    free(shop);
+    return n;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char *socket_path = argv[1];
+    const char *command = argv[2];
+    char header[256];
+    char *payload = NULL;
+    long payload_bytes = 0;
+    const char *output_file = NULL;
+
+    if (strcmp(command, "solve") == 0) {
+        if (argc < 7) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        int binary = 0, propagate = 0;
+        for (int i = 7; i < argc; i++) {
+            if (strcmp(argv[i], "--binary") == 0) binary = 1;
+            else if (strcmp(argv[i], "--propagate") == 0) propagate = 1;
+            else output_file = argv[i];
+        }
+        payload = (char*)malloc(MAX_PAYLOAD_BYTES);
+        if (!payload) {
+            printf("Error: out of memory\n");
+            return 1;
+        }
+        payload_bytes = binary ? build_binary_payload(argv[3], payload) : read_text_payload(argv[3], payload);
+        if (payload_bytes <= 0) {
+            printf("Error: cannot read instance %s\n", argv[3]);
+            free(payload);
+            return 1;
+        }
+        snprintf(header, sizeof(header), "SOLVE %s %s %d %s %ld%s\n", binary ? "bin" : "text",
+                 argv[4], atoi(argv[5]), argv[6], payload_bytes, propagate ? " propagate" : "");
+    } else if (strcmp(command, "stats") == 0) {
+        snprintf(header, sizeof(header), "STATS\n");
+    } else if (strcmp(command, "shutdown") == 0) {
+        snprintf(header, sizeof(header), "SHUTDOWN\n");
+    } else {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (!socket_startup()) {
+        printf("Error: socket layer unavailable\n");
+        free(payload);
+        return 1;
+    }
+    JobshopSocket s = socket_connect_unix(socket_path);
+    if (s == JOBSHOP_INVALID_SOCKET) {
+        printf("Error: cannot connect to %s\n", socket_path);
+        free(payload);
+        socket_cleanup();
+        return 1;
+    }
+    char *reply = (char*)malloc(MAX_REPLY_BYTES);
+    int ok = reply && socket_send_all(s, header, strlen(header)) &&
+             (payload_bytes == 0 || socket_send_all(s, payload, (size_t)payload_bytes));
+    long reply_bytes = ok ? socket_recv_to_end(s, reply, MAX_REPLY_BYTES - 1) : -1;
+    socket_close(s);
+    socket_cleanup();
+    free(payload);
+    if (reply_bytes <= 0) {
+        printf("Error: no reply from daemon\n");
+        free(reply);
+        return 1;
+    }
+    reply[reply_bytes] = '\0';
+
+    // First line is the status; for a solve the Annex II schedule follows it
+    char *body = strchr(reply, '\n');
+    if (body) *body++ = '\0';
+    if (strncmp(reply, "OK", 2) != 0) {
+        printf("%s\n", reply);
+        free(reply);
+        return 1;
+    }
+    if (strcmp(command, "solve") == 0) {
+        int makespan, lower_bound, optimal;
+        double seconds;
+        if (sscanf(reply, "OK %d %d %d %lf", &makespan, &lower_bound, &optimal, &seconds) == 4) {
+            printf("Makespan: %d (lower bound %d%s), solved in %.6f seconds\n",
+                   makespan, lower_bound, optimal ? ", optimal" : "", seconds);
+        }
+        if (output_file) {
+            FILE *f = fopen(output_file, "w");
+            if (!f) {
+                printf("Error: cannot write %s\n", output_file);
+                free(reply);
+                return 1;
+            }
+            fputs(body ? body : "", f);
+            fclose(f);
+            printf("Schedule saved to %s\n", output_file);
+        } else {
+            fputs(body ? body : "", stdout);
+        }
+    } else {
+        fputs(body ? body : "OK\n", stdout);
+    }
+    free(reply);
+    return 0;
+}
@@ -0,0 +1,355 @@
+// jobshop_daemon.c
+// Resident scheduling service on a Unix-domain socket. A fixed OpenMP team of workers stays
+// alive for the whole run; each worker owns a preallocated arena (a libjobshop handle plus
+// request and reply buffers) and blocks in accept() on the shared listening socket, so a
+// request costs no process start, no allocation and no instance file on disk.
+//
+// Protocol, one request per connection (see jobshop_client.c):
+//   SOLVE <text|bin> <algorithm> <threads> <budget_seconds> <payload_bytes> [propagate]\n<payload>
+//       text: the instance in .jss form; bin: little-endian int32 njobs, nmachs, nops, then
+//       njobs * nops (machine, duration) pairs
+//       -> OK <makespan> <lower_bound> <optimal> <seconds>\n followed by the Annex II schedule
+//   STATS\n     -> OK\n followed by one JSON object (counters, throughput, latency histogram)
+//   SHUTDOWN\n  -> OK\n, then the daemon drains its workers and exits
+// Errors are a single line: BUSY <reason> (admission control, retry later) or ERROR <reason>.
+
+#include "jobshop_socket.h"
+#include "../../Library/jobshop_solver.h"
+#include "../../Library/jobshop_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <omp.h>
+
+#define DEFAULT_WORKERS 4
+#define DEFAULT_MAX_BUDGET_SECONDS 60.0
+#define MAX_PAYLOAD_BYTES (1 << 20)            // Largest instance a request may carry
+#define MAX_REPLY_BYTES (JMAX * OPMAX * 12 + 256)
+#define MAX_LINE 256
+#define HIST_BUCKETS 24                        // Bucket b holds latencies in [2^b, 2^(b+1)) microseconds
+#define NUM_ALGORITHMS 6                       // Indexed by JOBSHOP_ALGO_*
+
+// Everything one worker needs for a request, allocated once at startup
+typedef struct {
+    JobshopSolver *solver;
+    Shop *shop;
+    char *payload;
+    char *reply;
+} WorkerArena;
+
+typedef struct {
+    long requests;
+    long solved;
+    long rejected;                 // Refused by admission control
+    long failed;                   // Malformed requests and solves without a schedule
+    long cache_hits;               // Solves answered from the solution cache
+    long per_algorithm[NUM_ALGORITHMS];
+    long histogram[HIST_BUCKETS];
+    double latency_sum_ms;
+    double latency_max_ms;
+    int in_flight;
+    int threads_in_use;
+} DaemonStats;
+
+static DaemonStats stats;
+static omp_lock_t stats_lock;
+static volatile int stop_requested = 0;
+static double daemon_start;
+static int max_threads;
+static double max_budget;
+static const char *cache_dir;      // NULL with --no-cache
+
+static int arena_create(WorkerArena *arena) {
+    arena->solver = jobshop_solver_create();
+    arena->shop = (Shop*)malloc(sizeof(Shop));
+    arena->payload = (char*)malloc(MAX_PAYLOAD_BYTES + 1);
+    arena->reply = (char*)malloc(MAX_REPLY_BYTES);
+    return arena->solver && arena->shop && arena->payload && arena->reply;
+}
+
+static void arena_free(WorkerArena *arena) {
+    jobshop_solver_destroy(arena->solver);
+    free(arena->shop);
+    free(arena->payload);
+    free(arena->reply);
+}
+
+static int latency_bucket(double ms) {
+    double us = ms * 1000.0;
+    int b = 0;
+    while (b < HIST_BUCKETS - 1 && us >= (double)(2L << b)) b++;
+    return b;
+}
+
+static void record_request(double latency_ms, int algorithm, int outcome) {
+    omp_set_lock(&stats_lock);
+    stats.requests++;
+    if (outcome == 1) stats.solved++;
+    else if (outcome == 2) stats.rejected++;
+    else if (outcome == 0) stats.failed++;
+    if (algorithm > 0 && algorithm < NUM_ALGORITHMS) stats.per_algorithm[algorithm]++;
+    stats.histogram[latency_bucket(latency_ms)]++;
+    stats.latency_sum_ms += latency_ms;
+    if (latency_ms > stats.latency_max_ms) stats.latency_max_ms = latency_ms;
+    omp_unset_lock(&stats_lock);
+}
+
+// Admission control: a solve is accepted only if its threads fit in the daemon's budget,
+// so concurrent requests never oversubscribe the machine
+static int admit(int threads) {
+    int ok = 0;
+    omp_set_lock(&stats_lock);
+    if (stats.threads_in_use + threads <= max_threads) {
+        stats.threads_in_use += threads;
+        stats.in_flight++;
+        ok = 1;
+    }
+    omp_unset_lock(&stats_lock);
+    return ok;
+}
+
+static void release(int threads) {
+    omp_set_lock(&stats_lock);
+    stats.threads_in_use -= threads;
+    stats.in_flight--;
+    omp_unset_lock(&stats_lock);
+}
+
+// Upper edge (us) of the bucket holding the p-th fraction of the requests
+static long histogram_percentile(const DaemonStats *s, double p) {
+    long total = 0, seen = 0;
+    for (int b = 0; b < HIST_BUCKETS; b++) total += s->histogram[b];
+    if (total == 0) return 0;
+    long target = (long)(p * total + 0.5);
+    if (target < 1) target = 1;
+    for (int b = 0; b < HIST_BUCKETS; b++) {
+        seen += s->histogram[b];
+        if (seen >= target) return 2L << b;
+    }
+    return 2L << (HIST_BUCKETS - 1);
+}
+
+static int format_stats(char *out, size_t cap) {
+    DaemonStats s;
+    omp_set_lock(&stats_lock);
+    s = stats;
+    omp_unset_lock(&stats_lock);
+    double uptime = wall_time_seconds() - daemon_start;
+    int n = snprintf(out, cap,
+        "OK\n{\"uptime_seconds\": %.3f, \"requests\": %ld, \"solved\": %ld, \"rejected\": %ld, \"failed\": %ld, \"cache_hits\": %ld, "
+        "\"in_flight\": %d, \"threads_in_use\": %d, \"max_threads\": %d, \"throughput_rps\": %.3f, "
+        "\"latency_ms\": {\"mean\": %.3f, \"max\": %.3f, \"p50_le\": %.3f, \"p90_le\": %.3f, \"p99_le\": %.3f, \"histogram_us\": [",
+        uptime, s.requests, s.solved, s.rejected, s.failed, s.cache_hits, s.in_flight, s.threads_in_use, max_threads,
+        uptime > 0.0 ? s.solved / uptime : 0.0,
+        s.requests > 0 ? s.latency_sum_ms / s.requests : 0.0, s.latency_max_ms,
+        histogram_percentile(&s, 0.50) / 1000.0, histogram_percentile(&s, 0.90) / 1000.0,
+        histogram_percentile(&s, 0.99) / 1000.0);
+    for (int b = 0; b < HIST_BUCKETS && n < (int)cap; b++) {
+        n += snprintf(out + n, cap - n, "%s{\"le\": %ld, \"count\": %ld}", b ? ", " : "", 2L << b, s.histogram[b]);
+    }
+    if (n < (int)cap) n += snprintf(out + n, cap - n, "]}, \"per_algorithm\": {");
+    for (int a = 1; a < NUM_ALGORITHMS && n < (int)cap; a++) {
+        n += snprintf(out + n, cap - n, "%s\"%s\": %ld", a > 1 ? ", " : "", jobshop_algorithm_name(a), s.per_algorithm[a]);
+    }
+    if (n < (int)cap) n += snprintf(out + n, cap - n, "}}\n");
+    return n < (int)cap ? n : (int)cap - 1;
+}
+
+static int read_le32(const unsigned char *p) {
+    return (int)((unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24));
+}
+
+static int decode_binary_instance(const unsigned char *data, long len, Shop *shop) {
+    if (len < 12) return 0;
+    shop->njobs = read_le32(data);
+    shop->nmachs = read_le32(data + 4);
+    shop->nops = read_le32(data + 8);
+    if (shop->njobs <= 0 || shop->njobs > JMAX || shop->nmachs <= 0 || shop->nmachs > MMAX ||
+        shop->nops <= 0 || shop->nops > OPMAX || len != 12 + 8L * shop->njobs * shop->nops) {
+        return 0;
+    }
+    const unsigned char *p = data + 12;
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int o = 0; o < shop->nops; o++, p += 8) {
+            shop->plan[j][o].mach = read_le32(p);
+            shop->plan[j][o].len = read_le32(p + 4);
+            shop->plan[j][o].stime = -1;
+            if (shop->plan[j][o].mach < 0 || shop->plan[j][o].mach >= shop->nmachs || shop->plan[j][o].len < 0) return 0;
+        }
+    }
+    shop->nlogs = 0;
+    return 1;
+}
+
+static void send_line(JobshopSocket c, const char *line) {
+    socket_send_all(c, line, strlen(line));
+}
+
+// Handle one SOLVE request; returns the stats outcome (1 solved, 2 rejected, 0 failed)
+static int handle_solve(WorkerArena *arena, JobshopSocket c, const char *line, int *algorithm_out) {
+    char format[16], algorithm_name[32], extra[32] = "";
+    int threads;
+    double budget;
+    long payload_bytes;
+    int fields = sscanf(line, "SOLVE %15s %31s %d %lf %ld %31s", format, algorithm_name, &threads, &budget, &payload_bytes, extra);
+    if (fields < 5) {
+        send_line(c, "ERROR usage: SOLVE <text|bin> <algorithm> <threads> <budget_seconds> <payload_bytes> [propagate]\n");
+        return 0;
+    }
+    if (payload_bytes <= 0 || payload_bytes > MAX_PAYLOAD_BYTES) {
+        send_line(c, "ERROR payload size out of range\n");
+        return 0;
+    }
+    // Drain the payload before any further error so the client always gets to read the reply
+    if (!socket_recv_all(c, arena->payload, (size_t)payload_bytes)) return 0;
+    arena->payload[payload_bytes] = '\0';
+    int algorithm = jobshop_algorithm_from_name(algorithm_name);
+    *algorithm_out = algorithm;
+    if (!algorithm) {
+        send_line(c, "ERROR unknown algorithm (sb_seq, sb_par, bb_seq, bb_par, portfolio)\n");
+        return 0;
+    }
+
+    int ok;
+    if (strcmp(format, "bin") == 0) ok = decode_binary_instance((unsigned char*)arena->payload, payload_bytes, arena->shop);
+    else if (strcmp(format, "text") == 0) ok = parse_problem_seq(arena->payload, arena->shop);
+    else ok = 0;
+    if (!ok || !jobshop_solver_set_problem(arena->solver, arena->shop)) {
+        send_line(c, "ERROR malformed instance\n");
+        return 0;
+    }
+
+    // Clip the request to what the daemon allows, then ask admission control
+    if (threads < 1) threads = 1;
+    if (algorithm == JOBSHOP_ALGO_SB_SEQ || algorithm == JOBSHOP_ALGO_BB_SEQ) threads = 1;
+    if (algorithm == JOBSHOP_ALGO_PORTFOLIO && threads < 2) threads = 2;
+    if (threads > max_threads) threads = max_threads;
+    if (budget <= 0.0 || budget > max_budget) budget = max_budget;
+    if (!admit(threads)) {
+        send_line(c, "BUSY thread budget exhausted, retry later\n");
+        return 2;
+    }
+    JobshopOptions opt;
+    JobshopResult result;
+    jobshop_options_init(&opt);
+    opt.algorithm = algorithm;
+    opt.threads = threads;
+    opt.budget_seconds = budget;
+    opt.propagate = (strcmp(extra, "propagate") == 0);
+    opt.cache_dir = cache_dir;
+    opt.cache_max_mb = jobshop_cache_max_mb();
+    int solved = jobshop_solver_solve(arena->solver, &opt, &result);
+    release(threads);
+    if (solved && result.cached) {
+        omp_set_lock(&stats_lock);
+        stats.cache_hits++;
+        omp_unset_lock(&stats_lock);
+    }
+    if (!solved) {
+        send_line(c, "ERROR no schedule found\n");
+        return 0;
+    }
+
+    const Shop *shop = jobshop_solver_shop(arena->solver);
+    char *out = arena->reply;
+    int n = snprintf(out, MAX_REPLY_BYTES, "OK %d %d %d %.6f\n%d\n", result.makespan, result.lower_bound,
+                     result.optimal, result.seconds, result.makespan);
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int o = 0; o < shop->nops; o++) {
+            n += snprintf(out + n, MAX_REPLY_BYTES - n, "%d ", shop->plan[j][o].stime);
+        }
+        n += snprintf(out + n, MAX_REPLY_BYTES - n, "\n");
+    }
+    socket_send_all(c, out, (size_t)n);
+    return 1;
+}
+
+static void handle_connection(WorkerArena *arena, JobshopSocket c, const char *socket_path, int workers) {
+    double start = wall_time_seconds();
+    char line[MAX_LINE];
+    int algorithm = 0, outcome = -1;
+    if (socket_recv_line(c, line, sizeof(line)) < 0) {
+        outcome = 0;
+    } else if (strncmp(line, "SOLVE ", 6) == 0) {
+        outcome = handle_solve(arena, c, line, &algorithm);
+    } else if (strcmp(line, "STATS") == 0) {
+        int n = format_stats(arena->reply, MAX_REPLY_BYTES);
+        socket_send_all(c, arena->reply, (size_t)n);
+    } else if (strcmp(line, "SHUTDOWN") == 0) {
+        send_line(c, "OK\n");
+        stop_requested = 1;
+        // Wake the workers blocked in accept() so they see the flag
+        for (int w = 0; w < workers; w++) {
+            JobshopSocket wake = socket_connect_unix(socket_path);
+            if (wake != JOBSHOP_INVALID_SOCKET) socket_close(wake);
+        }
+    } else {
+        send_line(c, "ERROR unknown command (SOLVE, STATS, SHUTDOWN)\n");
+        outcome = 0;
+    }
+    // STATS and SHUTDOWN are not counted, so they do not skew the latency histogram
+    if (outcome >= 0) record_request((wall_time_seconds() - start) * 1000.0, algorithm, outcome);
+}
+
+int main(int argc, char *argv[]) {
+    int use_cache = !take_option_flag(&argc, argv, "--no-cache"); // Always solve, bypassing the solution cache
+    if (argc < 2 || argc > 5) {
+        printf("Usage: %s <socket_path> [workers] [max_threads] [max_budget_seconds] [--no-cache]\n", argv[0]);
+        printf("  workers: concurrent requests (default %d)\n", DEFAULT_WORKERS);
+        printf("  max_threads: solver threads shared by all requests (default: number of processors)\n");
+        printf("  max_budget_seconds: cap on the per-request budget (default %.0f)\n", DEFAULT_MAX_BUDGET_SECONDS);
+        printf("  --no-cache: solve every request even when %s holds the answer\n", jobshop_cache_dir());
+        return 1;
+    }
+    const char *socket_path = argv[1];
+    int workers = (argc > 2) ? atoi(argv[2]) : DEFAULT_WORKERS;
+    max_threads = (argc > 3) ? atoi(argv[3]) : omp_get_num_procs();
+    max_budget = (argc > 4) ? atof(argv[4]) : DEFAULT_MAX_BUDGET_SECONDS;
+    if (workers < 1) workers = 1;
+    if (max_threads < 2) max_threads = 2; // Room for one portfolio request
+    if (max_budget <= 0.0) max_budget = DEFAULT_MAX_BUDGET_SECONDS;
+    cache_dir = use_cache ? jobshop_cache_dir() : NULL;
+
+    if (!socket_startup()) {
+        printf("Error: socket layer unavailable\n");
+        return 1;
+    }
+    JobshopSocket listener = socket_listen_unix(socket_path, workers * 4);
+    if (listener == JOBSHOP_INVALID_SOCKET) {
+        printf("Error: cannot listen on %s\n", socket_path);
+        socket_cleanup();
+        return 1;
+    }
+    omp_init_lock(&stats_lock);
+    omp_set_max_active_levels(4); // Worker -> portfolio sections -> engine threads
+    daemon_start = wall_time_seconds();
+    printf("Listening on %s: %d workers, %d solver threads, budget cap %.1fs, solution cache %s\n",
+           socket_path, workers, max_threads, max_budget, cache_dir ? cache_dir : "off");
+    fflush(stdout);
+
+    #pragma omp parallel num_threads(workers)
+    {
+        WorkerArena arena;
+        if (!arena_create(&arena)) {
+            #pragma omp critical
+            printf("Worker %d: out of memory for its arena\n", omp_get_thread_num());
+        } else {
+            while (!stop_requested) {
+                JobshopSocket c = socket_accept(listener);
+                if (c == JOBSHOP_INVALID_SOCKET) continue;
+                if (!stop_requested) handle_connection(&arena, c, socket_path, workers);
+                socket_close(c);
+            }
+        }
+        arena_free(&arena);
+    }
+
+    socket_close(listener);
+    remove(socket_path);
+    socket_cleanup();
+    printf("Daemon stopped: %ld requests, %ld solved, %ld rejected, %ld failed\n",
+           stats.requests, stats.solved, stats.rejected, stats.failed);
+    omp_destroy_lock(&stats_lock);
+    return 0;
+}
@@ -0,0 +1,142 @@
+// jobshop_socket.c
+// Unix-domain socket helpers (POSIX sockets, or winsock2 + afunix.h on Windows)
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // sockets and MSG_NOSIGNAL under -std=c99
+#endif
+
+#include "jobshop_socket.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL // A client that hung up must not kill the daemon with SIGPIPE
+#else
+#define SEND_FLAGS 0
+#endif
+
+int socket_startup(void) {
+#ifdef _WIN32
+    WSADATA wsa;
+    return WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+#else
+    return 1;
+#endif
+}
+
+void socket_cleanup(void) {
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+static int fill_address(struct sockaddr_un *addr, const char *path) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path)) {
+        fprintf(stderr, "Socket path too long: %s\n", path);
+        return 0;
+    }
+    strcpy(addr->sun_path, path);
+    return 1;
+}
+
+// Bind and listen on path, replacing a stale socket file left by an earlier run
+JobshopSocket socket_listen_unix(const char *path, int backlog) {
+    struct sockaddr_un addr;
+    if (!fill_address(&addr, path)) return JOBSHOP_INVALID_SOCKET;
+    JobshopSocket s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s == JOBSHOP_INVALID_SOCKET) return s;
+    remove(path);
+    if (bind(s, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(s, backlog) != 0) {
+        socket_close(s);
+        return JOBSHOP_INVALID_SOCKET;
+    }
+    return s;
+}
+
+JobshopSocket socket_connect_unix(const char *path) {
+    struct sockaddr_un addr;
+    if (!fill_address(&addr, path)) return JOBSHOP_INVALID_SOCKET;
+    JobshopSocket s = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (s == JOBSHOP_INVALID_SOCKET) return s;
+    if (connect(s, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        socket_close(s);
+        return JOBSHOP_INVALID_SOCKET;
+    }
+    return s;
+}
+
+JobshopSocket socket_accept(JobshopSocket listener) {
+    return accept(listener, NULL, NULL);
+}
+
+void socket_close(JobshopSocket s) {
+#ifdef _WIN32
+    closesocket(s);
+#else
+    close(s);
+#endif
+}
+
+int socket_send_all(JobshopSocket s, const void *buffer, size_t len) {
+    const char *p = (const char*)buffer;
+    while (len > 0) {
+        int chunk = len > (1 << 30) ? (1 << 30) : (int)len;
+        int sent = (int)send(s, p, chunk, SEND_FLAGS);
+        if (sent <= 0) return 0;
+        p += sent;
+        len -= (size_t)sent;
+    }
+    return 1;
+}
+
+// Read exactly len bytes; 0 if the peer closed first
+int socket_recv_all(JobshopSocket s, void *buffer, size_t len) {
+    char *p = (char*)buffer;
+    while (len > 0) {
+        int chunk = len > (1 << 30) ? (1 << 30) : (int)len;
+        int got = (int)recv(s, p, chunk, 0);
+        if (got <= 0) return 0;
+        p += got;
+        len -= (size_t)got;
+    }
+    return 1;
+}
+
+// Read one '\n'-terminated line (terminator stripped). Returns its length, -1 on error
+// or when the line does not fit.
+int socket_recv_line(JobshopSocket s, char *buffer, size_t cap) {
+    size_t n = 0;
+    for (;;) {
+        char c;
+        if (recv(s, &c, 1, 0) != 1) return -1;
+        if (c == '\n') break;
+        if (n + 1 >= cap) return -1;
+        buffer[n++] = c;
+    }
+    if (n > 0 && buffer[n - 1] == '\r') n--;
+    buffer[n] = '\0';
+    return (int)n;
+}
+
+// Read until the peer closes; returns the byte count (NUL-terminated), -1 on overflow
+long socket_recv_to_end(JobshopSocket s, char *buffer, size_t cap) {
+    size_t n = 0;
+    for (;;) {
+        if (n + 1 >= cap) return -1;
+        size_t room = cap - n - 1;
+        int got = (int)recv(s, buffer + n, room > (1 << 30) ? (1 << 30) : (int)room, 0);
+        if (got < 0) return -1;
+        if (got == 0) break;
+        n += (size_t)got;
+    }
+    buffer[n] = '\0';
+    return (long)n;
+}
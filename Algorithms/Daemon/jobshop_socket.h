@@ -0,0 +1,31 @@
+// jobshop_socket.h
+// Minimal Unix-domain stream socket layer shared by the scheduling daemon and its client.
+// AF_UNIX is also available on Windows 10 (1803+) through winsock2 + afunix.h.
+// Include this header before jobshop_common.h: winsock2.h has to precede windows.h.
+#ifndef JOBSHOP_SOCKET_H
+#define JOBSHOP_SOCKET_H
+
+#include <stddef.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <afunix.h>
+typedef SOCKET JobshopSocket;
+#define JOBSHOP_INVALID_SOCKET INVALID_SOCKET
+#else
+typedef int JobshopSocket;
+#define JOBSHOP_INVALID_SOCKET (-1)
+#endif
+
+int socket_startup(void);
+void socket_cleanup(void);
+JobshopSocket socket_listen_unix(const char *path, int backlog);
+JobshopSocket socket_connect_unix(const char *path);
+JobshopSocket socket_accept(JobshopSocket listener);
+void socket_close(JobshopSocket s);
+int socket_send_all(JobshopSocket s, const void *buffer, size_t len);
+int socket_recv_all(JobshopSocket s, void *buffer, size_t len);
+int socket_recv_line(JobshopSocket s, char *buffer, size_t cap);
+long socket_recv_to_end(JobshopSocket s, char *buffer, size_t cap);
+
+#endif // JOBSHOP_SOCKET_H
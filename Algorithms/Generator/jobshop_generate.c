@@ -0,0 +1,274 @@
+// jobshop_generate.c
+// Seeded instance generator following Taillard's procedure (E. Taillard, "Benchmarks for basic
+// scheduling problems", EJOR 64, 1993): durations drawn from U[1,99] with the time seed, and
+// each job's machine order obtained by shuffling 1..m with the machine seed, both through the
+// Lehmer LCG x <- 16807 x mod (2^31 - 1) in Schrage form (a = 16807, b = 127773, c = 2836).
+// With the seeds of ta01-ta80 and the default range it reproduces those instances.
+//
+// Jobs are written one at a time (O(machines) memory), so instances with millions of
+// operations stream straight to disk, as .jss text or as the daemon's binary form.
+// --sweep generates a family of sizes, solves each with libjobshop and tabulates runtime
+// against the number of operations.
+
+#include "../../Library/jobshop_solver.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LCG_A 16807
+#define LCG_B 127773
+#define LCG_C 2836
+#define LCG_M 2147483647
+#define DEFAULT_MIN_DURATION 1
+#define DEFAULT_MAX_DURATION 99
+#define MAX_SWEEP_SIZES 64
+#define MAX_SWEEP_ALGORITHMS 8
+
+#define DIST_UNIFORM 0             // Taillard: every duration from U[min, max]
+#define DIST_BOTTLENECK 1          // Machine 0 draws from the upper half of the range
+
+typedef struct {
+    int min_duration;
+    int max_duration;
+    int distribution;
+    int binary;
+} GenerateOptions;
+
+// Taillard's unif(seed, low, high)
+static int lcg_uniform(long *seed, int low, int high) {
+    long k = *seed / LCG_B;
+    *seed = LCG_A * (*seed % LCG_B) - k * LCG_C;
+    if (*seed < 0) *seed += LCG_M;
+    double value = (double)*seed / (double)LCG_M;
+    return low + (int)(value * (high - low + 1));
+}
+
+static void write_le32(FILE *f, int v) {
+    unsigned int u = (unsigned int)v;
+    unsigned char b[4] = { (unsigned char)(u & 0xFF), (unsigned char)((u >> 8) & 0xFF),
+                           (unsigned char)((u >> 16) & 0xFF), (unsigned char)((u >> 24) & 0xFF) };
+    fwrite(b, 1, 4, f);
+}
+
+// Streams one instance to filename; returns 1 on success
+static int generate_instance(const char *filename, int njobs, int nmachs, long time_seed, long machine_seed,
+                             const GenerateOptions *opt) {
+    FILE *f = fopen(filename, opt->binary ? "wb" : "w");
+    if (!f) return 0;
+    int *durations = (int*)malloc(sizeof(int) * nmachs);
+    int *machines = (int*)malloc(sizeof(int) * nmachs);
+    if (!durations || !machines) {
+        free(durations);
+        free(machines);
+        fclose(f);
+        return 0;
+    }
+    if (opt->binary) {
+        write_le32(f, njobs);
+        write_le32(f, nmachs);
+        write_le32(f, nmachs);
+    } else {
+        fprintf(f, "%d %d\n", njobs, nmachs);
+    }
+    // The two seeds drive independent streams, so drawing job by job gives the same
+    // instance as Taillard's all-durations-then-all-machines order
+    for (int j = 0; j < njobs; j++) {
+        for (int o = 0; o < nmachs; o++) durations[o] = lcg_uniform(&time_seed, opt->min_duration, opt->max_duration);
+        for (int o = 0; o < nmachs; o++) machines[o] = o;
+        for (int o = 0; o < nmachs; o++) {
+            int k = lcg_uniform(&machine_seed, o, nmachs - 1);
+            int tmp = machines[o];
+            machines[o] = machines[k];
+            machines[k] = tmp;
+        }
+        for (int o = 0; o < nmachs; o++) {
+            int len = durations[o];
+            if (opt->distribution == DIST_BOTTLENECK && machines[o] == 0) {
+                len = opt->max_duration - (len - opt->min_duration) / 2; // Folded into the upper half
+            }
+            if (opt->binary) {
+                write_le32(f, machines[o]);
+                write_le32(f, len);
+            } else {
+                fprintf(f, "%d %d ", machines[o], len);
+            }
+        }
+        if (!opt->binary) fprintf(f, "\n");
+    }
+    free(durations);
+    free(machines);
+    int ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+static int parse_distribution(const char *name) {
+    if (strcmp(name, "uniform") == 0) return DIST_UNIFORM;
+    if (strcmp(name, "bottleneck") == 0) return DIST_BOTTLENECK;
+    return -1;
+}
+
+// Optional trailing arguments shared by both modes: [min_duration max_duration] [distribution] [--binary]
+static int parse_options(int argc, char *argv[], int first, GenerateOptions *opt) {
+    opt->min_duration = DEFAULT_MIN_DURATION;
+    opt->max_duration = DEFAULT_MAX_DURATION;
+    opt->distribution = DIST_UNIFORM;
+    opt->binary = 0;
+    int numbers = 0;
+    for (int i = first; i < argc; i++) {
+        if (strcmp(argv[i], "--binary") == 0) {
+            opt->binary = 1;
+        } else if (parse_distribution(argv[i]) >= 0) {
+            opt->distribution = parse_distribution(argv[i]);
+        } else if (numbers == 0) {
+            opt->min_duration = atoi(argv[i]);
+            numbers++;
+        } else if (numbers == 1) {
+            opt->max_duration = atoi(argv[i]);
+            numbers++;
+        } else {
+            return 0;
+        }
+    }
+    return numbers != 1 && opt->min_duration >= 1 && opt->max_duration >= opt->min_duration;
+}
+
+static int run_sweep(char *sizes, long base_seed, const char *output_dir, const char *results_file,
+                     char *algorithm_list, int threads, const GenerateOptions *gen) {
+    int algorithms[MAX_SWEEP_ALGORITHMS], nalgorithms = 0;
+    for (char *tok = strtok(algorithm_list, ","); tok && nalgorithms < MAX_SWEEP_ALGORITHMS; tok = strtok(NULL, ",")) {
+        algorithms[nalgorithms] = jobshop_algorithm_from_name(tok);
+        if (!algorithms[nalgorithms]) {
+            printf("Error: unknown algorithm %s\n", tok);
+            return 1;
+        }
+        nalgorithms++;
+    }
+    int size_jobs[MAX_SWEEP_SIZES], size_machs[MAX_SWEEP_SIZES], nsizes = 0;
+    for (char *tok = strtok(sizes, ","); tok && nsizes < MAX_SWEEP_SIZES; tok = strtok(NULL, ",")) {
+        if (sscanf(tok, "%dx%d", &size_jobs[nsizes], &size_machs[nsizes]) != 2 ||
+            size_jobs[nsizes] <= 0 || size_machs[nsizes] <= 0) {
+            printf("Error: size %s is not <jobs>x<machines>\n", tok);
+            return 1;
+        }
+        nsizes++;
+    }
+    FILE *csv = fopen(results_file, "w");
+    JobshopSolver *solver = jobshop_solver_create();
+    if (!csv || !solver) {
+        printf("Error: cannot write %s\n", results_file);
+        if (csv) fclose(csv);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+    fprintf(csv, "jobs,machines,operations,time_seed,machine_seed,algorithm,threads,makespan,lower_bound,seconds,ops_per_second\n");
+    printf("%-12s %-11s %-30s %-8s %-10s %-10s %s\n", "Size", "Operations", "Algorithm", "Threads", "Makespan", "LB", "Time(s)");
+
+    // Each size gets its own pair of seeds, drawn from the base seed with the same LCG
+    long seed = base_seed > 0 ? base_seed % LCG_M : 1;
+    GenerateOptions text = *gen;
+    text.binary = 0; // libjobshop reads the .jss form
+    for (int s = 0; s < nsizes; s++) {
+        long time_seed = lcg_uniform(&seed, 1, LCG_M - 1);
+        long machine_seed = lcg_uniform(&seed, 1, LCG_M - 1);
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/taillard_%dx%d_%ld.jss", output_dir, size_jobs[s], size_machs[s], time_seed);
+        double start = wall_time_seconds();
+        if (!generate_instance(path, size_jobs[s], size_machs[s], time_seed, machine_seed, &text)) {
+            printf("Error: cannot write %s\n", path);
+            continue;
+        }
+        long ops = (long)size_jobs[s] * size_machs[s];
+        char size_label[32];
+        snprintf(size_label, sizeof(size_label), "%dx%d", size_jobs[s], size_machs[s]);
+        printf("%-12s %-11ld generated in %.3fs -> %s\n", size_label, ops, wall_time_seconds() - start, path);
+        if (size_jobs[s] > JMAX || size_machs[s] > MMAX || size_machs[s] > OPMAX) {
+            printf("%-12s %-11ld beyond JMAX x MMAX, not solved (see RollingHorizon for more jobs)\n", size_label, ops);
+            continue;
+        }
+        if (!jobshop_solver_load(solver, path)) continue;
+        for (int a = 0; a < nalgorithms; a++) {
+            JobshopOptions opt;
+            JobshopResult result;
+            jobshop_options_init(&opt);
+            opt.algorithm = algorithms[a];
+            opt.threads = (algorithms[a] == JOBSHOP_ALGO_SB_SEQ || algorithms[a] == JOBSHOP_ALGO_BB_SEQ) ? 1 : threads;
+            if (opt.algorithm == JOBSHOP_ALGO_PORTFOLIO) opt.budget_seconds = 60.0;
+            if (!jobshop_solver_solve(solver, &opt, &result)) continue;
+            double rate = result.seconds > 0.0 ? ops / result.seconds : 0.0;
+            printf("%-12s %-11ld %-30s %-8d %-10d %-10d %.6f\n", size_label, ops, jobshop_algorithm_name(algorithms[a]),
+                   opt.threads, result.makespan, result.lower_bound, result.seconds);
+            fprintf(csv, "%d,%d,%ld,%ld,%ld,%s,%d,%d,%d,%.6f,%.1f\n", size_jobs[s], size_machs[s], ops, time_seed,
+                    machine_seed, jobshop_algorithm_name(algorithms[a]), opt.threads, result.makespan, result.lower_bound,
+                    result.seconds, rate);
+            fflush(csv);
+        }
+    }
+    fclose(csv);
+    jobshop_solver_destroy(solver);
+    printf("Sweep results saved to %s\n", results_file);
+    return 0;
+}
+
+static int starts_with_algorithm(const char *list) {
+    char first[32];
+    size_t n = strcspn(list, ",");
+    if (n >= sizeof(first)) return 0;
+    memcpy(first, list, n);
+    first[n] = '\0';
+    return jobshop_algorithm_from_name(first) != 0;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s <jobs> <machines> <time_seed> <machine_seed> <output_file> [min max] [distribution] [--binary]\n", prog);
+    printf("       %s --sweep <sizes> <base_seed> <output_dir> <results_csv> [algorithms] [threads] [min max] [distribution]\n", prog);
+    printf("  min max: duration range (default %d %d, Taillard's)\n", DEFAULT_MIN_DURATION, DEFAULT_MAX_DURATION);
+    printf("  distribution: uniform (default) or bottleneck (machine 0 draws from the upper half)\n");
+    printf("  --binary: little-endian int32 jobs, machines, ops, then (machine, duration) pairs\n");
+    printf("  sizes: comma list of <jobs>x<machines>, e.g. 20x10,50x20,100x20,200x50,1000x100\n");
+    printf("  algorithms: comma list of sb_seq, sb_par, bb_seq, bb_par, portfolio (default sb_seq,sb_par)\n");
+    printf("Example (ta01): %s 15 15 840612802 398197754 ta01.jss\n", prog);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc >= 6 && strcmp(argv[1], "--sweep") == 0) {
+        char algorithm_list[128] = "sb_seq,sb_par";
+        int threads = 4, first_option = 6;
+        if (argc > 6 && starts_with_algorithm(argv[6])) {
+            snprintf(algorithm_list, sizeof(algorithm_list), "%s", argv[6]);
+            first_option = 7;
+            if (argc > 7) {
+                threads = atoi(argv[7]);
+                first_option = 8;
+            }
+        }
+        GenerateOptions gen;
+        if (threads < 1 || !parse_options(argc, argv, first_option, &gen)) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        return run_sweep(argv[2], atol(argv[3]), argv[4], argv[5], algorithm_list, threads, &gen);
+    }
+    if (argc < 6) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    int njobs = atoi(argv[1]);
+    int nmachs = atoi(argv[2]);
+    long time_seed = atol(argv[3]);
+    long machine_seed = atol(argv[4]);
+    GenerateOptions gen;
+    if (njobs <= 0 || nmachs <= 0 || time_seed <= 0 || machine_seed <= 0 || !parse_options(argc, argv, 6, &gen)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (!generate_instance(argv[5], njobs, nmachs, time_seed, machine_seed, &gen)) {
+        printf("Error: cannot write %s\n", argv[5]);
+        return 1;
+    }
+    printf("Generated %d jobs x %d machines (%ld operations) into %s\n", njobs, nmachs, (long)njobs * nmachs, argv[5]);
+    if (njobs > JMAX || nmachs > MMAX) {
+        printf("Note: larger than JMAX x MMAX (%d x %d); only the rolling-horizon driver takes more jobs\n", JMAX, MMAX);
+    }
+    return 0;
+}
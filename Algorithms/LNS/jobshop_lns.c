@@ -0,0 +1,265 @@
+// jobshop_lns.c
+// Large Neighbourhood Search: frees the operations of a time window (optionally restricted
+// to a group of machines) in a complete schedule and re-solves them exactly with the
+// subproblem Branch & Bound from jobshop_seq_bb.c. The rest of the schedule stays fixed and
+// only enters as release times and deadlines. Non-overlapping windows are solved in
+// parallel (OpenMP), the window then slides over the schedule.
+
+#include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_schedule.h"
+#include "../../Common/jobshop_bounds.h"
+#include "../BranchAndBound/jobshop_seq_bb.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <omp.h>
+
+#define DEFAULT_BUDGET_SECONDS 60.0
+#define DEFAULT_WINDOW_OPS 10
+#define SUB_NODE_LIMIT 200000L   // Per window; the best found so far is still used when hit
+#define MAX_IDLE_SWEEPS 2        // Stop after this many full sweeps without improvement
+
+typedef struct {
+    int t0;             // Operations entirely inside [t0, t1] are freed
+    int t1;
+    int improved;
+    BBSubproblem sub;
+} Window;
+
+static Shop shop;
+static Window *windows;            // One per window of a sweep, allocated after loading
+static int max_windows;
+static unsigned long long end_keys[JMAX * OPMAX];
+
+static int compare_keys(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+static int machine_selected(int mach, int group_first, int group_size) {
+    return group_size <= 0 || (mach >= group_first && mach < group_first + group_size);
+}
+
+// Cut [offset, makespan) into back-to-back windows of about window_ops operations each
+static int build_windows(int offset, int makespan, int window_ops, int group_first, int group_size) {
+    int n = shop.njobs * shop.nops;
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        Step *st = &shop.plan[i / shop.nops][i % shop.nops];
+        end_keys[i] = ((unsigned long long)(unsigned int)(st->stime + st->len) << 32) | (unsigned int)i;
+    }
+    qsort(end_keys, n, sizeof(unsigned long long), compare_keys);
+
+    int t0 = offset;
+    while (t0 < makespan && count < max_windows) {
+        int taken = 0, t1 = -1;
+        for (int k = 0; k < n; k++) {
+            int i = (int)(end_keys[k] & 0xffffffffu);
+            Step *st = &shop.plan[i / shop.nops][i % shop.nops];
+            if (st->stime < t0 || !machine_selected(st->mach, group_first, group_size)) continue;
+            t1 = st->stime + st->len;
+            if (++taken >= window_ops) break;
+        }
+        if (taken == 0) break;
+        windows[count].t0 = t0;
+        windows[count].t1 = t1;
+        count++;
+        t0 = t1;
+    }
+    return count;
+}
+
+// Describe the operations freed by a window as a subproblem. Returns the value of the
+// current placement (the incumbent for the search), or -1 if the window is unusable.
+static int build_subproblem(Window *w, int group_first, int group_size) {
+    BBSubproblem *sub = &w->sub;
+    int index_of[JMAX][OPMAX];
+    int first_start[MMAX], mach_deadline[MMAX];
+    int value = 0;
+
+    sub->count = 0;
+    sub->nchains = 0;
+    for (int m = 0; m < shop.nmachs; m++) {
+        first_start[m] = INT_MAX;
+        mach_deadline[m] = w->t1;
+        sub->mach_release[m] = w->t0;
+    }
+    for (int j = 0; j < shop.njobs; j++) {
+        int chain_start = sub->count;
+        int tail = 0;
+        for (int o = shop.nops - 1; o >= 0; o--) {
+            index_of[j][o] = -1;
+        }
+        for (int o = 0; o < shop.nops; o++) {
+            Step *st = &shop.plan[j][o];
+            if (st->stime < w->t0 || st->stime + st->len > w->t1 ||
+                !machine_selected(st->mach, group_first, group_size)) continue;
+            if (sub->count >= SUB_MAX_OPS) return -1;
+            int i = sub->count++;
+            index_of[j][o] = i;
+            sub->job[i] = j;
+            sub->op[i] = o;
+            sub->mach[i] = st->mach;
+            sub->len[i] = st->len;
+            sub->chain_ops[i] = i;
+            if (st->stime < first_start[st->mach]) first_start[st->mach] = st->stime;
+        }
+        for (int o = shop.nops - 1; o >= 0; o--) {
+            int i = index_of[j][o];
+            if (i >= 0) sub->tail[i] = tail;
+            tail += shop.plan[j][o].len;
+        }
+        if (sub->count > chain_start) {
+            sub->chain_first[sub->nchains] = chain_start;
+            sub->chain_len[sub->nchains] = sub->count - chain_start;
+            sub->nchains++;
+        }
+    }
+    if (sub->count < 2) return -1;
+
+    // Fixed operations on the freed machines: earlier ones release the machine,
+    // later ones bound it from above
+    for (int j = 0; j < shop.njobs; j++) {
+        for (int o = 0; o < shop.nops; o++) {
+            if (index_of[j][o] >= 0) continue;
+            Step *st = &shop.plan[j][o];
+            if (first_start[st->mach] == INT_MAX) continue;
+            if (st->stime < first_start[st->mach]) {
+                if (st->stime + st->len > sub->mach_release[st->mach]) sub->mach_release[st->mach] = st->stime + st->len;
+            } else if (st->stime < mach_deadline[st->mach]) {
+                mach_deadline[st->mach] = st->stime;
+            }
+        }
+    }
+    for (int i = 0; i < sub->count; i++) {
+        int j = sub->job[i], o = sub->op[i];
+        sub->release[i] = w->t0;
+        sub->deadline[i] = mach_deadline[sub->mach[i]];
+        if (o > 0 && index_of[j][o - 1] < 0) {
+            int pred_end = shop.plan[j][o - 1].stime + shop.plan[j][o - 1].len;
+            if (pred_end > sub->release[i]) sub->release[i] = pred_end;
+        }
+        if (o + 1 < shop.nops && index_of[j][o + 1] < 0) {
+            if (shop.plan[j][o + 1].stime < sub->deadline[i]) sub->deadline[i] = shop.plan[j][o + 1].stime;
+        }
+        int end = shop.plan[j][o].stime + shop.plan[j][o].len;
+        if (end + sub->tail[i] > value) value = end + sub->tail[i];
+    }
+    return value;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 5 || argc > 8) {
+        printf("Usage: %s <input_file> <schedule_file> <output_file> <num_threads> [budget_seconds] [window_ops] [machine_group_size]\n", argv[0]);
+        printf("  schedule_file: result of any solver (save_result_seq or Annex II format)\n");
+        printf("  machine_group_size: 0 frees all machines in a window, k frees k machines at a time\n");
+        return 1;
+    }
+    const char* input_file = argv[1];
+    const char* schedule_file = argv[2];
+    const char* output_file = argv[3];
+    int num_threads = atoi(argv[4]);
+    double budget = (argc > 5) ? atof(argv[5]) : DEFAULT_BUDGET_SECONDS;
+    int window_ops = (argc > 6) ? atoi(argv[6]) : DEFAULT_WINDOW_OPS;
+    int group_size = (argc > 7) ? atoi(argv[7]) : 0;
+    if (num_threads <= 0) num_threads = 1;
+    if (window_ops < 2) window_ops = 2;
+    if (window_ops > SUB_MAX_OPS) window_ops = SUB_MAX_OPS;
+
+    if (!load_problem_seq(input_file, &shop)) {
+        printf("Error loading input file: %s\n", input_file);
+        return 1;
+    }
+    if (!load_result_seq(schedule_file, &shop)) {
+        printf("Error loading schedule file: %s\n", schedule_file);
+        return 1;
+    }
+    int makespan = retime_semi_active(&shop);
+    if (makespan < 0) {
+        printf("Schedule in %s is inconsistent with the job order.\n", schedule_file);
+        return 1;
+    }
+    int initial_makespan = makespan;
+    if (group_size >= shop.nmachs) group_size = 0;
+    max_windows = shop.njobs * shop.nops / 2 + 1; // Every window holds at least two operations
+    windows = (Window*)malloc(sizeof(Window) * max_windows);
+    if (!windows) {
+        printf("Out of memory allocating %d windows\n", max_windows);
+        return 1;
+    }
+
+    ShopBounds bounds;
+    shop_lower_bounds(&shop, &bounds);
+
+    char *basename = extract_basename(input_file);
+    printf("Starting LNS for %s from makespan %d (%d threads, window %d ops, machine group %d)\n",
+           basename ? basename : "unknown", makespan, num_threads, window_ops, group_size);
+    bounds_print(&bounds, makespan);
+
+    double start_time = wall_time_seconds();
+    int offset = 0, group_first = 0, idle_sweeps = 0, sweep_improved = 0;
+    long windows_solved = 0, windows_improved = 0, nodes = 0;
+    // A schedule at the lower bound is optimal, so there is nothing left to improve
+    while (makespan > bounds.best && wall_time_seconds() - start_time < budget && idle_sweeps < MAX_IDLE_SWEEPS) {
+        int nwindows = build_windows(offset, makespan, window_ops, group_first, group_size);
+        int first_width = nwindows > 0 ? windows[0].t1 - windows[0].t0 : makespan;
+
+        // Windows do not overlap in time, so their subproblems are independent
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic) reduction(+:nodes)
+        for (int w = 0; w < nwindows; w++) {
+            windows[w].improved = 0;
+            int value = build_subproblem(&windows[w], group_first, group_size);
+            if (value < 0) continue;
+            windows[w].improved = bb_solve_subproblem(&windows[w].sub, value, SUB_NODE_LIMIT);
+            nodes += windows[w].sub.nodes;
+        }
+
+        int changed = 0;
+        for (int w = 0; w < nwindows; w++) {
+            windows_solved++;
+            if (!windows[w].improved) continue;
+            BBSubproblem *sub = &windows[w].sub;
+            for (int i = 0; i < sub->count; i++) {
+                shop.plan[sub->job[i]][sub->op[i]].stime = sub->best_start[i];
+            }
+            windows_improved++;
+            changed = 1;
+        }
+        if (changed) {
+            int new_makespan = retime_semi_active(&shop);
+            if (new_makespan < makespan) {
+                printf("[LNS] makespan %d -> %d\n", makespan, new_makespan);
+                sweep_improved = 1;
+            }
+            makespan = new_makespan;
+        }
+
+        // Slide: shift window boundaries by half a window, rotate the machine group
+        offset += first_width / 2 > 0 ? first_width / 2 : 1;
+        if (offset >= makespan || nwindows == 0) {
+            offset = 0;
+            if (group_size > 0) {
+                group_first += group_size;
+                if (group_first >= shop.nmachs) group_first = 0;
+            }
+            if (group_size == 0 || group_first == 0) {
+                idle_sweeps = sweep_improved ? 0 : idle_sweeps + 1;
+                sweep_improved = 0;
+            }
+        }
+    }
+    double time_taken = wall_time_seconds() - start_time;
+
+    printf("LNS finished for %s.\n", basename ? basename : "unknown");
+    printf("Initial makespan: %d\n", initial_makespan);
+    printf("Best makespan found: %d\n", makespan);
+    bounds_print(&bounds, makespan);
+    printf("Windows solved: %ld (improved: %ld), B&B nodes: %ld\n", windows_solved, windows_improved, nodes);
+    printf("Time taken: %.6f seconds\n", time_taken);
+
+    save_result_seq(output_file, &shop);
+    free(windows);
+    if (basename) free(basename);
+    return 0;
+}
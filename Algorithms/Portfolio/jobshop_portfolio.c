@@ -0,0 +1,83 @@
+// jobshop_portfolio.c
+// Concurrent solver portfolio: the Shifting Bottleneck heuristic and the Branch & Bound
+// search run side by side on disjoint OpenMP thread groups, share one lock-free
+// incumbent and stop together when the wall-clock budget expires or optimality is proven.
+// Command-line front end of JOBSHOP_ALGO_PORTFOLIO in libjobshop.
+
+#include "../../Library/jobshop_solver.h"
+#include "../../Library/jobshop_batch.h"
+#include "../../Library/jobshop_cache.h"
+#include "../../Common/jobshop_incumbent.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char* source_name(int source) {
+    switch (source) {
+        case INCUMBENT_SRC_SB: return "ShiftingBottleneck";
+        case INCUMBENT_SRC_BB: return "BranchAndBound";
+        default: return "none";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 4 && strcmp(argv[1], "--batch") == 0) { // Many instances and repetitions in one process
+        return jobshop_batch_run(argv[2], argv[3], JOBSHOP_ALGO_PORTFOLIO);
+    }
+    int use_cache = !take_option_flag(&argc, argv, "--no-cache"); // Always solve, bypassing the solution cache
+    if (argc < 4 || argc > 5) {
+        printf("Usage: %s <input_file> <output_file> <num_threads> [budget_seconds] [--no-cache]\n", argv[0]);
+        printf("       %s --batch <manifest> <results.csv|results.json>\n", argv[0]);
+        printf("  --no-cache: solve even when %s holds the answer\n", jobshop_cache_dir());
+        return 1;
+    }
+    const char* input_file = argv[1];
+    const char* output_file = argv[2];
+    int num_threads = atoi(argv[3]);
+    double budget = (argc == 5) ? atof(argv[4]) : JOBSHOP_PORTFOLIO_BUDGET;
+
+    JobshopSolver *solver = jobshop_solver_create();
+    if (!solver || !jobshop_solver_load(solver, input_file)) {
+        printf("Error loading input file: %s\n", input_file);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+
+    char *basename = extract_basename(input_file);
+    printf("Starting Portfolio for %s, budget %.1fs\n", basename ? basename : "unknown", budget);
+
+    JobshopOptions opt;
+    JobshopResult result;
+    jobshop_options_init(&opt);
+    opt.algorithm = JOBSHOP_ALGO_PORTFOLIO;
+    opt.threads = num_threads;
+    opt.budget_seconds = budget;
+    opt.cache_dir = use_cache ? jobshop_cache_dir() : NULL;
+    opt.cache_max_mb = jobshop_cache_max_mb();
+    if (!jobshop_solver_solve(solver, &opt, &result)) {
+        printf("No schedule found within the budget.\n");
+        if (basename) free(basename);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+    if (result.cached) printf("Solution cache: hit in %s\n", opt.cache_dir);
+    else printf("Portfolio: SB %d thread(s), B&B %d thread(s), lower bound %d\n",
+                result.sb_threads, result.bb_threads, result.lower_bound);
+
+    printf("Portfolio finished for %s.\n", basename ? basename : "unknown");
+    printf("Best makespan found: %d (by %s)\n", result.makespan, source_name(result.source));
+    bounds_print(&result.bounds, result.makespan);
+    printf("Optimality proven: %s\n", result.optimal ? "yes" : "no");
+    printf("Time taken: %.6f seconds\n", result.seconds);
+
+    // Save result (Annex II format: makespan, then start times per job)
+    if (jobshop_solver_save_start_times(solver, output_file)) {
+        printf("Results saved to %s\n", output_file);
+    } else {
+        printf("Error: Could not open output file %s for writing.\n", output_file);
+    }
+
+    if (basename) free(basename);
+    jobshop_solver_destroy(solver);
+    return 0;
+}
@@ -0,0 +1,396 @@
+// jobshop_reschedule.c
+// Incremental rescheduling: repairs a complete schedule after a new job arrives, a machine
+// goes down for an interval or an operation's duration changes, without solving again.
+// Operations that started before 'now' are frozen. The repair first right-shifts the
+// existing machine sequences (operations are only delayed, never moved earlier) and puts a
+// new job into idle gaps. The machines touched by the event are then re-sequenced with the
+// Shifting Bottleneck one-machine rule (release time, then processing time); that version
+// is kept only when it gives a shorter makespan.
+
+#include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_schedule.h"
+#include "jobshop_reschedule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// Working state of one repair, operations indexed [job * nops + op]
+typedef struct {
+    const Shop *shop;
+    int n;
+    int now;
+    int *frozen;
+    int *orig;                  // Start time before the event, -1 for a new job
+    int *lower;                 // Earliest start allowed by the repair step
+    int *start;
+    int *best;                  // Start times of the schedule that will be kept
+    int *in_seq;                // Operation is part of a machine sequence
+    int *seq;                   // Machine sequences: seq[mach_first[m] .. + mach_count[m])
+    int mach_first[MMAX];
+    int mach_count[MMAX];
+    int *mach_next;
+    int *in_degree;
+    int *queue;
+    unsigned long long *keys;
+    int down_mach;              // Machine down interval, down_mach = -1 if none
+    int down_from;
+    int down_to;
+} Repair;
+
+static int op_len(const Repair *r, int op) {
+    return r->shop->plan[op / r->shop->nops][op % r->shop->nops].len;
+}
+
+static int op_mach(const Repair *r, int op) {
+    return r->shop->plan[op / r->shop->nops][op % r->shop->nops].mach;
+}
+
+// Push a start past the down interval if the operation would overlap it
+static int skip_downtime(const Repair *r, int mach, int start, int len) {
+    if (mach == r->down_mach && start < r->down_to && start + len > r->down_from) return r->down_to;
+    return start;
+}
+
+static int compare_keys(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Machine sequences of the scheduled operations, in start time order
+static void build_sequences(Repair *r) {
+    int count = 0;
+    for (int i = 0; i < r->n; i++) {
+        r->in_seq[i] = r->orig[i] >= 0;
+        if (!r->in_seq[i]) continue;
+        r->keys[count++] = ((unsigned long long)(unsigned short)op_mach(r, i) << 48) |
+                           ((unsigned long long)(unsigned int)r->orig[i] << 16) | (unsigned short)i;
+    }
+    qsort(r->keys, count, sizeof(unsigned long long), compare_keys);
+    for (int m = 0; m < r->shop->nmachs; m++) r->mach_count[m] = 0;
+    for (int k = 0; k < count; k++) {
+        int i = (int)(r->keys[k] & 0xffff), m = op_mach(r, i);
+        r->seq[r->mach_first[m] + r->mach_count[m]++] = i;
+    }
+}
+
+// Earliest start of every sequenced operation given the sequences, 'now', the frozen
+// operations, lower[] and the down interval. Returns the makespan, -1 on a cycle.
+static int repair_retime(Repair *r) {
+    int nops = r->shop->nops, total = 0;
+    for (int i = 0; i < r->n; i++) {
+        r->mach_next[i] = -1;
+        r->in_degree[i] = (r->in_seq[i] && i % nops > 0 && r->in_seq[i - 1]) ? 1 : 0;
+        if (r->in_seq[i]) total++;
+    }
+    for (int m = 0; m < r->shop->nmachs; m++) {
+        for (int k = 0; k + 1 < r->mach_count[m]; k++) {
+            int u = r->seq[r->mach_first[m] + k], v = r->seq[r->mach_first[m] + k + 1];
+            r->mach_next[u] = v;
+            r->in_degree[v]++;
+        }
+    }
+    int head = 0, tail = 0, makespan = 0;
+    for (int i = 0; i < r->n; i++) {
+        r->start[i] = r->frozen[i] ? r->orig[i] : (r->lower[i] > r->now ? r->lower[i] : r->now);
+        if (r->in_seq[i] && r->in_degree[i] == 0) r->queue[tail++] = i;
+    }
+    while (head < tail) {
+        int u = r->queue[head++];
+        if (!r->frozen[u]) r->start[u] = skip_downtime(r, op_mach(r, u), r->start[u], op_len(r, u));
+        int end = r->start[u] + op_len(r, u);
+        if (end > makespan) makespan = end;
+        int succ[2] = { (u % nops) + 1 < nops && r->in_seq[u + 1] ? u + 1 : -1, r->mach_next[u] };
+        for (int s = 0; s < 2; s++) {
+            int v = succ[s];
+            if (v < 0) continue;
+            if (!r->frozen[v] && r->start[v] < end) r->start[v] = end;
+            if (--r->in_degree[v] == 0) r->queue[tail++] = v;
+        }
+    }
+    return tail == total ? makespan : -1;
+}
+
+// Put the operations of a new job into the earliest idle gaps that fit, leaving the
+// already timed operations where they are
+static int insert_new_job(Repair *r, int job) {
+    int nops = r->shop->nops, ready = r->now, makespan = 0;
+    for (int o = 0; o < nops; o++) {
+        int i = job * nops + o, m = op_mach(r, i), len = op_len(r, i);
+        int *seq = &r->seq[r->mach_first[m]];
+        int t = skip_downtime(r, m, ready, len), pos = 0;
+        for (; pos < r->mach_count[m]; pos++) {
+            int other = seq[pos];
+            int other_end = r->start[other] + op_len(r, other);
+            if (other_end <= t) continue;
+            if (r->start[other] >= t + len) break;
+            t = skip_downtime(r, m, other_end, len);
+        }
+        memmove(&seq[pos + 1], &seq[pos], sizeof(int) * (r->mach_count[m] - pos));
+        seq[pos] = i;
+        r->mach_count[m]++;
+        r->in_seq[i] = 1;
+        r->start[i] = t;
+        ready = t + len;
+        if (ready > makespan) makespan = ready;
+    }
+    return makespan;
+}
+
+// SB one-machine rule on the unfrozen part of a machine: release time (job predecessor
+// end in the current schedule, at least 'now'), ties by processing time
+static void resequence_machine(Repair *r, int m) {
+    int *seq = &r->seq[r->mach_first[m]];
+    int first = 0, nops = r->shop->nops;
+    while (first < r->mach_count[m] && r->frozen[seq[first]]) first++;
+    for (int k = first; k < r->mach_count[m]; k++) {
+        int i = seq[k];
+        int release = r->now;
+        if (i % nops > 0 && r->start[i - 1] + op_len(r, i - 1) > release) release = r->start[i - 1] + op_len(r, i - 1);
+        r->keys[i] = ((unsigned long long)(unsigned int)release << 32) | (unsigned int)op_len(r, i);
+    }
+    for (int k = first + 1; k < r->mach_count[m]; k++) {
+        int v = seq[k], pos = k;
+        while (pos > first && r->keys[seq[pos - 1]] > r->keys[v]) {
+            seq[pos] = seq[pos - 1];
+            pos--;
+        }
+        seq[pos] = v;
+    }
+}
+
+static void free_repair(Repair *r) {
+    free(r->frozen); free(r->orig); free(r->lower); free(r->start); free(r->best); free(r->in_seq); free(r->seq);
+    free(r->mach_next); free(r->in_degree); free(r->queue); free(r->keys);
+}
+
+// Apply one event to a complete schedule at time 'now' and repair it in place.
+// Returns the new makespan, or -1 if the event is invalid (the schedule is left unchanged).
+int reschedule_apply(Shop *shop, const RescheduleEvent *ev, int now, RescheduleReport *report) {
+    double start_time = wall_time_seconds();
+    memset(report, 0, sizeof(RescheduleReport));
+    report->makespan_resequenced = -1;
+    if (now < 0) now = 0;
+    report->makespan_before = schedule_makespan(shop);
+
+    // Validate before touching the schedule
+    int new_job = -1, event_mach = -1;
+    switch (ev->type) {
+        case RESCHED_NEW_JOB:
+            if (shop->njobs >= JMAX || ev->nops != shop->nops) {
+                fprintf(stderr, "New job needs %d operations and room below JMAX (%d)\n", shop->nops, JMAX);
+                return -1;
+            }
+            for (int o = 0; o < ev->nops; o++) {
+                if (ev->ops[o].mach < 0 || ev->ops[o].mach >= shop->nmachs || ev->ops[o].len < 0) {
+                    fprintf(stderr, "Invalid operation %d of the new job\n", o);
+                    return -1;
+                }
+            }
+            break;
+        case RESCHED_MACHINE_DOWN:
+            if (ev->mach < 0 || ev->mach >= shop->nmachs || ev->to <= ev->from) {
+                fprintf(stderr, "Invalid machine down interval\n");
+                return -1;
+            }
+            event_mach = ev->mach;
+            break;
+        case RESCHED_DURATION_CHANGE:
+            if (ev->job < 0 || ev->job >= shop->njobs || ev->op < 0 || ev->op >= shop->nops || ev->len < 0) {
+                fprintf(stderr, "Invalid operation for the duration change\n");
+                return -1;
+            }
+            event_mach = shop->plan[ev->job][ev->op].mach;
+            break;
+        default:
+            fprintf(stderr, "Unknown event type %d\n", ev->type);
+            return -1;
+    }
+
+    Repair r;
+    memset(&r, 0, sizeof(Repair));
+    int n = (shop->njobs + (ev->type == RESCHED_NEW_JOB ? 1 : 0)) * shop->nops;
+    r.frozen = (int*)calloc(n, sizeof(int));
+    r.orig = (int*)malloc(sizeof(int) * n);
+    r.lower = (int*)malloc(sizeof(int) * n);
+    r.start = (int*)malloc(sizeof(int) * n);
+    r.best = (int*)malloc(sizeof(int) * n);
+    r.in_seq = (int*)malloc(sizeof(int) * n);
+    r.seq = (int*)malloc(sizeof(int) * n);
+    r.mach_next = (int*)malloc(sizeof(int) * n);
+    r.in_degree = (int*)malloc(sizeof(int) * n);
+    r.queue = (int*)malloc(sizeof(int) * n);
+    r.keys = (unsigned long long*)malloc(sizeof(unsigned long long) * n);
+    if (!r.frozen || !r.orig || !r.lower || !r.start || !r.best || !r.in_seq || !r.seq ||
+        !r.mach_next || !r.in_degree || !r.queue || !r.keys) {
+        free_repair(&r);
+        fprintf(stderr, "Out of memory in reschedule_apply\n");
+        return -1;
+    }
+
+    // Apply the event to the problem data
+    if (ev->type == RESCHED_NEW_JOB) {
+        new_job = shop->njobs++;
+        for (int o = 0; o < shop->nops; o++) {
+            shop->plan[new_job][o].mach = ev->ops[o].mach;
+            shop->plan[new_job][o].len = ev->ops[o].len;
+            shop->plan[new_job][o].stime = -1;
+        }
+    } else if (ev->type == RESCHED_DURATION_CHANGE) {
+        shop->plan[ev->job][ev->op].len = ev->len;
+    }
+    r.shop = shop;
+    r.n = n;
+    r.now = now;
+    r.down_mach = -1;
+    for (int i = 0; i < n; i++) {
+        Step *st = &shop->plan[i / shop->nops][i % shop->nops];
+        r.orig[i] = st->stime;
+        r.lower[i] = st->stime >= 0 ? st->stime : 0;
+        r.frozen[i] = st->stime >= 0 && st->stime < now;
+        if (r.frozen[i]) report->frozen_ops++;
+    }
+    if (ev->type == RESCHED_MACHINE_DOWN) {
+        r.down_mach = ev->mach;
+        r.down_from = ev->from > now ? ev->from : now;
+        r.down_to = ev->to;
+        // A started operation running into the breakdown resumes once the machine is back
+        for (int i = 0; i < n; i++) {
+            Step *st = &shop->plan[i / shop->nops][i % shop->nops];
+            if (r.frozen[i] && st->mach == ev->mach && st->stime + st->len > r.down_from && r.down_to > r.down_from) {
+                st->len += r.down_to - r.down_from;
+            }
+        }
+    }
+    int mach_total[MMAX];
+    for (int m = 0; m < shop->nmachs; m++) mach_total[m] = 0;
+    for (int i = 0; i < n; i++) mach_total[op_mach(&r, i)]++;
+    for (int m = 0, first = 0; m < shop->nmachs; m++) {
+        r.mach_first[m] = first;
+        first += mach_total[m];
+    }
+
+    // Step 1: right-shift the existing sequences, then fill in a new job
+    build_sequences(&r);
+    int makespan = repair_retime(&r);
+    if (makespan < 0) {
+        fprintf(stderr, "Schedule contradicts the job order, cannot repair\n");
+        if (new_job >= 0) shop->njobs--;
+        free_repair(&r);
+        return -1;
+    }
+    if (new_job >= 0) {
+        int job_end = insert_new_job(&r, new_job);
+        if (job_end > makespan) makespan = job_end;
+    }
+    report->makespan_shift = makespan;
+    memcpy(r.best, r.start, sizeof(int) * n);
+
+    // Step 2: re-sequence the machines the event touched; operations elsewhere keep
+    // their right-shift time as lower bound so the repair stays local
+    int affected[MMAX];
+    for (int m = 0; m < shop->nmachs; m++) affected[m] = (m == event_mach);
+    for (int i = 0; i < n; i++) {
+        if (r.start[i] != r.orig[i]) affected[op_mach(&r, i)] = 1;
+    }
+    for (int i = 0; i < n; i++) {
+        r.lower[i] = affected[op_mach(&r, i)] ? 0 : r.best[i];
+    }
+    for (int m = 0; m < shop->nmachs; m++) {
+        if (!affected[m]) continue;
+        resequence_machine(&r, m);
+        report->resequenced_machines++;
+    }
+    if (report->resequenced_machines > 0) {
+        int resequenced = repair_retime(&r);
+        report->makespan_resequenced = resequenced;
+        if (resequenced >= 0 && resequenced < makespan) {
+            makespan = resequenced;
+            memcpy(r.best, r.start, sizeof(int) * n);
+            report->used_resequence = 1;
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        Step *st = &shop->plan[i / shop->nops][i % shop->nops];
+        if (r.orig[i] >= 0 && r.best[i] != r.orig[i]) report->moved_ops++;
+        st->stime = r.best[i];
+    }
+    free_repair(&r);
+
+    report->makespan = makespan;
+    report->repair_ms = (wall_time_seconds() - start_time) * 1000.0;
+    return makespan;
+}
+
+#ifndef JOBSHOP_ENGINE_ONLY
+static void print_usage(const char *program) {
+    printf("Usage: %s <schedule_file> <output_file> <now> <event> [event arguments]\n", program);
+    printf("  schedule_file: complete schedule in the save_result_seq format\n");
+    printf("  events:\n");
+    printf("    new-job <mach> <len> [<mach> <len> ...]   one pair per operation\n");
+    printf("    machine-down <mach> <from> <to>\n");
+    printf("    duration <job> <op> <len>\n");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 5) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char* schedule_file = argv[1];
+    const char* output_file = argv[2];
+    int now = atoi(argv[3]);
+    const char* event_name = argv[4];
+
+    static RescheduleEvent ev;
+    memset(&ev, 0, sizeof(ev));
+    if (strcmp(event_name, "new-job") == 0 && argc >= 7 && (argc - 5) % 2 == 0 && (argc - 5) / 2 <= OPMAX) {
+        ev.type = RESCHED_NEW_JOB;
+        ev.nops = (argc - 5) / 2;
+        for (int o = 0; o < ev.nops; o++) {
+            ev.ops[o].mach = atoi(argv[5 + 2 * o]);
+            ev.ops[o].len = atoi(argv[6 + 2 * o]);
+            ev.ops[o].stime = -1;
+        }
+    } else if (strcmp(event_name, "machine-down") == 0 && argc == 8) {
+        ev.type = RESCHED_MACHINE_DOWN;
+        ev.mach = atoi(argv[5]);
+        ev.from = atoi(argv[6]);
+        ev.to = atoi(argv[7]);
+    } else if (strcmp(event_name, "duration") == 0 && argc == 8) {
+        ev.type = RESCHED_DURATION_CHANGE;
+        ev.job = atoi(argv[5]);
+        ev.op = atoi(argv[6]);
+        ev.len = atoi(argv[7]);
+    } else {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    static Shop shop;
+    if (!load_schedule_seq(schedule_file, &shop)) {
+        printf("Error loading schedule file: %s\n", schedule_file);
+        return 1;
+    }
+
+    RescheduleReport report;
+    if (reschedule_apply(&shop, &ev, now, &report) < 0) {
+        printf("Rescheduling failed for event %s\n", event_name);
+        return 1;
+    }
+
+    printf("Rescheduled %s at time %d (event %s).\n", schedule_file, now, event_name);
+    printf("Makespan before: %d\n", report.makespan_before);
+    printf("Makespan after right-shift: %d\n", report.makespan_shift);
+    if (report.makespan_resequenced >= 0) {
+        printf("Makespan after re-sequencing %d machine(s): %d%s\n", report.resequenced_machines,
+               report.makespan_resequenced, report.used_resequence ? " (kept)" : "");
+    }
+    printf("Makespan: %d\n", report.makespan);
+    printf("Frozen operations: %d, moved operations: %d\n", report.frozen_ops, report.moved_ops);
+    printf("Repair time: %.3f ms\n", report.repair_ms);
+
+    save_result_seq(output_file, &shop);
+    return 0;
+}
+#endif // JOBSHOP_ENGINE_ONLY
@@ -0,0 +1,35 @@
+// jobshop_reschedule.h
+// Incremental repair of an existing schedule after a shop-floor event
+// (compile jobshop_reschedule.c with -DJOBSHOP_ENGINE_ONLY to leave out its main)
+#ifndef JOBSHOP_RESCHEDULE_H
+#define JOBSHOP_RESCHEDULE_H
+
+#include "../../Common/jobshop_common.h"
+
+#define RESCHED_NEW_JOB         1
+#define RESCHED_MACHINE_DOWN    2
+#define RESCHED_DURATION_CHANGE 3
+
+typedef struct {
+    int type;
+    int job, op, len;              // RESCHED_DURATION_CHANGE: new length of (job, op)
+    int mach, from, to;            // RESCHED_MACHINE_DOWN: machine unavailable in [from, to)
+    int nops;                      // RESCHED_NEW_JOB: operations (mach, len) of the new job
+    Step ops[OPMAX];
+} RescheduleEvent;
+
+typedef struct {
+    int makespan_before;
+    int makespan_shift;            // After right-shifting the existing sequences
+    int makespan_resequenced;      // After re-sequencing the affected machines (-1 if not tried)
+    int makespan;                  // Of the schedule that was kept
+    int frozen_ops;                // Already started at 'now', never moved
+    int moved_ops;
+    int resequenced_machines;
+    int used_resequence;
+    double repair_ms;
+} RescheduleReport;
+
+int reschedule_apply(Shop *shop, const RescheduleEvent *ev, int now, RescheduleReport *report);
+
+#endif // JOBSHOP_RESCHEDULE_H
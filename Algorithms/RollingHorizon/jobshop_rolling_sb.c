@@ -0,0 +1,348 @@
+// jobshop_rolling_sb.c
+// Rolling-horizon decomposition for instances with more jobs than JMAX. Jobs are streamed
+// from the input in file (release) order and scheduled horizon by horizon with the sequential
+// Shifting Bottleneck, each horizon starting from the machine availability left by the jobs
+// committed before it. Consecutive horizons overlap: the last overlap_jobs of a horizon are
+// not committed but re-scheduled together with the head of the next one. Inside a horizon,
+// jobs that share no machine form independent groups which are solved side by side (OpenMP).
+// In .jss files every job visits every machine, so a horizon is one group: it is then solved
+// by the parallel Shifting Bottleneck on all the threads.
+// Committed operations are placed in SB order into per-machine timelines, filling idle
+// gaps left by earlier horizons. Memory depends on the horizon size only: the timelines
+// keep a bounded number of intervals and committed jobs are written out immediately.
+
+#include "../../Common/jobshop_common.h"
+#include "../ShiftingBottleneck/jobshop_seq_sb.h"
+#include "../ShiftingBottleneck/jobshop_par_sb.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+
+#define DEFAULT_HORIZON_JOBS 50
+#define DEFAULT_OVERLAP_JOBS 10
+#define TIMELINE_MAX (4 * JMAX)   // Busy intervals remembered per machine
+
+// Busy intervals of the committed operations on one machine, sorted by start. When the
+// list is full the oldest interval is dropped and everything before its end counts as busy.
+typedef struct {
+    int floor;
+    int count;
+    int start[TIMELINE_MAX + 1];   // One spare entry for the insert before eviction
+    int end[TIMELINE_MAX + 1];
+} Timeline;
+
+// Sequential reader over the jobs of an instance file
+typedef struct {
+    FILE *file;
+    int njobs;      // Total jobs announced by the header
+    int nmachs;
+    int nops;
+    int next_job;   // Global index of the next job to read
+} JobStream;
+
+static Shop horizon;                 // Jobs of the current horizon
+static int horizon_ids[JMAX];        // Global job index of each horizon row
+static int mach_avail[MMAX];         // Machine availability after the committed jobs
+static Timeline timelines[MMAX];
+static unsigned long long commit_keys[JMAX * OPMAX];
+static int group_of_job[JMAX];
+static int group_parent[MMAX];
+
+static int open_job_stream(JobStream *js, const char *filename) {
+    js->file = fopen(filename, "r");
+    if (!js->file) {
+        perror("Error opening problem file");
+        return 0;
+    }
+    if (fscanf(js->file, "%d %d", &js->njobs, &js->nmachs) != 2) {
+        fprintf(stderr, "Error reading njobs and nmachs from %s\n", filename);
+        fclose(js->file);
+        return 0;
+    }
+    js->nops = js->nmachs; // Same assumption as load_problem_seq
+    if (js->njobs <= 0 || js->nmachs > MMAX || js->nops > OPMAX) {
+        fprintf(stderr, "Unsupported problem size %d x %d (machines limited to MMAX).\n", js->njobs, js->nmachs);
+        fclose(js->file);
+        return 0;
+    }
+    js->next_job = 0;
+    return 1;
+}
+
+// Read the next job into horizon row 'row'. Returns 0 at the end of the instance.
+static int read_next_job(JobStream *js, int row) {
+    if (js->next_job >= js->njobs) return 0;
+    for (int k = 0; k < js->nops; ++k) {
+        if (fscanf(js->file, "%d %d", &horizon.plan[row][k].mach, &horizon.plan[row][k].len) != 2) {
+            fprintf(stderr, "Error reading operation for job %d, op %d\n", js->next_job, k);
+            return 0;
+        }
+        horizon.plan[row][k].stime = -1;
+    }
+    horizon_ids[row] = js->next_job++;
+    return 1;
+}
+
+static int find_group(int m) {
+    while (group_parent[m] != m) {
+        group_parent[m] = group_parent[group_parent[m]];
+        m = group_parent[m];
+    }
+    return m;
+}
+
+// Union the machines used by each job; jobs of one machine group are scheduled together.
+// Returns the number of groups, group_of_job[] holds 0..groups-1.
+static int build_machine_groups(int count) {
+    int group_index[MMAX];
+    for (int m = 0; m < horizon.nmachs; m++) {
+        group_parent[m] = m;
+        group_index[m] = -1;
+    }
+    for (int j = 0; j < count; j++) {
+        int root = find_group(horizon.plan[j][0].mach);
+        for (int o = 1; o < horizon.nops; o++) {
+            int other = find_group(horizon.plan[j][o].mach);
+            if (other != root) group_parent[other] = root;
+        }
+    }
+    int groups = 0;
+    for (int j = 0; j < count; j++) {
+        int root = find_group(horizon.plan[j][0].mach);
+        if (group_index[root] < 0) group_index[root] = groups++;
+        group_of_job[j] = group_index[root];
+    }
+    return groups;
+}
+
+// Schedule the jobs of one machine group on a private copy of the horizon, with the parallel
+// Shifting Bottleneck when more than one thread is given
+static int schedule_group(int group, int count, int num_threads) {
+    Shop *sub = (Shop*)malloc(sizeof(Shop));
+    if (!sub) return 0;
+    int rows[JMAX];
+    sub->njobs = 0;
+    sub->nmachs = horizon.nmachs;
+    sub->nops = horizon.nops;
+    sub->nlogs = 0;
+    for (int j = 0; j < count; j++) {
+        if (group_of_job[j] != group) continue;
+        rows[sub->njobs] = j;
+        memcpy(sub->plan[sub->njobs], horizon.plan[j], sizeof(Step) * horizon.nops);
+        sub->njobs++;
+    }
+    SBWorkspace *ws = sb_workspace_create(sub->njobs * sub->nops);
+    int ok = ws && (num_threads > 1 ? shifting_bottleneck_schedule_par(sub, ws, num_threads, NULL, mach_avail)
+                                     : shifting_bottleneck_schedule_ws(sub, ws, NULL, mach_avail));
+    if (ok) {
+        // Groups use disjoint machines, so writing back into the shared horizon is safe
+        for (int i = 0; i < sub->njobs; i++) {
+            for (int o = 0; o < sub->nops; o++) {
+                horizon.plan[rows[i]][o].stime = sub->plan[i][o].stime;
+            }
+        }
+    }
+    sb_workspace_free(ws);
+    free(sub);
+    return ok;
+}
+
+// Earliest start >= ready at which the machine is free for len time units
+static int committed_find(const Timeline *tl, int ready, int len) {
+    int t = ready > tl->floor ? ready : tl->floor;
+    for (int i = 0; i < tl->count; i++) {
+        if (tl->end[i] <= t) continue;
+        if (tl->start[i] >= t + len) break;
+        t = tl->end[i];
+    }
+    return t;
+}
+
+static void committed_insert(Timeline *tl, int start, int end) {
+    int i = tl->count;
+    while (i > 0 && tl->start[i - 1] > start) {
+        tl->start[i] = tl->start[i - 1];
+        tl->end[i] = tl->end[i - 1];
+        i--;
+    }
+    tl->start[i] = start;
+    tl->end[i] = end;
+    tl->count++;
+    if (tl->count > TIMELINE_MAX) {
+        tl->floor = tl->end[0];
+        memmove(tl->start, tl->start + 1, sizeof(int) * TIMELINE_MAX);
+        memmove(tl->end, tl->end + 1, sizeof(int) * TIMELINE_MAX);
+        tl->count--;
+    }
+}
+
+static int compare_keys(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Place the committed jobs into the machine timelines in SB start time order. Operations
+// move into idle gaps left by earlier horizons where they fit; job order is kept because
+// an operation is never placed before its job predecessor ends.
+static void commit_jobs(int commit) {
+    int n = 0;
+    for (int j = 0; j < commit; j++) {
+        for (int o = 0; o < horizon.nops; o++) {
+            commit_keys[n++] = ((unsigned long long)(unsigned int)horizon.plan[j][o].stime << 32) |
+                               (unsigned int)(j * horizon.nops + o);
+        }
+    }
+    qsort(commit_keys, n, sizeof(unsigned long long), compare_keys);
+    for (int k = 0; k < n; k++) {
+        int i = (int)(commit_keys[k] & 0xffffffffu);
+        int j = i / horizon.nops, o = i % horizon.nops;
+        Step *st = &horizon.plan[j][o];
+        int ready = (o > 0) ? horizon.plan[j][o - 1].stime + horizon.plan[j][o - 1].len : 0;
+        st->stime = committed_find(&timelines[st->mach], ready, st->len);
+        committed_insert(&timelines[st->mach], st->stime, st->stime + st->len);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4 || argc > 6) {
+        printf("Usage: %s <input_file> <output_file> <num_threads> [horizon_jobs] [overlap_jobs]\n", argv[0]);
+        printf("  horizon_jobs: jobs scheduled together (default %d, at most %d)\n", DEFAULT_HORIZON_JOBS, JMAX);
+        printf("  overlap_jobs: jobs of a horizon re-scheduled with the next one (default %d)\n", DEFAULT_OVERLAP_JOBS);
+        printf("  num_threads: machines evaluated in parallel inside a horizon; horizons whose jobs\n");
+        printf("               use disjoint machine sets are split into groups solved side by side\n");
+        return 1;
+    }
+    const char* input_file = argv[1];
+    const char* output_file = argv[2];
+    int num_threads = atoi(argv[3]);
+    int horizon_jobs = (argc > 4) ? atoi(argv[4]) : DEFAULT_HORIZON_JOBS;
+    int overlap_jobs = (argc > 5) ? atoi(argv[5]) : DEFAULT_OVERLAP_JOBS;
+    if (num_threads <= 0) num_threads = 1;
+    if (horizon_jobs < 1) horizon_jobs = 1;
+    if (horizon_jobs > JMAX) horizon_jobs = JMAX;
+    if (overlap_jobs < 0) overlap_jobs = 0;
+    if (overlap_jobs >= horizon_jobs) overlap_jobs = horizon_jobs - 1;
+
+    JobStream js;
+    if (!open_job_stream(&js, input_file)) {
+        printf("Error loading input file: %s\n", input_file);
+        return 1;
+    }
+    horizon.nmachs = js.nmachs;
+    horizon.nops = js.nops;
+    horizon.nlogs = 0;
+    for (int m = 0; m < js.nmachs; m++) {
+        mach_avail[m] = 0;
+        timelines[m].floor = 0;
+        timelines[m].count = 0;
+    }
+
+    // Committed operations go to a side file first: the makespan heading the result is
+    // only known once the last horizon is done
+    char part_file[512];
+    snprintf(part_file, sizeof(part_file), "%s.part", output_file);
+    FILE *part = fopen(part_file, "w");
+    if (!part) {
+        printf("Error: Could not open %s for writing.\n", part_file);
+        fclose(js.file);
+        return 1;
+    }
+
+    char *basename = extract_basename(input_file);
+    printf("Starting Rolling Horizon SB for %s: %d jobs, %d machines, horizon %d, overlap %d, %d threads\n",
+           basename ? basename : "unknown", js.njobs, js.nmachs, horizon_jobs, overlap_jobs, num_threads);
+
+    double start_time = wall_time_seconds();
+    int carried = 0, horizons = 0, makespan = 0, committed_jobs = 0, failed = 0;
+    while (!failed) {
+        int count = carried;
+        while (count < horizon_jobs && read_next_job(&js, count)) count++;
+        if (count == carried && js.next_job < js.njobs) {
+            failed = 1; // Read error
+            break;
+        }
+        if (count == 0) break;
+        int last = (js.next_job >= js.njobs);
+        int commit = last ? count : count - overlap_jobs;
+        if (commit < 1) commit = 1;
+
+        int groups = build_machine_groups(count);
+        int group_failures = 0;
+        if (groups == 1) {
+            if (!schedule_group(0, count, num_threads)) group_failures++;
+        } else {
+            #pragma omp parallel for num_threads(num_threads) schedule(dynamic) reduction(+:group_failures)
+            for (int g = 0; g < groups; g++) {
+                if (!schedule_group(g, count, 1)) group_failures++;
+            }
+        }
+        if (group_failures > 0) {
+            printf("Error: Shifting Bottleneck failed on horizon %d\n", horizons);
+            failed = 1;
+            break;
+        }
+
+        // Commit the head of the horizon; its jobs now only matter through the machines
+        commit_jobs(commit);
+        for (int j = 0; j < commit; j++) {
+            for (int o = 0; o < horizon.nops; o++) {
+                Step *st = &horizon.plan[j][o];
+                int end = st->stime + st->len;
+                fprintf(part, "Job %d, Op %d: M%d, Len %d, Start %d\n", horizon_ids[j], o, st->mach, st->len, st->stime);
+                if (end > mach_avail[st->mach]) mach_avail[st->mach] = end;
+                if (end > makespan) makespan = end;
+            }
+        }
+        committed_jobs += commit;
+        horizons++;
+
+        // The uncommitted tail moves to the front and is solved again with the next jobs
+        carried = count - commit;
+        for (int j = 0; j < carried; j++) {
+            memcpy(horizon.plan[j], horizon.plan[commit + j], sizeof(Step) * horizon.nops);
+            horizon_ids[j] = horizon_ids[commit + j];
+        }
+        if (last) break;
+    }
+    double time_taken = wall_time_seconds() - start_time;
+    fclose(js.file);
+    fclose(part);
+
+    if (failed || committed_jobs != js.njobs) {
+        printf("Rolling Horizon SB failed after %d of %d jobs.\n", committed_jobs, js.njobs);
+        remove(part_file);
+        if (basename) free(basename);
+        return 1;
+    }
+
+    printf("Rolling Horizon SB finished for %s.\n", basename ? basename : "unknown");
+    printf("Horizons: %d\n", horizons);
+    printf("Makespan: %d\n", makespan);
+    printf("Time taken: %.6f seconds\n", time_taken);
+
+    // Save result in the save_result_seq layout: header, then the committed operations
+    FILE *file = fopen(output_file, "w");
+    part = fopen(part_file, "r");
+    if (file && part) {
+        fprintf(file, "Number of jobs: %d\n", js.njobs);
+        fprintf(file, "Number of machines: %d\n", js.nmachs);
+        fprintf(file, "Number of operations per job: %d\n", js.nops);
+        fprintf(file, "Makespan: %d\n\n", makespan);
+        fprintf(file, "Job Operations (Job, Operation, Machine, Duration, Start Time):\n");
+        char buffer[8192];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), part)) > 0) {
+            fwrite(buffer, 1, n, file);
+        }
+        printf("Results saved to %s\n", output_file);
+    } else {
+        printf("Error: Could not write output file %s\n", output_file);
+    }
+    if (file) fclose(file);
+    if (part) fclose(part);
+    remove(part_file);
+
+    if (basename) free(basename);
+    return 0;
+}
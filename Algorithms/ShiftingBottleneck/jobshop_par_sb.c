@@ -1,98 +1,66 @@
 // jobshop_par_sb.c
 // Parallel job shop scheduler using Shifting Bottleneck heuristic (OpenMP)
+// Engine only: the jobshop_par_sb executable is the thin CLI in jobshop_par_sb_cli.c
 
 #include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_trace.h"
+#include "../../Common/jobshop_parallel.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
-#include <sys/stat.h> // For mkdir on POSIX
 #include <omp.h>      // For OpenMP
+#include "jobshop_par_sb.h"
 
-#define MAX_TOTAL_OPS (JMAX * OPMAX)
-#define MAX_GRAPH_NODES (MAX_TOTAL_OPS + 2) // +2 for Source and Sink
-
-// Adjacency matrix representation for the graph
-static int adj[MAX_GRAPH_NODES][MAX_GRAPH_NODES];
-static int rev_adj[MAX_GRAPH_NODES][MAX_GRAPH_NODES];
-static int node_proc_times[MAX_GRAPH_NODES];
-static int est[MAX_GRAPH_NODES];
-static int tail_q[MAX_GRAPH_NODES];
-
-typedef int (*GraphMatrix)[MAX_GRAPH_NODES];
-void add_graph_edge(GraphMatrix matrix, int src, int dest) {
-    matrix[src][dest] = 1;
-}
-void clear_graph_matrix(GraphMatrix matrix, int num_nodes) {
-    for (int i = 0; i < num_nodes; ++i) {
-        for (int j = 0; j < num_nodes; ++j) {
-            matrix[i][j] = 0;
-        }
-    }
-}
-int op_to_node_idx(int job_idx, int op_idx_in_job, int ops_per_job_param) {
+// Arcs of adj are set through sb_add_arc, which keeps the closure and refuses cycles
+static int op_to_node_idx(int job_idx, int op_idx_in_job, int ops_per_job_param) {
     return 1 + job_idx * ops_per_job_param + op_idx_in_job;
 }
-void calculate_est_AON(int source_node_idx, int num_total_nodes, GraphMatrix matrix,
-                       int current_node_proc_times[], int result_est[]) {
-    for (int i = 0; i < num_total_nodes; i++) {
-        result_est[i] = 0;
-    }
-    int in_degree[MAX_GRAPH_NODES] = {0};
-    for (int u = 0; u < num_total_nodes; ++u) {
-        for (int v = 0; v < num_total_nodes; ++v) {
-            if (matrix[u][v]) in_degree[v]++;
-        }
-    }
-    int queue[MAX_GRAPH_NODES];
-    int head = 0, tail_idx = 0;
-    for (int i = 0; i < num_total_nodes; ++i) {
-        if (in_degree[i] == 0) {
-            queue[tail_idx++] = i;
-        }
-    }
-    result_est[source_node_idx] = 0;
-    while (head < tail_idx) {
-        int u = queue[head++];
-        for (int v = 0; v < num_total_nodes; ++v) {
-            if (matrix[u][v]) {
-                if (result_est[v] < result_est[u] + current_node_proc_times[u]) {
-                    result_est[v] = result_est[u] + current_node_proc_times[u];
-                }
-                in_degree[v]--;
-                if (in_degree[v] == 0) {
-                    queue[tail_idx++] = v;
-                }
-            }
-        }
-    }
-}
-void shifting_bottleneck_schedule(Shop *shop, int num_threads) {
-    omp_set_num_threads(num_threads);
+
+// Parallel Shifting Bottleneck on the caller's workspace: the unsequenced machines are
+// evaluated by num_threads OpenMP threads. PARALLEL_AUTO sizes the team of every iteration
+// from its work (unsequenced machines x operations scanned and sorted per machine), down
+// to the serial path on small instances and in the last iterations. ws->placement (optional)
+// pins the team and gives each NUMA node its own copy of the instance for the machine scans.
+// inc (optional) lets a portfolio driver cut the bottleneck loop short when its budget runs
+// out. mach_release (optional) is the time each machine becomes available, as in the
+// sequential version. Heads and tails take the level graph passes of the sequential
+// version, with teams sized by graph size. Returns 1 on success.
+int shifting_bottleneck_schedule_par(Shop *shop, SBWorkspace *ws, int num_threads, Incumbent *inc,
+                                     const int *mach_release) {
     int njobs = shop->njobs;
     int nops_per_job = shop->nops;
     if (njobs == 0 || nops_per_job == 0) {
         fprintf(stderr, "No jobs or operations to schedule.\n");
-        return;
+        return 0;
     }
     if (njobs > JMAX || nops_per_job > OPMAX) {
         fprintf(stderr, "Problem size exceeds defined limits (JMAX/OPMAX).\n");
-        return;
+        return 0;
     }
+    int auto_threads = (num_threads <= PARALLEL_AUTO);
     int num_ops_total = njobs * nops_per_job;
     int source_node = 0;
     int sink_node = num_ops_total + 1;
     int num_graph_nodes = num_ops_total + 2;
-    if (num_graph_nodes > MAX_GRAPH_NODES) {
-        fprintf(stderr, "Calculated graph nodes %d exceeds MAX_GRAPH_NODES %d\n", num_graph_nodes, MAX_GRAPH_NODES);
-        return;
+    if (num_graph_nodes > ws->nodes) {
+        fprintf(stderr, "Calculated graph nodes %d exceeds workspace size %d\n", num_graph_nodes, ws->nodes);
+        return 0;
     }
-    clear_graph_matrix(adj, num_graph_nodes);
-    clear_graph_matrix(rev_adj, num_graph_nodes);
+    int *node_proc_times = ws->node_proc_times;
+    int *est = ws->est;
+    int *tail_q = ws->tail_q;
+    int *min_start = ws->min_start;
+    SolverStats *stats = ws->stats;
+    const ParallelPlacement *placement = parallel_placement_active(ws->placement) ? ws->placement : NULL;
+    ShopReplicas replicas;
+    parallel_replicas_init(&replicas);
+    sb_clear_graph(ws, num_graph_nodes);
     for (int i = 0; i < num_graph_nodes; ++i) {
         node_proc_times[i] = 0;
         est[i] = 0;
         tail_q[i] = 0;
+        min_start[i] = 0;
     }
     node_proc_times[source_node] = 0;
     node_proc_times[sink_node] = 0;
@@ -101,16 +69,19 @@ void shifting_bottleneck_schedule(Shop *shop, int num_threads) {
             int current_op_node = op_to_node_idx(j, o, nops_per_job);
             if (current_op_node < 1 || current_op_node > num_ops_total) continue;
             node_proc_times[current_op_node] = shop->plan[j][o].len;
+            if (mach_release && mach_release[shop->plan[j][o].mach] > 0) {
+                min_start[current_op_node] = mach_release[shop->plan[j][o].mach];
+            }
             if (o == 0) {
-                add_graph_edge(adj, source_node, current_op_node);
+                sb_add_arc(ws, num_graph_nodes, source_node, current_op_node);
             }
             if (o < nops_per_job - 1) {
                 int next_op_node = op_to_node_idx(j, o + 1, nops_per_job);
                 if (next_op_node < 1 || next_op_node > num_ops_total) continue;
-                add_graph_edge(adj, current_op_node, next_op_node);
+                sb_add_arc(ws, num_graph_nodes, current_op_node, next_op_node);
             }
             if (o == nops_per_job - 1) {
-                add_graph_edge(adj, current_op_node, sink_node);
+                sb_add_arc(ws, num_graph_nodes, current_op_node, sink_node);
             }
         }
     }
@@ -120,35 +91,57 @@ void shifting_bottleneck_schedule(Shop *shop, int num_threads) {
     int best_sequence_for_bottleneck_machine_global[JMAX];
     int temp_best_sequence_storage[JMAX];
     while (num_sequenced_machines_count < shop->nmachs) {
-        calculate_est_AON(source_node, num_graph_nodes, adj, node_proc_times, est);
-        clear_graph_matrix(rev_adj, num_graph_nodes);
-        for (int u_node = 0; u_node < num_graph_nodes; ++u_node) {
-            for (int v_node = 0; v_node < num_graph_nodes; ++v_node) {
-                if (adj[u_node][v_node]) {
-                    add_graph_edge(rev_adj, v_node, u_node);
-                }
-            }
+        // Out of budget: schedule what is sequenced so far with the final list pass
+        if (inc && incumbent_should_stop(inc)) break;
+        double phase_start = stats_clock(stats);
+        TRACE_BEGIN("sb_est");
+        int levels = sb_build_level_graph(ws, num_graph_nodes, num_threads);
+        if (levels < 0) {
+            parallel_replicas_free(&replicas);
+            fprintf(stderr, "Out of memory for the level graph.\n");
+            TRACE_END("sb_est");
+            return 0;
         }
-        calculate_est_AON(sink_node, num_graph_nodes, rev_adj, node_proc_times, tail_q);
+        TRACE_COUNTER("sb_levels", levels);
+        sb_level_longest_path(ws, num_graph_nodes, levels, 1, node_proc_times, min_start, est, num_threads);
+        TRACE_END("sb_est");
+        phase_start = stats_phase(stats, STATS_PHASE_SB_EST, phase_start);
+        TRACE_BEGIN("sb_tail");
+        sb_level_longest_path(ws, num_graph_nodes, levels, 0, node_proc_times, NULL, tail_q, num_threads);
+        TRACE_END("sb_tail");
+        phase_start = stats_phase(stats, STATS_PHASE_SB_TAIL, phase_start);
         int overall_best_machine_idx = -1;
         long long overall_max_bottleneck_metric = -1;
         int overall_best_seq_len = 0;
-        #pragma omp parallel
+        int team = num_threads;
+        if (auto_threads) {
+            double work = (double)(shop->nmachs - num_sequenced_machines_count) * (num_ops_total + njobs * njobs);
+            team = parallel_team_size(work, PARALLEL_AUTO);
+            TRACE_COUNTER("sb_team", team);
+        }
+        #pragma omp parallel num_threads(team) if(team > 1)
         {
+            // Pinned once per thread; the replica of its node is made on first use and kept
+            const Shop *local_shop = shop;
+            if (placement) {
+                parallel_bind_thread(placement, omp_get_thread_num(), omp_get_num_threads());
+                local_shop = parallel_local_shop(&replicas, placement, shop);
+            }
             int local_best_machine_idx = -1;
             long long local_max_bottleneck_metric = -1;
             int local_best_seq_len = 0;
             OneMachineOpInfo thread_local_machine_ops_buffer[JMAX];
             int thread_local_current_sequence_nodes_buffer[JMAX];
             int thread_local_best_sequence_for_machine[JMAX];
-            #pragma omp for schedule(dynamic)
+            TRACE_BEGIN("sb_machine_eval");
+            #pragma omp for schedule(dynamic) nowait
             for (int m_idx = 0; m_idx < shop->nmachs; ++m_idx) {
                 if (sequenced_machines_flags[m_idx]) continue;
                 int num_ops_on_this_machine = 0;
                 int stop_collecting_for_this_machine = 0;
                 for (int j = 0; j < njobs; ++j) {
                     for (int o = 0; o < nops_per_job; ++o) {
-                        if (shop->plan[j][o].mach == m_idx + 1) {
+                        if (local_shop->plan[j][o].mach == m_idx) {
                             if (num_ops_on_this_machine >= JMAX) {
                                 stop_collecting_for_this_machine = 1; break;
                             }
@@ -194,6 +187,7 @@ void shifting_bottleneck_schedule(Shop *shop, int num_threads) {
                     }
                 }
             }
+            TRACE_END("sb_machine_eval");
             #pragma omp critical
             {
                 if (local_best_machine_idx != -1 && local_max_bottleneck_metric > overall_max_bottleneck_metric) {
@@ -206,26 +200,31 @@ void shifting_bottleneck_schedule(Shop *shop, int num_threads) {
                 }
             }
         }
+        phase_start = stats_phase(stats, STATS_PHASE_SB_MACHINE_EVAL, phase_start);
         if (overall_best_machine_idx == -1) {
             break;
         }
+        TRACE_BEGIN("sb_commit");
         for (int i = 0; i < overall_best_seq_len; ++i) {
             best_sequence_for_bottleneck_machine_global[i] = temp_best_sequence_storage[i];
         }
-        for (int i = 0; i < overall_best_seq_len - 1; ++i) {
-            int u_node = best_sequence_for_bottleneck_machine_global[i];
-            int v_node = best_sequence_for_bottleneck_machine_global[i + 1];
-            if (u_node < 1 || u_node > num_ops_total || v_node < 1 || v_node > num_ops_total) continue;
-            add_graph_edge(adj, u_node, v_node);
-        }
+        sb_commit_sequence(ws, num_graph_nodes, best_sequence_for_bottleneck_machine_global, overall_best_seq_len);
         sequenced_machines_flags[overall_best_machine_idx] = 1;
         num_sequenced_machines_count++;
+        TRACE_END("sb_commit");
+        stats_phase(stats, STATS_PHASE_SB_COMMIT, phase_start);
+        if (stats) stats->sb_iterations++;
     }
-    calculate_est_AON(source_node, num_graph_nodes, adj, node_proc_times, est);
-    int machine_available_time[MMAX];
-    for (int m = 0; m < shop->nmachs; m++) {
-        machine_available_time[m] = 0;
+    parallel_replicas_free(&replicas);
+    double final_start = stats_clock(stats);
+    TRACE_BEGIN("sb_final_schedule");
+    int final_levels = sb_build_level_graph(ws, num_graph_nodes, num_threads);
+    if (final_levels < 0) {
+        fprintf(stderr, "Out of memory for the level graph.\n");
+        TRACE_END("sb_final_schedule");
+        return 0;
     }
+    sb_level_longest_path(ws, num_graph_nodes, final_levels, 1, node_proc_times, min_start, est, num_threads);
     typedef struct {
         int job;
         int op;
@@ -233,7 +232,13 @@ void shifting_bottleneck_schedule(Shop *shop, int num_threads) {
         int machine;
         int duration;
     } OpScheduleInfo;
-    OpScheduleInfo op_list[MAX_TOTAL_OPS];
+    OpScheduleInfo *op_list = (OpScheduleInfo*)malloc(sizeof(OpScheduleInfo) * num_ops_total);
+    if (!op_list || !sb_prepare_timelines(shop, ws, mach_release)) {
+        free(op_list);
+        fprintf(stderr, "Out of memory for the final scheduling pass.\n");
+        TRACE_END("sb_final_schedule");
+        return 0;
+    }
     int op_count = 0;
     for (int j = 0; j < njobs; ++j) {
         for (int o = 0; o < nops_per_job; ++o) {
@@ -242,7 +247,7 @@ void shifting_bottleneck_schedule(Shop *shop, int num_threads) {
             op_list[op_count].job = j;
             op_list[op_count].op = o;
             op_list[op_count].est_time = est[op_node];
-            op_list[op_count].machine = shop->plan[j][o].mach - 1;
+            op_list[op_count].machine = shop->plan[j][o].mach;
             op_list[op_count].duration = shop->plan[j][o].len;
             op_count++;
         }
@@ -270,105 +275,13 @@ void shifting_bottleneck_schedule(Shop *shop, int num_threads) {
                 earliest_start = prev_end_time;
             }
         }
-        if (earliest_start < machine_available_time[machine_idx]) {
-            earliest_start = machine_available_time[machine_idx];
-        }
+        // Earliest idle slot on the machine, possibly in a gap left by earlier placements
+        earliest_start = timeline_earliest(&ws->timelines[machine_idx], earliest_start, duration);
+        timeline_insert(&ws->timelines[machine_idx], earliest_start, earliest_start + duration);
         shop->plan[j][o].stime = earliest_start;
-        machine_available_time[machine_idx] = earliest_start + duration;
     }
+    free(op_list);
+    TRACE_END("sb_final_schedule");
+    stats_phase(stats, STATS_PHASE_SB_FINAL, final_start);
+    return 1;
 }
-
-int main(int argc, char *argv[]) {
-    if (argc < 4) { // Expect input_file, output_file, num_threads
-        fprintf(stderr, "Usage: %s <input_file> <output_file> <num_threads>\n", argv[0]);
-        return 1;
-    }
-    char *input_file = argv[1];
-    char *output_file = argv[2];
-    int num_threads = atoi(argv[3]);
-
-    if (num_threads <= 0) {
-        fprintf(stderr, "Number of threads must be positive.\n");
-        return 1;
-    }
-
-    Shop shop_instance;
-    Shop* shop = &shop_instance; // Use the standard Shop struct
-
-    // if (!read_problem(shop, input_file)) { // Use the common read_problem
-    if (!load_problem_seq(input_file, shop)) { // Use load_problem_seq
-        fprintf(stderr, "Error loading problem from %s\n", input_file);
-        return 1;
-    }
-    
-    if (shop->njobs == 0 || shop->nops == 0) {
-        printf("No jobs or operations found in the input file.\n");
-        // write_solution(shop, output_file, 0); // Write empty solution if needed
-        return 0;
-    }
-
-    double start_time = omp_get_wtime();
-
-    shifting_bottleneck_schedule(shop, num_threads); // Call the parallel version
-
-    double end_time = omp_get_wtime();
-    double time_taken = end_time - start_time;
-
-    int makespan = 0;
-    for (int j = 0; j < shop->njobs; j++) {
-        for (int o = 0; o < shop->nops; o++) {
-            int end_op_time = shop->plan[j][o].stime + shop->plan[j][o].len;
-            if (end_op_time > makespan) {
-                makespan = end_op_time;
-            }
-        }
-    }
-    
-    // Create directory for output file if it doesn't exist
-    char *last_slash = strrchr(output_file, '/');
-    #ifdef _WIN32
-    char *last_backslash = strrchr(output_file, '\\');
-    if (last_backslash > last_slash) last_slash = last_backslash;
-    #endif
-
-    if (last_slash != NULL) {
-        char dir_path[256];
-        strncpy(dir_path, output_file, last_slash - output_file);
-        dir_path[last_slash - output_file] = '\0';
-        
-        struct stat st = {0};
-        if (stat(dir_path, &st) == -1) {
-            #ifdef _WIN32
-                _mkdir(dir_path); // For Windows
-            #else
-                mkdir(dir_path, 0777); // For POSIX
-            #endif
-        }
-    }
-
-    // write_solution(shop, output_file, makespan); // Use the common write_solution
-    save_result_seq(output_file, shop); // Use save_result_seq, makespan is calculated internally by save_result_seq if needed or not used.
-                                        // The save_result_seq in common.c calculates makespan.
-
-    printf("Makespan: %d\n", makespan);
-    printf("Time taken: %f seconds\n", time_taken);
-    fflush(stdout); // Ensure output is flushed, especially if redirecting
-
-    return 0;
-}
-
-// Note: OneMachineOpInfo struct definition was missing from the provided snippet.
-// Assuming it's defined as:
-/*
-typedef struct { 
-    int job_idx; 
-    int op_idx_in_job; 
-    int op_node_id; 
-    int r_time;  // Release time (EST)
-    int p_time;  // Processing time
-    int q_time_val; // Tail time (longest path to sink)
-} OneMachineOpInfo;
-*/
-// This should ideally be defined globally or passed around if it's used by multiple functions.
-// For this parallel version, it's used locally within the parallel region's scope.
-// MOVED TO jobshop_common.h
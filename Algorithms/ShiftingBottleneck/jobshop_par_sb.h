@@ -0,0 +1,14 @@
+// jobshop_par_sb.h
+// Entry point of the OpenMP Shifting Bottleneck. Reentrant: all graph state lives in the
+// SBWorkspace passed in, so several schedules can be built concurrently.
+#ifndef JOBSHOP_PAR_SB_H
+#define JOBSHOP_PAR_SB_H
+
+#include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_incumbent.h"
+#include "jobshop_seq_sb.h"
+
+int shifting_bottleneck_schedule_par(Shop *shop, SBWorkspace *ws, int num_threads, Incumbent *inc,
+                                     const int *mach_release);
+
+#endif // JOBSHOP_PAR_SB_H
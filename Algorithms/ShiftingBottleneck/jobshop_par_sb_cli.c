@@ -0,0 +1,95 @@
+// jobshop_par_sb_cli.c
+// Command-line front end of the OpenMP Shifting Bottleneck (libjobshop)
+
+#include "../../Library/jobshop_solver.h"
+#include "../../Library/jobshop_batch.h"
+#include "../../Library/jobshop_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char *argv[]) {
+    if (argc == 4 && strcmp(argv[1], "--batch") == 0) { // Many instances and repetitions in one process
+        return jobshop_batch_run(argv[2], argv[3], JOBSHOP_ALGO_SB_PAR);
+    }
+    char *stats_file = take_option_value(&argc, argv, "--stats"); // Counters of the solve as JSON
+    int left_shift = !take_option_flag(&argc, argv, "--no-left-shift"); // Keep the raw SB schedule
+    char *affinity = take_option_value(&argc, argv, "--affinity"); // Pin the threads
+    int replicate = take_option_flag(&argc, argv, "--replicate"); // Instance copy per NUMA node
+    int use_cache = !take_option_flag(&argc, argv, "--no-cache"); // Always solve, bypassing the solution cache
+    if (argc < 4) { // Expect input_file, output_file, num_threads
+        fprintf(stderr, "Usage: %s <input_file> <output_file> <num_threads|auto> [--stats <stats.json>] [--no-left-shift]\n", argv[0]);
+        fprintf(stderr, "                [--affinity <compact|scatter|cpu_list>] [--replicate] [--no-cache]\n");
+        fprintf(stderr, "  auto: size every iteration's team from its work (thresholds from jobshop_calibrate)\n");
+        fprintf(stderr, "  --affinity: compact fills one NUMA node before the next, scatter deals the threads\n");
+        fprintf(stderr, "              round-robin over the nodes, a list such as 0,2,4-7 pins thread i to entry i\n");
+        fprintf(stderr, "  --replicate: give every NUMA node its own copy of the instance\n");
+        fprintf(stderr, "  --no-cache: solve even when %s holds the answer\n", jobshop_cache_dir());
+        fprintf(stderr, "       %s --batch <manifest> <results.csv|results.json>\n", argv[0]);
+        return 1;
+    }
+    char *input_file = argv[1];
+    char *output_file = argv[2];
+    int num_threads = jobshop_threads_from_arg(argv[3]);
+
+    if (num_threads < 0) {
+        fprintf(stderr, "Number of threads must be positive or auto.\n");
+        return 1;
+    }
+
+    JobshopSolver *solver = jobshop_solver_create();
+    if (!solver) {
+        fprintf(stderr, "Out of memory creating the solver.\n");
+        return 1;
+    }
+    if (!jobshop_solver_load(solver, input_file)) {
+        fprintf(stderr, "Error loading problem from %s\n", input_file);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+
+    JobshopOptions opt;
+    JobshopResult result;
+    jobshop_options_init(&opt);
+    opt.algorithm = JOBSHOP_ALGO_SB_PAR;
+    opt.threads = num_threads;
+    opt.left_shift = left_shift;
+    opt.cache_dir = use_cache ? jobshop_cache_dir() : NULL;
+    opt.cache_max_mb = jobshop_cache_max_mb();
+    opt.placement.replicate = replicate;
+    if (affinity && !parallel_placement_parse(affinity, &opt.placement)) {
+        fprintf(stderr, "Invalid --affinity %s: expected compact, scatter, none or a processor list.\n", affinity);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+    if (parallel_placement_active(&opt.placement)) {
+        printf("Thread placement: %s over %d NUMA node(s)%s\n", affinity ? affinity : "none", parallel_numa_nodes(),
+               replicate ? ", instance replicated per node" : "");
+    }
+    int solved = jobshop_solver_solve(solver, &opt, &result);
+    if (solved && result.cached) printf("Solution cache: hit in %s\n", opt.cache_dir);
+    if (stats_file) {
+        if (jobshop_result_save_stats(&result, &opt, input_file, stats_file)) printf("Statistics saved to %s\n", stats_file);
+        else fprintf(stderr, "Error: Could not write statistics to %s\n", stats_file);
+    }
+    if (!solved) {
+        printf("No jobs or operations found in the input file.\n");
+        jobshop_solver_destroy(solver);
+        return 0;
+    }
+
+    if (!jobshop_solver_save_result(solver, output_file)) {
+        fprintf(stderr, "Error: Could not open output file %s for writing.\n", output_file);
+    }
+
+    printf("Makespan: %d\n", result.makespan);
+    bounds_print(&result.bounds, result.makespan);
+    if (opt.left_shift && !result.cached) {
+        printf("Left shift: makespan reduced by %ld in %ld sweep(s)\n", result.stats.left_shift_gain, result.stats.left_shift_sweeps);
+    }
+    printf("Time taken: %f seconds\n", result.seconds);
+    fflush(stdout); // Ensure output is flushed, especially if redirecting
+
+    jobshop_solver_destroy(solver);
+    return 0;
+}
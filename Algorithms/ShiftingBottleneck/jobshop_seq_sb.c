@@ -1,110 +1,275 @@
 // jobshop_seq_sb.c
 // Sequential job shop scheduler using Shifting Bottleneck heuristic
+// Engine only: the jobshop_seq_sb executable is the thin CLI in jobshop_seq_sb_cli.c
 
 #include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_trace.h"
+#include "jobshop_seq_sb.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
-#include <sys/stat.h> // For mkdir on POSIX
-#include <time.h>     // For timing
 
-#ifdef _WIN32
-#include <direct.h> // For _mkdir on Windows
-#endif
+// Helper to add an edge to an adjacency matrix (row-major, ws->nodes columns)
+static void add_graph_edge(unsigned char *matrix, int num_nodes, int src, int dest) {
+    matrix[(size_t)src * num_nodes + dest] = 1;
+}
 
-#define MAX_TOTAL_OPS (JMAX * OPMAX)
-#define MAX_GRAPH_NODES (MAX_TOTAL_OPS + 2) // +2 for Source and Sink
+// Helper to clear an adjacency matrix
+static void clear_graph_matrix(unsigned char *matrix, int num_nodes) {
+    memset(matrix, 0, (size_t)num_nodes * num_nodes);
+}
 
-// Adjacency matrix representation for the graph
-static int adj[MAX_GRAPH_NODES][MAX_GRAPH_NODES];
-static int rev_adj[MAX_GRAPH_NODES][MAX_GRAPH_NODES];
-static int node_proc_times[MAX_GRAPH_NODES];
-static int est[MAX_GRAPH_NODES];
-static int tail_q[MAX_GRAPH_NODES];
+// Allocate the graph for a problem with num_ops operations. The matrices are sized to
+// the problem instead of JMAX * OPMAX, so small problems (e.g. horizons) stay small.
+SBWorkspace *sb_workspace_create(int num_ops) {
+    SBWorkspace *ws = (SBWorkspace*)calloc(1, sizeof(SBWorkspace));
+    if (!ws) return NULL;
+    ws->nodes = num_ops + 2;
+    size_t n = (size_t)ws->nodes;
+    ws->adj = (unsigned char*)malloc(n * n);
+    ws->reach = reach_create(ws->nodes);
+    ws->node_proc_times = (int*)malloc(sizeof(int) * n);
+    ws->est = (int*)malloc(sizeof(int) * n);
+    ws->tail_q = (int*)malloc(sizeof(int) * n);
+    ws->min_start = (int*)malloc(sizeof(int) * n);
+    ws->in_degree = (int*)malloc(sizeof(int) * n);
+    ws->queue = (int*)malloc(sizeof(int) * n);
+    ws->level_start = (int*)malloc(sizeof(int) * (n + 1));
+    ws->succ_start = (int*)malloc(sizeof(int) * (n + 1));
+    ws->pred_start = (int*)malloc(sizeof(int) * (n + 1));
+    ws->timelines = (ShopTimeline*)malloc(sizeof(ShopTimeline) * MMAX);
+    if (ws->timelines) {
+        for (int m = 0; m < MMAX; m++) timeline_init(&ws->timelines[m]);
+    }
+    if (!ws->adj || !ws->reach || !ws->node_proc_times || !ws->est || !ws->tail_q ||
+        !ws->min_start || !ws->in_degree || !ws->queue || !ws->level_start || !ws->succ_start ||
+        !ws->pred_start || !ws->timelines) {
+        sb_workspace_free(ws);
+        return NULL;
+    }
+    return ws;
+}
 
-// Helper to add an edge to an adjacency matrix
-typedef int (*GraphMatrix)[MAX_GRAPH_NODES];
-void add_graph_edge(GraphMatrix matrix, int src, int dest) {
-    matrix[src][dest] = 1;
+void sb_workspace_free(SBWorkspace *ws) {
+    if (!ws) return;
+    free(ws->adj);
+    reach_free(ws->reach);
+    free(ws->node_proc_times);
+    free(ws->est);
+    free(ws->tail_q);
+    free(ws->min_start);
+    free(ws->in_degree);
+    free(ws->queue);
+    free(ws->level_start);
+    free(ws->succ_start);
+    free(ws->succ);
+    free(ws->pred_start);
+    free(ws->pred);
+    if (ws->timelines) {
+        for (int m = 0; m < MMAX; m++) timeline_free(&ws->timelines[m]);
+        free(ws->timelines);
+    }
+    free(ws);
 }
 
-// Helper to clear an adjacency matrix
-void clear_graph_matrix(GraphMatrix matrix, int num_nodes) {
-    for (int i = 0; i < num_nodes; ++i) {
-        for (int j = 0; j < num_nodes; ++j) {
-            matrix[i][j] = 0;
-        }
+// Empty machine timelines for the final list schedule: each machine is busy before its
+// release time (mach_release, optional) and during the workspace's downtime windows.
+// Returns 0 when out of memory.
+int sb_prepare_timelines(const Shop *shop, SBWorkspace *ws, const int *mach_release) {
+    for (int m = 0; m < shop->nmachs; m++) {
+        timeline_clear(&ws->timelines[m]);
+        if (mach_release && mach_release[m] > 0 && !timeline_block(&ws->timelines[m], 0, mach_release[m])) return 0;
+    }
+    for (int w = 0; w < ws->nwindows; w++) {
+        const TimelineWindow *win = &ws->windows[w];
+        if (win->mach < 0 || win->mach >= shop->nmachs) continue;
+        if (!timeline_block(&ws->timelines[win->mach], win->start, win->end)) return 0;
+    }
+    return 1;
+}
+
+// Empty the graph (adjacency matrix and closure) for num_nodes nodes
+void sb_clear_graph(SBWorkspace *ws, int num_nodes) {
+    clear_graph_matrix(ws->adj, num_nodes);
+    reach_clear(ws->reach, num_nodes);
+}
+
+// Add src -> dest to the graph unless it would close a cycle. Returns 1 when the arc holds.
+int sb_add_arc(SBWorkspace *ws, int num_nodes, int src, int dest) {
+    if (!reach_add_arc(ws->reach, src, dest)) return 0;
+    add_graph_edge(ws->adj, num_nodes, src, dest);
+    return 1;
+}
+
+// Fix a machine sequence in the graph. The heads order it, and an operation can only
+// reach one with an equal head through zero-length operations; then the order is repaired
+// against the closure before it is chained, so every arc goes in and no head is left stale.
+void sb_commit_sequence(SBWorkspace *ws, int num_nodes, int *seq, int len) {
+    if (reach_order_sequence(ws->reach, seq, len) > 0 && ws->stats) ws->stats->sb_sequence_repairs++;
+    for (int i = 0; i < len - 1; ++i) {
+        if (seq[i] < 1 || seq[i] >= num_nodes - 1 || seq[i + 1] < 1 || seq[i + 1] >= num_nodes - 1) continue;
+        sb_add_arc(ws, num_nodes, seq[i], seq[i + 1]);
     }
 }
 
 // Helper to convert (job, op_idx_in_job) to a graph node index
-int op_to_node_idx(int job_idx, int op_idx_in_job, int ops_per_job_param) {
+static int op_to_node_idx(int job_idx, int op_idx_in_job, int ops_per_job_param) {
     return 1 + job_idx * ops_per_job_param + op_idx_in_job;
 }
 
-// Calculate Earliest Start Times (EST) for all nodes in a DAG using adjacency matrix
-void calculate_est_AON(int source_node_idx, int num_total_nodes, GraphMatrix matrix,
-                       int current_node_proc_times[], int result_est[]) {
-    for (int i = 0; i < num_total_nodes; i++) {
-        result_est[i] = 0;
+// Heads and tails of both versions run on a level graph of adj: the successor and predecessor
+// lists, and the nodes grouped by topological level (one more than the deepest predecessor's),
+// so every node of a level can be relaxed at once. Building it is the only pass over the
+// nodes x nodes matrix; the levels are then relaxed heads first to last level and tails last
+// to first. max_threads is 1 for the sequential version; the parallel one passes its thread
+// count and each pass sizes its team from the graph (parallel_team_size), with a barrier
+// between levels. Both versions thus run the same algorithm and differ only in team size.
+#define LEVEL_SCAN_BYTES 64     // Matrix bytes per work unit of the row scan (memchr)
+
+// Successors of one matrix row (arcs are stored as 1): written to out when given, counted
+static int row_successors(const unsigned char *row, int num_nodes, int *out) {
+    int count = 0;
+    const unsigned char *p = row, *end = row + num_nodes;
+    while (p < end && (p = (const unsigned char*)memchr(p, 1, (size_t)(end - p))) != NULL) {
+        if (out) out[count] = (int)(p - row);
+        count++;
+        p++;
     }
-    int in_degree[MAX_GRAPH_NODES] = {0};
-    for (int u = 0; u < num_total_nodes; ++u) {
-        for (int v = 0; v < num_total_nodes; ++v) {
-            if (matrix[u][v]) in_degree[v]++;
-        }
+    return count;
+}
+
+static int ensure_arc_capacity(SBWorkspace *ws, int arcs) {
+    if (arcs <= ws->arc_capacity) return 1;
+    int capacity = ws->arc_capacity > 0 ? ws->arc_capacity : 1024;
+    while (capacity < arcs) capacity *= 2;
+    int *succ = (int*)realloc(ws->succ, sizeof(int) * capacity);
+    if (!succ) return 0;
+    ws->succ = succ;
+    int *pred = (int*)realloc(ws->pred, sizeof(int) * capacity);
+    if (!pred) return 0;
+    ws->pred = pred;
+    ws->arc_capacity = capacity;
+    return 1;
+}
+
+// Level graph of the adj matrix of num_nodes nodes, its rows scanned by up to max_threads
+// threads. Returns the number of levels, -1 when out of memory.
+int sb_build_level_graph(SBWorkspace *ws, int num_nodes, int max_threads) {
+    const unsigned char *adj = ws->adj;
+    int *succ_start = ws->succ_start;
+    int *pred_start = ws->pred_start;
+    int team = parallel_team_size((double)num_nodes * (num_nodes / LEVEL_SCAN_BYTES + 1), max_threads);
+    succ_start[0] = 0;
+    #pragma omp parallel for num_threads(team) if(team > 1) schedule(static)
+    for (int u = 0; u < num_nodes; ++u) {
+        succ_start[u + 1] = row_successors(adj + (size_t)u * num_nodes, num_nodes, NULL);
     }
-    int queue[MAX_GRAPH_NODES];
-    int head = 0, tail_idx = 0;
-    for (int i = 0; i < num_total_nodes; ++i) {
-        if (in_degree[i] == 0) {
-            queue[tail_idx++] = i;
-        }
+    for (int u = 0; u < num_nodes; ++u) succ_start[u + 1] += succ_start[u];
+    int arcs = succ_start[num_nodes];
+    if (!ensure_arc_capacity(ws, arcs)) return -1;
+    int *succ = ws->succ;
+    #pragma omp parallel for num_threads(team) if(team > 1) schedule(static)
+    for (int u = 0; u < num_nodes; ++u) {
+        row_successors(adj + (size_t)u * num_nodes, num_nodes, succ + succ_start[u]);
+    }
+
+    // Predecessor lists and in-degrees from the successor lists: O(nodes + arcs)
+    int *in_degree = ws->in_degree;
+    int *pred = ws->pred;
+    for (int v = 0; v < num_nodes; ++v) in_degree[v] = 0;
+    for (int a = 0; a < arcs; ++a) in_degree[succ[a]]++;
+    pred_start[0] = 0;
+    for (int v = 0; v < num_nodes; ++v) pred_start[v + 1] = pred_start[v] + in_degree[v];
+    for (int u = 0; u < num_nodes; ++u) {
+        for (int a = succ_start[u]; a < succ_start[u + 1]; ++a) pred[pred_start[succ[a]] + --in_degree[succ[a]]] = u;
     }
-    result_est[source_node_idx] = 0;
+    for (int v = 0; v < num_nodes; ++v) in_degree[v] = pred_start[v + 1] - pred_start[v];
+
+    // Kahn's traversal one level at a time: the queue ends up in level order
+    int *queue = ws->queue;
+    int *level_start = ws->level_start;
+    int tail_idx = 0, levels = 0;
+    for (int v = 0; v < num_nodes; ++v) {
+        if (in_degree[v] == 0) queue[tail_idx++] = v;
+    }
+    int head = 0;
     while (head < tail_idx) {
-        int u = queue[head++];
-        for (int v = 0; v < num_total_nodes; ++v) {
-            if (matrix[u][v]) {
-                if (result_est[v] < result_est[u] + current_node_proc_times[u]) {
-                    result_est[v] = result_est[u] + current_node_proc_times[u];
-                }
-                in_degree[v]--;
-                if (in_degree[v] == 0) {
-                    queue[tail_idx++] = v;
-                }
+        level_start[levels++] = head;
+        int level_end = tail_idx;
+        for (; head < level_end; ++head) {
+            int u = queue[head];
+            for (int a = succ_start[u]; a < succ_start[u + 1]; ++a) {
+                if (--in_degree[succ[a]] == 0) queue[tail_idx++] = succ[a];
+            }
+        }
+    }
+    level_start[levels] = tail_idx; // Nodes on a cycle (none: sb_add_arc refuses them) stay out
+    return levels;
+}
+
+// Longest path to every node of the level graph (heads, forward) or from it (tails, backward,
+// the node's own time excluded). min_start (optional) gives a lower bound per node.
+// A level only reads the levels before it, so its nodes are independent of each other.
+void sb_level_longest_path(SBWorkspace *ws, int num_nodes, int levels, int forward, const int node_proc_times[],
+                           const int min_start[], int result[], int max_threads) {
+    const int *order = ws->queue;
+    const int *level_start = ws->level_start;
+    const int *start = forward ? ws->pred_start : ws->succ_start;
+    const int *arcs = forward ? ws->pred : ws->succ;
+    if (ws->stats) ws->stats->longest_path_runs++;
+    for (int i = 0; i < num_nodes; i++) result[i] = min_start ? min_start[i] : 0;
+    int team = parallel_team_size((double)num_nodes + start[num_nodes], max_threads);
+    #pragma omp parallel num_threads(team) if(team > 1)
+    for (int step = 0; step < levels; ++step) {
+        int level = forward ? step : levels - 1 - step;
+        #pragma omp for schedule(static)
+        for (int i = level_start[level]; i < level_start[level + 1]; ++i) {
+            int v = order[i];
+            int best = result[v];
+            for (int a = start[v]; a < start[v + 1]; ++a) {
+                int u = arcs[a];
+                if (best < result[u] + node_proc_times[u]) best = result[u] + node_proc_times[u];
             }
+            result[v] = best;
         }
     }
 }
 
 // Main Shifting Bottleneck scheduling logic - Sequential Version
-void shifting_bottleneck_schedule(Shop *shop) {
+// job_release / mach_release (both optional) give the earliest start of each job and the
+// time each machine becomes available, as needed when scheduling one horizon after another.
+// Returns 1 on success, 0 if the problem does not fit the workspace.
+int shifting_bottleneck_schedule_ws(Shop *shop, SBWorkspace *ws, const int *job_release, const int *mach_release) {
     int njobs = shop->njobs;
     int nops_per_job = shop->nops;
     if (njobs == 0 || nops_per_job == 0) {
         fprintf(stderr, "No jobs or operations to schedule.\n");
-        return;
+        return 0;
     }
     if (njobs > JMAX || nops_per_job > OPMAX) {
         fprintf(stderr, "Problem size exceeds defined limits (JMAX/OPMAX).\n");
-        return;
+        return 0;
     }
     int num_ops_total = njobs * nops_per_job;
     int source_node = 0;
     int sink_node = num_ops_total + 1;
     int num_graph_nodes = num_ops_total + 2;
-    if (num_graph_nodes > MAX_GRAPH_NODES) {
-        fprintf(stderr, "Calculated graph nodes %d exceeds MAX_GRAPH_NODES %d\n", num_graph_nodes, MAX_GRAPH_NODES);
-        return;
+    if (num_graph_nodes > ws->nodes) {
+        fprintf(stderr, "Calculated graph nodes %d exceeds workspace size %d\n", num_graph_nodes, ws->nodes);
+        return 0;
     }
-    clear_graph_matrix(adj, num_graph_nodes);
-    clear_graph_matrix(rev_adj, num_graph_nodes);
+    int *node_proc_times = ws->node_proc_times;
+    int *est = ws->est;
+    int *tail_q = ws->tail_q;
+    int *min_start = ws->min_start;
+    SolverStats *stats = ws->stats;
+    sb_clear_graph(ws, num_graph_nodes);
     for (int i = 0; i < num_graph_nodes; ++i) {
         node_proc_times[i] = 0;
         est[i] = 0;
         tail_q[i] = 0;
+        min_start[i] = 0;
     }
     node_proc_times[source_node] = 0;
     node_proc_times[sink_node] = 0;
@@ -114,16 +279,22 @@ void shifting_bottleneck_schedule(Shop *shop) {
             int current_op_node = op_to_node_idx(j, o, nops_per_job);
             if (current_op_node < 1 || current_op_node > num_ops_total) continue;
             node_proc_times[current_op_node] = shop->plan[j][o].len;
+            if (o == 0 && job_release) {
+                min_start[current_op_node] = job_release[j];
+            }
+            if (mach_release && mach_release[shop->plan[j][o].mach] > min_start[current_op_node]) {
+                min_start[current_op_node] = mach_release[shop->plan[j][o].mach];
+            }
             if (o == 0) {
-                add_graph_edge(adj, source_node, current_op_node);
+                sb_add_arc(ws, num_graph_nodes, source_node, current_op_node);
             }
             if (o < nops_per_job - 1) {
                 int next_op_node = op_to_node_idx(j, o + 1, nops_per_job);
                 if (next_op_node < 1 || next_op_node > num_ops_total) continue;
-                add_graph_edge(adj, current_op_node, next_op_node);
+                sb_add_arc(ws, num_graph_nodes, current_op_node, next_op_node);
             }
             if (o == nops_per_job - 1) {
-                add_graph_edge(adj, current_op_node, sink_node);
+                sb_add_arc(ws, num_graph_nodes, current_op_node, sink_node);
             }
         }
     }
@@ -132,28 +303,35 @@ void shifting_bottleneck_schedule(Shop *shop) {
     int num_sequenced_machines_count = 0;
     int best_sequence_for_bottleneck_machine[JMAX];
     while (num_sequenced_machines_count < shop->nmachs) {
-        calculate_est_AON(source_node, num_graph_nodes, adj, node_proc_times, est);
-        clear_graph_matrix(rev_adj, num_graph_nodes);
-        for (int u_node = 0; u_node < num_graph_nodes; ++u_node) {
-            for (int v_node = 0; v_node < num_graph_nodes; ++v_node) {
-                if (adj[u_node][v_node]) {
-                    add_graph_edge(rev_adj, v_node, u_node);
-                }
-            }
+        double phase_start = stats_clock(stats);
+        TRACE_BEGIN("sb_est");
+        int levels = sb_build_level_graph(ws, num_graph_nodes, 1);
+        if (levels < 0) {
+            fprintf(stderr, "Out of memory for the level graph.\n");
+            TRACE_END("sb_est");
+            return 0;
         }
-        calculate_est_AON(sink_node, num_graph_nodes, rev_adj, node_proc_times, tail_q);
+        TRACE_COUNTER("sb_levels", levels);
+        sb_level_longest_path(ws, num_graph_nodes, levels, 1, node_proc_times, min_start, est, 1);
+        TRACE_END("sb_est");
+        phase_start = stats_phase(stats, STATS_PHASE_SB_EST, phase_start);
+        TRACE_BEGIN("sb_tail");
+        sb_level_longest_path(ws, num_graph_nodes, levels, 0, node_proc_times, NULL, tail_q, 1);
+        TRACE_END("sb_tail");
+        phase_start = stats_phase(stats, STATS_PHASE_SB_TAIL, phase_start);
         int overall_best_machine_idx = -1;
         long long overall_max_bottleneck_metric = -1;
         int overall_best_seq_len = 0;
         OneMachineOpInfo machine_ops_buffer[JMAX];
         int current_sequence_nodes_buffer[JMAX];
         // Evaluate all unsequenced machines
+        TRACE_BEGIN("sb_machine_eval");
         for (int m_idx = 0; m_idx < shop->nmachs; ++m_idx) {
             if (sequenced_machines_flags[m_idx]) continue;
             int num_ops_on_this_machine = 0;
             for (int j = 0; j < njobs; ++j) {
                 for (int o = 0; o < nops_per_job; ++o) {
-                    if (shop->plan[j][o].mach == m_idx + 1) {
+                    if (shop->plan[j][o].mach == m_idx) {
                         if (num_ops_on_this_machine >= JMAX) break;
                         int op_node = op_to_node_idx(j, o, nops_per_job);
                         if (op_node < 1 || op_node > num_ops_total) continue;
@@ -199,23 +377,28 @@ void shifting_bottleneck_schedule(Shop *shop) {
                 }
             }
         }
+        TRACE_END("sb_machine_eval");
+        phase_start = stats_phase(stats, STATS_PHASE_SB_MACHINE_EVAL, phase_start);
         if (overall_best_machine_idx == -1) {
             break;
         }
-        for (int i = 0; i < overall_best_seq_len - 1; ++i) {
-            int u_node = best_sequence_for_bottleneck_machine[i];
-            int v_node = best_sequence_for_bottleneck_machine[i + 1];
-            if (u_node < 1 || u_node > num_ops_total || v_node < 1 || v_node > num_ops_total) continue;
-            add_graph_edge(adj, u_node, v_node);
-        }
+        TRACE_BEGIN("sb_commit");
+        sb_commit_sequence(ws, num_graph_nodes, best_sequence_for_bottleneck_machine, overall_best_seq_len);
         sequenced_machines_flags[overall_best_machine_idx] = 1;
         num_sequenced_machines_count++;
+        TRACE_END("sb_commit");
+        stats_phase(stats, STATS_PHASE_SB_COMMIT, phase_start);
+        if (stats) stats->sb_iterations++;
     }
-    calculate_est_AON(source_node, num_graph_nodes, adj, node_proc_times, est);
-    int machine_available_time[MMAX];
-    for (int m = 0; m < shop->nmachs; m++) {
-        machine_available_time[m] = 0;
+    double final_start = stats_clock(stats);
+    TRACE_BEGIN("sb_final_schedule");
+    int final_levels = sb_build_level_graph(ws, num_graph_nodes, 1);
+    if (final_levels < 0) {
+        fprintf(stderr, "Out of memory for the level graph.\n");
+        TRACE_END("sb_final_schedule");
+        return 0;
     }
+    sb_level_longest_path(ws, num_graph_nodes, final_levels, 1, node_proc_times, min_start, est, 1);
     typedef struct {
         int job;
         int op;
@@ -223,7 +406,13 @@ void shifting_bottleneck_schedule(Shop *shop) {
         int machine;
         int duration;
     } OpScheduleInfo;
-    OpScheduleInfo op_list[MAX_TOTAL_OPS];
+    OpScheduleInfo *op_list = (OpScheduleInfo*)malloc(sizeof(OpScheduleInfo) * num_ops_total);
+    if (!op_list || !sb_prepare_timelines(shop, ws, mach_release)) {
+        free(op_list);
+        fprintf(stderr, "Out of memory for the final scheduling pass.\n");
+        TRACE_END("sb_final_schedule");
+        return 0;
+    }
     int op_count = 0;
     for (int j = 0; j < njobs; ++j) {
         for (int o = 0; o < nops_per_job; ++o) {
@@ -232,7 +421,7 @@ void shifting_bottleneck_schedule(Shop *shop) {
             op_list[op_count].job = j;
             op_list[op_count].op = o;
             op_list[op_count].est_time = est[op_node];
-            op_list[op_count].machine = shop->plan[j][o].mach - 1;
+            op_list[op_count].machine = shop->plan[j][o].mach;
             op_list[op_count].duration = shop->plan[j][o].len;
             op_count++;
         }
@@ -260,92 +449,24 @@ void shifting_bottleneck_schedule(Shop *shop) {
                 earliest_start = prev_end_time;
             }
         }
-        if (earliest_start < machine_available_time[machine_idx]) {
-            earliest_start = machine_available_time[machine_idx];
-        }
+        // Earliest idle slot on the machine, possibly in a gap left by earlier placements
+        earliest_start = timeline_earliest(&ws->timelines[machine_idx], earliest_start, duration);
+        timeline_insert(&ws->timelines[machine_idx], earliest_start, earliest_start + duration);
         shop->plan[j][o].stime = earliest_start;
-        machine_available_time[machine_idx] = earliest_start + duration;
     }
+    free(op_list);
+    TRACE_END("sb_final_schedule");
+    stats_phase(stats, STATS_PHASE_SB_FINAL, final_start);
+    return 1;
 }
 
-int main(int argc, char *argv[]) {
-    if (argc < 3) {
-        fprintf(stderr, "Usage: %s <problem_file> <output_file>\n", argv[0]);
-        fprintf(stderr, "Example: .\\jobshop_seq_sb.exe ..\\..\\Data\\1_Small_sample.jss result.txt\n");
-        return 1;
-    }
-    char *problem_file = argv[1];
-    char *output_file = argv[2];
-
-    Shop shop_instance;
-    memset(&shop_instance, 0, sizeof(Shop));
-
-    if (!load_problem_seq(problem_file, &shop_instance)) {
-        fprintf(stderr, "Error loading problem from %s\n", problem_file);
-        return 1;
-    }
-
-    char *basename = extract_basename(problem_file);
-    if (!basename) {
-        fprintf(stderr, "Error extracting basename from %s. Using 'unknown'.\n", problem_file);
-        basename = strdup("unknown"); // Remember to free this
-        if (!basename) {
-            fprintf(stderr, "strdup failed for basename fallback.\n");
-            return 1;
-        }
-    }
-
-    printf("Starting Sequential Shifting Bottleneck for %s...\n", basename);
-
-    // Timing
-    clock_t start_time = clock();
-
-    shifting_bottleneck_schedule(&shop_instance);
-
-    clock_t end_time = clock();
-    double time_taken = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
-
-    printf("Sequential Shifting Bottleneck finished for %s.\n", basename);
-
-    // Calculate makespan
-    int makespan = 0;
-    for (int j = 0; j < shop_instance.njobs; j++) {
-        for (int o = 0; o < shop_instance.nops; o++) {
-            int end_op_time = shop_instance.plan[j][o].stime + shop_instance.plan[j][o].len;
-            if (end_op_time > makespan) {
-                makespan = end_op_time;
-            }
-        }
-    }
-
-    // Create directory for output file if it doesn't exist
-    char *last_slash = strrchr(output_file, '/');
-#ifdef _WIN32
-    char *last_backslash = strrchr(output_file, '\\');
-    if (last_backslash > last_slash) last_slash = last_backslash;
-#endif
-
-    if (last_slash != NULL) {
-        char dir_path[256];
-        strncpy(dir_path, output_file, last_slash - output_file);
-        dir_path[last_slash - output_file] = '\0';
-
-        struct stat st = {0};
-        if (stat(dir_path, &st) == -1) {
-#ifdef _WIN32
-            _mkdir(dir_path); // For Windows
-#else
-            mkdir(dir_path, 0777); // For POSIX
-#endif
-        }
+// Schedule a whole problem on its own workspace
+void shifting_bottleneck_schedule(Shop *shop) {
+    SBWorkspace *ws = sb_workspace_create(shop->njobs * shop->nops);
+    if (!ws) {
+        fprintf(stderr, "Out of memory allocating the disjunctive graph.\n");
+        return;
     }
-
-    save_result_seq(output_file, &shop_instance);
-    printf("Results saved to %s\n", output_file);
-    printf("Makespan: %d\n", makespan);
-    printf("Time taken: %f seconds\n", time_taken);
-    fflush(stdout); // Ensure output is flushed
-
-    if (basename) free(basename);
-    return 0;
+    shifting_bottleneck_schedule_ws(shop, ws, NULL, NULL);
+    sb_workspace_free(ws);
 }
@@ -0,0 +1,49 @@
+// jobshop_seq_sb.h
+// Entry points of the sequential Shifting Bottleneck. Reentrant: all graph state lives in
+// the SBWorkspace, which the parallel version (jobshop_par_sb.h) uses as well.
+#ifndef JOBSHOP_SEQ_SB_H
+#define JOBSHOP_SEQ_SB_H
+
+#include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_stats.h"
+#include "../../Common/jobshop_timeline.h"
+#include "../../Common/jobshop_parallel.h"
+#include "../../Common/jobshop_reach.h"
+
+// Disjunctive graph of one SB run. Each thread needs its own workspace.
+typedef struct {
+    int nodes;                  // Operations + source + sink
+    unsigned char *adj;         // nodes x nodes, row-major
+    ReachGraph *reach;          // Closure of adj: arcs are checked for cycles before they go in
+    int *node_proc_times;
+    int *est;
+    int *tail_q;
+    int *min_start;             // Release lower bound per node
+    int *in_degree;             // Scratch for the longest path passes
+    int *queue;
+    int *level_start;           // Level graph of the longest paths: queue in level order, nodes+1 offsets
+    int *succ_start;            // Successor lists of adj (nodes+1 offsets into succ)
+    int *succ;
+    int *pred_start;            // Predecessor lists of adj (nodes+1 offsets into pred)
+    int *pred;
+    int arc_capacity;           // Entries of succ and pred, grown on demand
+    SolverStats *stats;         // Optional: iteration counts and phase times of the next runs
+    ShopTimeline *timelines;    // MMAX machines, for the final list schedule
+    const TimelineWindow *windows; // Optional: machine downtime the final schedule keeps free
+    int nwindows;
+    const ParallelPlacement *placement; // Optional: thread pinning and instance replicas of the parallel version
+} SBWorkspace;
+
+SBWorkspace *sb_workspace_create(int num_ops);
+void sb_workspace_free(SBWorkspace *ws);
+int sb_prepare_timelines(const Shop *shop, SBWorkspace *ws, const int *mach_release);
+void sb_clear_graph(SBWorkspace *ws, int num_nodes);
+int sb_add_arc(SBWorkspace *ws, int num_nodes, int src, int dest);
+void sb_commit_sequence(SBWorkspace *ws, int num_nodes, int *seq, int len);
+int sb_build_level_graph(SBWorkspace *ws, int num_nodes, int max_threads);
+void sb_level_longest_path(SBWorkspace *ws, int num_nodes, int levels, int forward, const int node_proc_times[],
+                           const int min_start[], int result[], int max_threads);
+int shifting_bottleneck_schedule_ws(Shop *shop, SBWorkspace *ws, const int *job_release, const int *mach_release);
+void shifting_bottleneck_schedule(Shop *shop);
+
+#endif // JOBSHOP_SEQ_SB_H
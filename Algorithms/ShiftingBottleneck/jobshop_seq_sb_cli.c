@@ -0,0 +1,80 @@
+// jobshop_seq_sb_cli.c
+// Command-line front end of the sequential Shifting Bottleneck (libjobshop)
+
+#include "../../Library/jobshop_solver.h"
+#include "../../Library/jobshop_batch.h"
+#include "../../Library/jobshop_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char *argv[]) {
+    if (argc == 4 && strcmp(argv[1], "--batch") == 0) { // Many instances and repetitions in one process
+        return jobshop_batch_run(argv[2], argv[3], JOBSHOP_ALGO_SB_SEQ);
+    }
+    char *stats_file = take_option_value(&argc, argv, "--stats"); // Counters of the solve as JSON
+    int left_shift = !take_option_flag(&argc, argv, "--no-left-shift"); // Keep the raw SB schedule
+    int use_cache = !take_option_flag(&argc, argv, "--no-cache"); // Always solve, bypassing the solution cache
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <problem_file> <output_file> [--stats <stats.json>] [--no-left-shift] [--no-cache]\n", argv[0]);
+        fprintf(stderr, "       %s --batch <manifest> <results.csv|results.json>\n", argv[0]);
+        fprintf(stderr, "  --no-cache: solve even when %s holds the answer\n", jobshop_cache_dir());
+        fprintf(stderr, "Example: .\\jobshop_seq_sb.exe ..\\..\\Data\\1_Small_sample.jss result.txt\n");
+        return 1;
+    }
+    char *problem_file = argv[1];
+    char *output_file = argv[2];
+
+    JobshopSolver *solver = jobshop_solver_create();
+    if (!solver) {
+        fprintf(stderr, "Out of memory creating the solver.\n");
+        return 1;
+    }
+    if (!jobshop_solver_load(solver, problem_file)) {
+        fprintf(stderr, "Error loading problem from %s\n", problem_file);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+
+    char *basename = extract_basename(problem_file);
+    printf("Starting Sequential Shifting Bottleneck for %s...\n", basename ? basename : "unknown");
+
+    JobshopOptions opt;
+    JobshopResult result;
+    jobshop_options_init(&opt);
+    opt.algorithm = JOBSHOP_ALGO_SB_SEQ;
+    opt.left_shift = left_shift;
+    opt.cache_dir = use_cache ? jobshop_cache_dir() : NULL;
+    opt.cache_max_mb = jobshop_cache_max_mb();
+    int solved = jobshop_solver_solve(solver, &opt, &result);
+    if (solved && result.cached) printf("Solution cache: hit in %s\n", opt.cache_dir);
+    if (stats_file) {
+        if (jobshop_result_save_stats(&result, &opt, problem_file, stats_file)) printf("Statistics saved to %s\n", stats_file);
+        else fprintf(stderr, "Error: Could not write statistics to %s\n", stats_file);
+    }
+
+    printf("Sequential Shifting Bottleneck finished for %s.\n", basename ? basename : "unknown");
+    if (!solved) {
+        fprintf(stderr, "No schedule produced.\n");
+        if (basename) free(basename);
+        jobshop_solver_destroy(solver);
+        return 1;
+    }
+
+    if (jobshop_solver_save_result(solver, output_file)) {
+        printf("Results saved to %s\n", output_file);
+    } else {
+        fprintf(stderr, "Error: Could not open output file %s for writing.\n", output_file);
+    }
+    printf("Makespan: %d\n", result.makespan);
+    bounds_print(&result.bounds, result.makespan);
+    if (opt.left_shift && !result.cached) {
+        printf("Left shift: makespan reduced by %ld in %ld sweep(s)\n", result.stats.left_shift_gain, result.stats.left_shift_sweeps);
+    }
+    printf("Time taken: %f seconds\n", result.seconds);
+    fflush(stdout); // Ensure output is flushed
+
+    if (basename) free(basename);
+    jobshop_solver_destroy(solver);
+    return 0;
+}
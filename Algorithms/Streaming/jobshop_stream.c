@@ -0,0 +1,448 @@
+// jobshop_stream.c
+// Online scheduler: jobs arrive one per line on stdin, in the "machine duration" pair format
+// of the .jss files (without the header line). Every job is placed as soon as it arrives by
+// inserting its operations into the earliest idle gaps of the machine timelines, and the
+// assignment is written to stdout right away. A background worker periodically re-plans the
+// operations that have not started yet, trying several job orders in parallel (OpenMP), and
+// publishes the moved operations when the plan gets better. Per-job latency percentiles are
+// reported on stderr at the end of the stream.
+//
+// Output lines:  J <job> <start_0> ... <start_k>   placement of an arriving job
+//                U <job> <op> <start>               operation moved by a re-optimization
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // nanosleep under -std=c99
+#endif
+
+#include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_timeline.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <omp.h>
+
+#define LINE_CHARS 65536
+#define DEFAULT_REOPT_INTERVAL_MS 200
+#define MIN_CANDIDATES 4           // Job orders tried per re-optimization round
+
+// Everything below is guarded by state_lock
+static int nmachs;
+static Step *ops;                  // All operations, job j owns [job_first[j], job_first[j] + job_nops[j])
+static int total_ops, ops_cap;
+static int *job_first, *job_nops, *job_release;
+static int njobs, jobs_cap;
+static ShopTimeline timelines[MMAX];
+static int makespan;
+static long long total_completion;
+static unsigned long version;      // Bumped on every change of the schedule
+static omp_lock_t state_lock;
+
+static volatile int input_done = 0;
+static double stream_start;
+static double time_scale;          // Schedule time units per wall-clock second, 0 = clock stopped
+static int reopt_interval_ms;
+static long reopt_rounds, reopt_improvements, ops_moved;
+
+static void sleep_ms(int ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+#endif
+}
+
+static int schedule_now(void) {
+    return (int)((wall_time_seconds() - stream_start) * time_scale);
+}
+
+static int grow(void **buffer, int *cap, int needed, size_t item_size) {
+    if (needed <= *cap) return 1;
+    int new_cap = *cap > 0 ? *cap : 64;
+    while (new_cap < needed) new_cap *= 2;
+    void *grown = realloc(*buffer, item_size * new_cap);
+    if (!grown) return 0;
+    *buffer = grown;
+    *cap = new_cap;
+    return 1;
+}
+
+// Fill timelines with the given operations (all, or only those starting before 'before')
+static int build_timelines(ShopTimeline *tls, const Step *all, int count, int before) {
+    for (int m = 0; m < nmachs; m++) timeline_clear(&tls[m]);
+    for (int i = 0; i < count; i++) {
+        if (all[i].stime >= before) continue;
+        if (!timeline_append(&tls[all[i].mach], all[i].stime, all[i].stime + all[i].len)) return 0;
+    }
+    for (int m = 0; m < nmachs; m++) timeline_finish(&tls[m]);
+    return 1;
+}
+
+// Parse one job line into the operation store. Returns the job index, -1 if the line is
+// empty, -2 if it is malformed or memory ran out.
+static int append_job(const char *line) {
+    int first = total_ops, count = 0;
+    const char *p = line;
+    for (;;) {
+        char *end;
+        long mach = strtol(p, &end, 10);
+        if (end == p) break;
+        p = end;
+        long len = strtol(p, &end, 10);
+        if (end == p || mach < 0 || mach >= nmachs || len < 0) return -2;
+        p = end;
+        if (!grow((void**)&ops, &ops_cap, first + count + 1, sizeof(Step))) return -2;
+        ops[first + count].mach = (int)mach;
+        ops[first + count].len = (int)len;
+        ops[first + count].stime = -1;
+        count++;
+    }
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    if (*p != '\0') return -2;
+    if (count == 0) return -1;
+    if (njobs + 1 > jobs_cap) {
+        int new_cap = jobs_cap > 0 ? jobs_cap * 2 : 64;
+        int *f = (int*)realloc(job_first, sizeof(int) * new_cap);
+        if (f) job_first = f;
+        int *c = (int*)realloc(job_nops, sizeof(int) * new_cap);
+        if (c) job_nops = c;
+        int *r = (int*)realloc(job_release, sizeof(int) * new_cap);
+        if (r) job_release = r;
+        if (!f || !c || !r) return -2;
+        jobs_cap = new_cap;
+    }
+    job_first[njobs] = first;
+    job_nops[njobs] = count;
+    total_ops += count;
+    return njobs++;
+}
+
+// Place a freshly parsed job and emit its assignment (caller holds state_lock)
+static void place_arriving_job(int j) {
+    int now = schedule_now();
+    int ready = now;
+    job_release[j] = now;
+    printf("J %d", j);
+    for (int k = 0; k < job_nops[j]; k++) {
+        Step *st = &ops[job_first[j] + k];
+        st->stime = timeline_earliest(&timelines[st->mach], ready, st->len);
+        timeline_insert(&timelines[st->mach], st->stime, st->stime + st->len);
+        ready = st->stime + st->len;
+        printf(" %d", st->stime);
+    }
+    printf("\n");
+    fflush(stdout);
+    if (ready > makespan) makespan = ready;
+    total_completion += ready;
+    version++;
+}
+
+static int compare_keys(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Job order of candidate c: arrival order, most remaining work first, least remaining work
+// first, then random perturbations of the most-work-first order
+static void candidate_order(int c, unsigned int seed, const int *movable, int nmovable,
+                            const int *remaining, int *order) {
+    if (c == 0) {
+        memcpy(order, movable, sizeof(int) * nmovable);
+        return;
+    }
+    unsigned long long *keys = (unsigned long long*)malloc(sizeof(unsigned long long) * (nmovable > 0 ? nmovable : 1));
+    if (!keys) {
+        memcpy(order, movable, sizeof(int) * nmovable);
+        return;
+    }
+    for (int i = 0; i < nmovable; i++) {
+        unsigned int work = (unsigned int)remaining[i];
+        if (c != 2) work = UINT_MAX - work;
+        keys[i] = ((unsigned long long)work << 32) | (unsigned int)i;
+    }
+    qsort(keys, nmovable, sizeof(unsigned long long), compare_keys);
+    for (int i = 0; i < nmovable; i++) order[i] = movable[keys[i] & 0xffffffffu];
+    free(keys);
+    if (c >= 3) {
+        for (int s = 0; s < nmovable / 4 + 1 && nmovable > 1; s++) {
+            seed = seed * 1103515245u + 12345u;
+            int i = (int)((seed >> 8) % (unsigned int)(nmovable - 1));
+            int tmp = order[i];
+            order[i] = order[i + 1];
+            order[i + 1] = tmp;
+        }
+    }
+}
+
+// One background round: snapshot, re-plan the operations that start at or after the
+// freeze point with several job orders in parallel, publish the best if it improves
+static void reoptimize(int num_threads, int freeze_margin) {
+    omp_set_lock(&state_lock);
+    unsigned long snap_version = version;
+    int freeze = schedule_now() + freeze_margin;
+    int n = total_ops, nj = njobs, cur_makespan = makespan;
+    long long cur_total = total_completion;
+    Step *snap = (Step*)malloc(sizeof(Step) * (n > 0 ? n : 1));
+    int *first = (int*)malloc(sizeof(int) * (nj > 0 ? nj : 1));
+    int *count = (int*)malloc(sizeof(int) * (nj > 0 ? nj : 1));
+    int *release = (int*)malloc(sizeof(int) * (nj > 0 ? nj : 1));
+    if (snap && first && count && release) {
+        memcpy(snap, ops, sizeof(Step) * n);
+        memcpy(first, job_first, sizeof(int) * nj);
+        memcpy(count, job_nops, sizeof(int) * nj);
+        memcpy(release, job_release, sizeof(int) * nj);
+    }
+    omp_unset_lock(&state_lock);
+    if (!snap || !first || !count || !release || n == 0) {
+        free(snap); free(first); free(count); free(release);
+        return;
+    }
+
+    // Jobs with at least one operation that has not started by the freeze point
+    int *movable = (int*)malloc(sizeof(int) * nj);
+    int *remaining = (int*)malloc(sizeof(int) * nj);
+    int nmovable = 0;
+    for (int j = 0; movable && remaining && j < nj; j++) {
+        int work = 0;
+        for (int k = 0; k < count[j]; k++) {
+            if (snap[first[j] + k].stime >= freeze) work += snap[first[j] + k].len;
+        }
+        if (work > 0) {
+            movable[nmovable] = j;
+            remaining[nmovable++] = work;
+        }
+    }
+
+    int candidates = num_threads * 2 > MIN_CANDIDATES ? num_threads * 2 : MIN_CANDIDATES;
+    int best_c = -1, best_makespan = cur_makespan;
+    long long best_total = cur_total;
+    int **starts = (int**)calloc(candidates, sizeof(int*));
+    int *cand_makespan = (int*)malloc(sizeof(int) * candidates);
+    long long *cand_total = (long long*)malloc(sizeof(long long) * candidates);
+    if (movable && remaining && nmovable > 0 && starts && cand_makespan && cand_total) {
+        #pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+        for (int c = 0; c < candidates; c++) {
+            ShopTimeline tls[MMAX];
+            for (int m = 0; m < nmachs; m++) timeline_init(&tls[m]);
+            int *order = (int*)malloc(sizeof(int) * nmovable);
+            starts[c] = (int*)malloc(sizeof(int) * n);
+            cand_makespan[c] = INT_MAX;
+            if (order && starts[c] && build_timelines(tls, snap, n, freeze)) {
+                candidate_order(c, (unsigned int)(reopt_rounds * 7919 + c), movable, nmovable, remaining, order);
+                int ms = 0, ok = 1;
+                long long total = 0;
+                for (int i = 0; i < n; i++) starts[c][i] = snap[i].stime;
+                for (int j = 0; j < nj; j++) { // Completion of the fixed jobs
+                    int end = snap[first[j] + count[j] - 1].stime + snap[first[j] + count[j] - 1].len;
+                    if (snap[first[j] + count[j] - 1].stime < freeze) {
+                        if (end > ms) ms = end;
+                        total += end;
+                    }
+                }
+                for (int i = 0; i < nmovable && ok; i++) {
+                    int j = order[i], ready = release[j] > freeze ? release[j] : freeze;
+                    for (int k = 0; k < count[j]; k++) {
+                        const Step *st = &snap[first[j] + k];
+                        if (st->stime < freeze) {
+                            if (st->stime + st->len > ready) ready = st->stime + st->len;
+                            continue;
+                        }
+                        int s = timeline_earliest(&tls[st->mach], ready, st->len);
+                        ok = timeline_insert(&tls[st->mach], s, s + st->len);
+                        starts[c][first[j] + k] = s;
+                        ready = s + st->len;
+                    }
+                    if (ready > ms) ms = ready;
+                    total += ready;
+                }
+                if (ok) {
+                    cand_makespan[c] = ms;
+                    cand_total[c] = total;
+                }
+            }
+            for (int m = 0; m < nmachs; m++) timeline_free(&tls[m]);
+            free(order);
+        }
+        for (int c = 0; c < candidates; c++) {
+            if (cand_makespan[c] < best_makespan ||
+                (cand_makespan[c] == best_makespan && cand_total[c] < best_total)) {
+                best_c = c;
+                best_makespan = cand_makespan[c];
+                best_total = cand_total[c];
+            }
+        }
+    }
+
+    if (best_c >= 0) {
+        omp_set_lock(&state_lock);
+        // Publish only if no job arrived meanwhile and nothing we move has started since
+        int now = schedule_now(), valid = (version == snap_version);
+        for (int i = 0; valid && i < n; i++) {
+            if (starts[best_c][i] != ops[i].stime && (ops[i].stime < now || starts[best_c][i] < now)) valid = 0;
+        }
+        if (valid) {
+            for (int j = 0; j < nj; j++) {
+                for (int k = 0; k < count[j]; k++) {
+                    int i = first[j] + k;
+                    if (starts[best_c][i] == ops[i].stime) continue;
+                    ops[i].stime = starts[best_c][i];
+                    printf("U %d %d %d\n", j, k, ops[i].stime);
+                    ops_moved++;
+                }
+            }
+            fflush(stdout);
+            build_timelines(timelines, ops, total_ops, INT_MAX);
+            makespan = best_makespan;
+            total_completion = best_total;
+            version++;
+            reopt_improvements++;
+        }
+        omp_unset_lock(&state_lock);
+    }
+    reopt_rounds++;
+
+    if (starts) for (int c = 0; c < candidates; c++) free(starts[c]);
+    free(starts); free(cand_makespan); free(cand_total);
+    free(movable); free(remaining);
+    free(snap); free(first); free(count); free(release);
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(const double *sorted, int n, double p) {
+    if (n == 0) return 0.0;
+    int idx = (int)(p * (n - 1) + 0.5);
+    return sorted[idx];
+}
+
+static void save_stream_result(const char *filename) {
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        fprintf(stderr, "Error: Could not open output file %s for writing.\n", filename);
+        return;
+    }
+    int max_ops = 0;
+    for (int j = 0; j < njobs; j++) if (job_nops[j] > max_ops) max_ops = job_nops[j];
+    fprintf(file, "Number of jobs: %d\n", njobs);
+    fprintf(file, "Number of machines: %d\n", nmachs);
+    fprintf(file, "Number of operations per job: %d\n", max_ops);
+    fprintf(file, "Makespan: %d\n\n", makespan);
+    fprintf(file, "Job Operations (Job, Operation, Machine, Duration, Start Time):\n");
+    for (int j = 0; j < njobs; j++) {
+        for (int k = 0; k < job_nops[j]; k++) {
+            Step *st = &ops[job_first[j] + k];
+            fprintf(file, "Job %d, Op %d: M%d, Len %d, Start %d\n", j, k, st->mach, st->len, st->stime);
+        }
+    }
+    fclose(file);
+    fprintf(stderr, "Results saved to %s\n", filename);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 6) {
+        printf("Usage: %s <num_machines> <num_threads> [reopt_interval_ms] [time_units_per_second] [output_file]\n", argv[0]);
+        printf("  Reads one job per line from stdin: <mach> <len> pairs, as in a .jss file without its header.\n");
+        printf("  time_units_per_second: how fast the schedule clock runs (default 0: the clock stands\n");
+        printf("  still, so every operation stays movable until the stream ends).\n");
+        printf("  Example: tail -n +2 ../../Data/4_XLarge_sample.jss | %s 20 4\n", argv[0]);
+        return 1;
+    }
+    nmachs = atoi(argv[1]);
+    int num_threads = atoi(argv[2]);
+    reopt_interval_ms = (argc > 3) ? atoi(argv[3]) : DEFAULT_REOPT_INTERVAL_MS;
+    time_scale = (argc > 4) ? atof(argv[4]) : 0.0;
+    const char *output_file = (argc > 5) ? argv[5] : NULL;
+    if (nmachs <= 0 || nmachs > MMAX) {
+        printf("Number of machines must be between 1 and %d\n", MMAX);
+        return 1;
+    }
+    if (num_threads <= 0) num_threads = 1;
+    if (reopt_interval_ms < 1) reopt_interval_ms = 1;
+    if (time_scale < 0.0) time_scale = 0.0;
+    // Operations starting within the next re-optimization period are left alone
+    int freeze_margin = (int)(time_scale * reopt_interval_ms / 1000.0) + 1;
+
+    char *line = (char*)malloc(LINE_CHARS);
+    double *latency = NULL;
+    int latency_cap = 0;
+    if (!line) {
+        printf("Out of memory\n");
+        return 1;
+    }
+    for (int m = 0; m < nmachs; m++) timeline_init(&timelines[m]);
+    omp_init_lock(&state_lock);
+    omp_set_max_active_levels(2);
+    stream_start = wall_time_seconds();
+
+    #pragma omp parallel sections num_threads(2)
+    {
+        #pragma omp section
+        {
+            // Reader: place each job as soon as its line is complete
+            int line_no = 0;
+            while (fgets(line, LINE_CHARS, stdin)) {
+                double arrival = wall_time_seconds();
+                line_no++;
+                omp_set_lock(&state_lock);
+                int j = append_job(line);
+                if (j >= 0) place_arriving_job(j);
+                omp_unset_lock(&state_lock);
+                if (j == -2) {
+                    fprintf(stderr, "Skipping malformed job line %d\n", line_no);
+                    continue;
+                }
+                if (j < 0) continue;
+                if (grow((void**)&latency, &latency_cap, j + 1, sizeof(double))) {
+                    latency[j] = (wall_time_seconds() - arrival) * 1000.0;
+                }
+            }
+            input_done = 1;
+        }
+        #pragma omp section
+        {
+            // Background re-optimization of the operations that have not started
+            unsigned long seen = 0;
+            while (!input_done) {
+                for (int waited = 0; waited < reopt_interval_ms && !input_done; waited += 10) {
+                    sleep_ms(reopt_interval_ms - waited < 10 ? reopt_interval_ms - waited : 10);
+                }
+                omp_set_lock(&state_lock);
+                unsigned long current = version;
+                omp_unset_lock(&state_lock);
+                if (current == seen) continue;
+                reoptimize(num_threads, freeze_margin);
+                seen = current;
+            }
+        }
+    }
+    reoptimize(num_threads, freeze_margin); // Final pass over whatever is still movable
+    double elapsed = wall_time_seconds() - stream_start;
+
+    double *sorted = (double*)malloc(sizeof(double) * (njobs > 0 ? njobs : 1));
+    if (sorted && latency) {
+        memcpy(sorted, latency, sizeof(double) * njobs);
+        qsort(sorted, njobs, sizeof(double), compare_doubles);
+    }
+    fprintf(stderr, "Streaming scheduler finished: %d jobs, %d operations in %.3f seconds\n", njobs, total_ops, elapsed);
+    fprintf(stderr, "Makespan: %d\n", makespan);
+    fprintf(stderr, "Re-optimization rounds: %ld (improved: %ld, operations moved: %ld)\n",
+            reopt_rounds, reopt_improvements, ops_moved);
+    if (sorted && latency && njobs > 0) {
+        fprintf(stderr, "Job latency (ms): p50 %.3f, p90 %.3f, p99 %.3f, max %.3f\n",
+                percentile(sorted, njobs, 0.50), percentile(sorted, njobs, 0.90),
+                percentile(sorted, njobs, 0.99), sorted[njobs - 1]);
+    }
+    if (output_file) save_stream_result(output_file);
+
+    omp_destroy_lock(&state_lock);
+    for (int m = 0; m < nmachs; m++) timeline_free(&timelines[m]);
+    free(sorted); free(latency); free(line);
+    free(ops); free(job_first); free(job_nops); free(job_release);
+    return 0;
+}
@@ -0,0 +1,283 @@
+// jobshop_validate.c
+// Schedule validator and critical-path report. Checks result files (save_result_seq layout or
+// Annex II) against their instance: job order, machine non-overlap, every operation started
+// and the reported makespan, in O(n log n) per file, and extracts the critical path and its
+// blocks. Many files are checked in one process, reloading the instance only when it changes,
+// so whole benchmark directories can be validated after every run. Instances are held in
+// buffers sized from their header, not in a Shop, so rolling-horizon and streaming output
+// with more than JMAX jobs validates as well.
+
+#include "../../Common/jobshop_common.h"
+#include "../../Common/jobshop_schedule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+typedef struct {
+    Step *steps;                   // Instance, job-major; the start times of the file being checked
+    ScheduleView view;             // Over steps, stride nops
+    int nmachs;
+    char instance[1024];           // Path the steps were loaded from
+    int *path;                     // Critical path, njobs * nops entries
+    int *block_first;
+    int *block_len;
+    FILE *json;                    // Optional per-file report
+    int show_critical;
+    int checked;
+    int valid;
+} Validator;
+
+// Makespan written in the result file, -1 if it has none
+static int reported_makespan(const char *filename) {
+    FILE *f = fopen(filename, "r");
+    if (!f) return -1;
+    char line[256];
+    int makespan = -1;
+    if (fgets(line, sizeof(line), f)) {
+        if (isdigit((unsigned char)line[0])) {
+            makespan = atoi(line); // Annex II: the makespan is the first line
+        } else {
+            do {
+                if (sscanf(line, "Makespan: %d", &makespan) == 1) break;
+            } while (fgets(line, sizeof(line), f));
+        }
+    }
+    fclose(f);
+    return makespan;
+}
+
+// Read an instance of any number of jobs into v->steps
+static int load_instance(Validator *v, const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening problem file");
+        return 0;
+    }
+    int njobs, nmachs;
+    if (fscanf(file, "%d %d", &njobs, &nmachs) != 2 || njobs <= 0 || nmachs <= 0 || nmachs > MMAX) {
+        fprintf(stderr, "Error reading njobs and nmachs from %s (machines limited to MMAX)\n", filename);
+        fclose(file);
+        return 0;
+    }
+    int nops = nmachs; // Same assumption as load_problem_seq
+    Step *steps = (Step*)malloc(sizeof(Step) * (size_t)njobs * nops);
+    if (!steps) {
+        fprintf(stderr, "Out of memory loading %s\n", filename);
+        fclose(file);
+        return 0;
+    }
+    for (int i = 0; i < njobs * nops; i++) {
+        if (fscanf(file, "%d %d", &steps[i].mach, &steps[i].len) != 2 ||
+            steps[i].mach < 0 || steps[i].mach >= nmachs) {
+            fprintf(stderr, "Error reading operation for job %d, op %d from %s\n", i / nops, i % nops, filename);
+            free(steps);
+            fclose(file);
+            return 0;
+        }
+        steps[i].stime = -1;
+    }
+    fclose(file);
+    free(v->steps);
+    v->steps = steps;
+    v->nmachs = nmachs;
+    v->view.steps = steps;
+    v->view.stride = nops;
+    v->view.njobs = njobs;
+    v->view.nops = nops;
+    return 1;
+}
+
+// Read the start times of a result file into v->steps, like load_result_seq: the
+// save_result_seq layout or Annex II (makespan, then one line of start times per job)
+static int load_starts(Validator *v, const char *filename) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening result file");
+        return 0;
+    }
+    int n = v->view.njobs * v->view.nops;
+    for (int i = 0; i < n; i++) v->steps[i].stime = -1;
+
+    char line[1024];
+    if (!fgets(line, sizeof(line), file)) {
+        fprintf(stderr, "Empty result file %s\n", filename);
+        fclose(file);
+        return 0;
+    }
+    int loaded = 0;
+    if (strncmp(line, "Number of jobs", 14) == 0) {
+        while (fgets(line, sizeof(line), file)) {
+            int j, k, mach, len, stime;
+            if (sscanf(line, "Job %d, Op %d: M%d, Len %d, Start %d", &j, &k, &mach, &len, &stime) == 5 &&
+                j >= 0 && j < v->view.njobs && k >= 0 && k < v->view.nops) {
+                v->steps[j * v->view.nops + k].stime = stime;
+                loaded++;
+            }
+        }
+    } else {
+        for (int i = 0; i < n; i++) {
+            if (fscanf(file, "%d", &v->steps[i].stime) != 1) {
+                fprintf(stderr, "Error reading start time for job %d, op %d from %s\n", i / v->view.nops, i % v->view.nops, filename);
+                fclose(file);
+                return 0;
+            }
+            loaded++;
+        }
+    }
+    fclose(file);
+    if (loaded != n) {
+        fprintf(stderr, "Result file %s has %d of %d start times\n", filename, loaded, n);
+        return 0;
+    }
+    return 1;
+}
+
+static int use_instance(Validator *v, const char *instance) {
+    if (strcmp(v->instance, instance) == 0) return 1;
+    v->instance[0] = '\0';
+    if (!load_instance(v, instance)) return 0;
+    int n = v->view.njobs * v->view.nops;
+    free(v->path);
+    free(v->block_first);
+    free(v->block_len);
+    v->path = (int*)malloc(sizeof(int) * n);
+    v->block_first = (int*)malloc(sizeof(int) * n);
+    v->block_len = (int*)malloc(sizeof(int) * n);
+    if (!v->path || !v->block_first || !v->block_len) return 0;
+    snprintf(v->instance, sizeof(v->instance), "%s", instance);
+    return 1;
+}
+
+// Validate one result file; prints one line (plus the blocks with --critical)
+static void validate_file(Validator *v, const char *instance, const char *result_file) {
+    v->checked++;
+    if (!use_instance(v, instance)) {
+        printf("ERROR   %s: cannot load instance %s\n", result_file, instance);
+        return;
+    }
+    const ScheduleView *view = &v->view;
+    if (!load_starts(v, result_file)) {
+        printf("ERROR   %s: cannot read the start times\n", result_file);
+        return;
+    }
+    ScheduleCheck check;
+    int feasible = schedule_view_validate(view, &check);
+    int reported = reported_makespan(result_file);
+    int matches = (reported < 0 || reported == check.makespan);
+    int len = feasible ? schedule_view_critical_path(view, v->path) : -1;
+    int nblocks = len > 0 ? schedule_view_critical_blocks(view, v->path, len, v->block_first, v->block_len) : 0;
+    int semi_active = 0;
+    for (int i = 0; i < len; i++) semi_active += v->steps[v->path[i]].len;
+
+    if (feasible && matches) {
+        v->valid++;
+        printf("OK      %s: makespan %d (semi-active %d), critical path %d operations in %d blocks\n",
+               result_file, check.makespan, semi_active, len, nblocks);
+    } else if (feasible) {
+        printf("INVALID %s: reported makespan %d, recomputed %d\n", result_file, reported, check.makespan);
+    } else {
+        printf("INVALID %s: %d precedence, %d overlap, %d unscheduled; first at job %d op %d\n", result_file,
+               check.precedence_violations, check.overlap_violations, check.unscheduled, check.first_job, check.first_op);
+    }
+    if (v->show_critical && len > 0) {
+        for (int b = 0; b < nblocks; b++) {
+            int first = v->path[v->block_first[b]];
+            printf("  block %d on M%d:", b, v->steps[first].mach);
+            for (int i = v->block_first[b]; i < v->block_first[b] + v->block_len[b]; i++) {
+                printf(" J%d.O%d", v->path[i] / view->nops, v->path[i] % view->nops);
+            }
+            printf("\n");
+        }
+    }
+    if (v->json) {
+        char *name = extract_basename(result_file);
+        fprintf(v->json, "%s\n    {\"result\": \"%s\", \"valid\": %s, \"makespan\": %d, \"reported_makespan\": %d, "
+                "\"semi_active_makespan\": %d, \"precedence_violations\": %d, \"overlap_violations\": %d, "
+                "\"unscheduled\": %d, \"critical_path_length\": %d, \"critical_blocks\": [",
+                v->checked > 1 ? "," : "", name ? name : "unknown", (feasible && matches) ? "true" : "false",
+                check.makespan, reported, semi_active, check.precedence_violations, check.overlap_violations,
+                check.unscheduled, len);
+        for (int b = 0; b < nblocks; b++) {
+            int first = v->path[v->block_first[b]];
+            fprintf(v->json, "%s{\"machine\": %d, \"length\": %d}", b ? ", " : "",
+                    v->steps[first].mach, v->block_len[b]);
+        }
+        fprintf(v->json, "]}");
+        free(name);
+    }
+}
+
+// Manifest lines: "<instance> <result>", blank lines and # comments skipped
+static int validate_manifest(Validator *v, const char *manifest) {
+    FILE *f = fopen(manifest, "r");
+    if (!f) {
+        printf("Error: cannot open manifest %s\n", manifest);
+        return 0;
+    }
+    char line[2048], instance[1024], result_file[1024];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#') continue;
+        if (sscanf(line, "%1023s %1023s", instance, result_file) != 2) continue;
+        validate_file(v, instance, result_file);
+    }
+    fclose(f);
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    char *json_file = take_option_value(&argc, argv, "--json");
+    char *manifest = take_option_value(&argc, argv, "--manifest");
+    int show_critical = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--critical") == 0) {
+            show_critical = 1;
+            for (int k = i; k < argc; k++) argv[k] = argv[k + 1];
+            argc--;
+            break;
+        }
+    }
+    if ((!manifest && argc < 3) || (manifest && argc != 1)) {
+        printf("Usage: %s <instance_file> <result_file> [result_file ...] [--critical] [--json <report.json>]\n", argv[0]);
+        printf("       %s --manifest <pairs.txt> [--critical] [--json <report.json>]\n", argv[0]);
+        printf("  Result files: the SB layout (save_result_seq) or Annex II (makespan, start times per job)\n");
+        printf("  --manifest: one \"<instance_file> <result_file>\" pair per line\n");
+        printf("  --critical: list the critical blocks of every valid schedule\n");
+        printf("Exit code 0 when every schedule is valid\n");
+        return 1;
+    }
+
+    Validator *v = (Validator*)calloc(1, sizeof(Validator));
+    if (!v) {
+        printf("Error: out of memory\n");
+        return 1;
+    }
+    v->show_critical = show_critical;
+    if (json_file) {
+        v->json = fopen(json_file, "w");
+        if (!v->json) {
+            printf("Error: cannot write %s\n", json_file);
+            free(v);
+            return 1;
+        }
+        fprintf(v->json, "{\n  \"results\": [");
+    }
+    double start = wall_time_seconds();
+    int ok = 1;
+    if (manifest) ok = validate_manifest(v, manifest);
+    else for (int i = 2; i < argc; i++) validate_file(v, argv[1], argv[i]);
+    double seconds = wall_time_seconds() - start;
+
+    printf("Validated %d schedule(s): %d valid, %d invalid (%.3f s)\n", v->checked, v->valid, v->checked - v->valid, seconds);
+    if (v->json) {
+        fprintf(v->json, "\n  ],\n  \"checked\": %d,\n  \"valid\": %d,\n  \"seconds\": %.6f\n}\n", v->checked, v->valid, seconds);
+        fclose(v->json);
+    }
+    ok = ok && v->checked > 0 && v->valid == v->checked;
+    free(v->steps);
+    free(v->path);
+    free(v->block_first);
+    free(v->block_len);
+    free(v);
+    return ok ? 0 : 1;
+}
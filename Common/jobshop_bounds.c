@@ -0,0 +1,121 @@
+// Implementation of the instance lower bounds
+
+#include "jobshop_common.h"
+#include "jobshop_bounds.h"
+#include <limits.h>
+
+// One operation of the machine being bounded
+typedef struct {
+    int head;                      // Work of the job before it: earliest start
+    int len;
+    int tail;                      // Work of the job after it
+} BoundOp;
+
+static int compare_heads(const void *a, const void *b) {
+    const BoundOp *x = (const BoundOp*)a, *y = (const BoundOp*)b;
+    return (x->head > y->head) - (x->head < y->head);
+}
+
+// Jackson's preemptive schedule: whenever an operation is released or finishes, run the
+// released one with the longest tail. Its max(completion + tail) is optimal for the
+// preemptive one-machine problem, so a bound for the machine in any schedule. ops is
+// sorted by head, all of positive length; rem is scratch. O(n^2) for n operations.
+static int jackson_preemptive(const BoundOp *ops, int n, int *rem) {
+    int value = 0, released = 0, done = 0, t = 0;
+    for (int i = 0; i < n; i++) rem[i] = ops[i].len;
+    while (done < n) {
+        while (released < n && ops[released].head <= t) released++;
+        int pick = -1;
+        for (int i = 0; i < released; i++) {
+            if (rem[i] > 0 && (pick < 0 || ops[i].tail > ops[pick].tail)) pick = i;
+        }
+        if (pick < 0) { // Idle until the next release
+            t = ops[released].head;
+            continue;
+        }
+        // Run it until it finishes or the next release could preempt it
+        int until = t + rem[pick];
+        if (released < n && ops[released].head < until) until = ops[released].head;
+        rem[pick] -= until - t;
+        t = until;
+        if (rem[pick] == 0) {
+            done++;
+            if (t + ops[pick].tail > value) value = t + ops[pick].tail;
+        }
+    }
+    return value;
+}
+
+// Fills bounds for shop and returns bounds->best, or -1 when out of memory (bounds then
+// holds the job and machine bounds only)
+int shop_lower_bounds(const Shop *shop, ShopBounds *bounds) {
+    int n = shop->njobs * shop->nops;
+    int job_len[JMAX];
+    bounds->job = 0;
+    bounds->machine = 0;
+    bounds->jackson = 0;
+    bounds->jackson_machine = -1;
+    bounds->best = 0;
+    for (int j = 0; j < shop->njobs; j++) {
+        job_len[j] = 0;
+        for (int o = 0; o < shop->nops; o++) job_len[j] += shop->plan[j][o].len;
+        if (job_len[j] > bounds->job) bounds->job = job_len[j];
+    }
+    BoundOp *ops = (BoundOp*)malloc(sizeof(BoundOp) * (n > 0 ? n : 1));
+    int *rem = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    int ok = ops && rem;
+    for (int m = 0; m < shop->nmachs; m++) {
+        int count = 0, load = 0, min_head = INT_MAX, min_tail = INT_MAX;
+        for (int j = 0; j < shop->njobs; j++) {
+            int head = 0;
+            for (int o = 0; o < shop->nops; o++) {
+                const Step *st = &shop->plan[j][o];
+                if (st->mach == m) {
+                    int tail = job_len[j] - head - st->len;
+                    load += st->len;
+                    if (head < min_head) min_head = head;
+                    if (tail < min_tail) min_tail = tail;
+                    if (ok && st->len > 0) { // Zero lengths are covered by the job bound
+                        ops[count].head = head;
+                        ops[count].len = st->len;
+                        ops[count].tail = tail;
+                        count++;
+                    }
+                }
+                head += st->len;
+            }
+        }
+        if (min_head == INT_MAX) continue; // Machine without operations
+        if (min_head + load + min_tail > bounds->machine) bounds->machine = min_head + load + min_tail;
+        if (!ok || count == 0) continue;
+        qsort(ops, count, sizeof(BoundOp), compare_heads);
+        int value = jackson_preemptive(ops, count, rem);
+        if (value > bounds->jackson) {
+            bounds->jackson = value;
+            bounds->jackson_machine = m;
+        }
+    }
+    free(ops);
+    free(rem);
+    bounds->best = bounds->job;
+    if (bounds->machine > bounds->best) bounds->best = bounds->machine;
+    if (bounds->jackson > bounds->best) bounds->best = bounds->jackson;
+    return ok ? bounds->best : -1;
+}
+
+// Relative distance of makespan above lower_bound, in percent
+double bound_gap_percent(int makespan, int lower_bound) {
+    if (lower_bound <= 0) return makespan > 0 ? 100.0 : 0.0;
+    return 100.0 * (makespan - lower_bound) / lower_bound;
+}
+
+// The bound line of the solver outputs
+void bounds_print(const ShopBounds *bounds, int makespan) {
+    printf("Lower bound: %d (jobs %d, machines %d, Jackson %d)", bounds->best, bounds->job, bounds->machine,
+           bounds->jackson);
+    if (makespan != INT_MAX && makespan >= 0) {
+        printf(", gap %.2f%%%s", bound_gap_percent(makespan, bounds->best),
+               makespan <= bounds->best ? ", optimal" : "");
+    }
+    printf("\n");
+}
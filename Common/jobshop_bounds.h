@@ -0,0 +1,24 @@
+// jobshop_bounds.h
+// Lower bounds on the makespan of a whole instance, so every solver can report how far its
+// schedule is from optimal and stop as soon as it reaches the bound. The job bound is the
+// longest job, the machine bound the heaviest machine plus the shortest head before and tail
+// after its operations, and the Jackson bound the optimal preemptive one-machine schedule
+// of each machine with the heads as release times and the tails as delivery times.
+#ifndef JOBSHOP_BOUNDS_H
+#define JOBSHOP_BOUNDS_H
+
+#include "jobshop_common.h"
+
+typedef struct {
+    int job;                       // Longest job
+    int machine;                   // min head + load + min tail of the heaviest machine
+    int jackson;                   // Preemptive one-machine (Jackson) bound, >= machine
+    int jackson_machine;           // Machine that gives the Jackson bound, -1 if none
+    int best;                      // Largest of the three
+} ShopBounds;
+
+int shop_lower_bounds(const Shop *shop, ShopBounds *bounds);
+double bound_gap_percent(int makespan, int lower_bound);
+void bounds_print(const ShopBounds *bounds, int makespan);
+
+#endif // JOBSHOP_BOUNDS_H
@@ -1,6 +1,11 @@
 // Implementation of common functions for job-shop scheduling
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L // clock_gettime and strdup under -std=c99
+#endif
 
 #include "jobshop_common.h"
+#include "jobshop_timeline.h"
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,22 +28,42 @@ void make_logs_dir(void) {
     printf("make_logs_dir called (placeholder)\n");
 }
 
+// Earliest start >= earliest_start at which 'mach' is idle for 'len' time units, given
+// the operations of shop->plan that already have a start time. Idle gaps between
+// scheduled operations are used, not only the time after the last one. One scan of the
+// plan per call (-1 when out of memory); callers placing many operations should keep a
+// ShopTimeline per machine.
 int find_slot_seq(Shop *shop, int mach, int len, int earliest_start) {
-    // Placeholder: Implement logic to find the earliest available time slot for an operation
-    // on a given machine, considering already scheduled operations in shop->plan.
-    // This is a simplified placeholder.
-    int earliest_finish_time_on_machine = 0;
-    for (int j = 0; j < shop->njobs; ++j) {
-        for (int op = 0; op < shop->nops; ++op) {
-            if (shop->plan[j][op].mach == mach && shop->plan[j][op].stime != -1) {
-                int op_finish_time = shop->plan[j][op].stime + shop->plan[j][op].len;
-                if (op_finish_time > earliest_finish_time_on_machine) {
-                    earliest_finish_time_on_machine = op_finish_time;
-                }
-            }
+    ShopTimeline tl;
+    timeline_init(&tl);
+    int ok = 1;
+    for (int j = 0; j < shop->njobs && ok; ++j) {
+        for (int op = 0; op < shop->nops && ok; ++op) {
+            Step *st = &shop->plan[j][op];
+            if (st->mach == mach && st->stime != -1) ok = timeline_append(&tl, st->stime, st->stime + st->len);
         }
     }
-    return (earliest_start > earliest_finish_time_on_machine) ? earliest_start : earliest_finish_time_on_machine;
+    int t = -1;
+    if (ok) {
+        timeline_finish(&tl);
+        t = timeline_earliest(&tl, earliest_start, len);
+    }
+    timeline_free(&tl);
+    return t;
+}
+
+double wall_time_seconds(void) {
+    // Monotonic wall clock, unlike clock() which sums CPU time over all threads
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
 }
 
 // Sequential version functions
@@ -83,6 +108,36 @@ int load_problem_seq(const char *filename, Shop *shop) {
     return 1; // Success
 }
 
+// In-memory counterpart of load_problem_seq: parse an instance in .jss text form
+int parse_problem_seq(const char *text, Shop *shop) {
+    const char *p = text;
+    char *end;
+    shop->njobs = (int)strtol(p, &end, 10);
+    if (end == p) return 0;
+    p = end;
+    shop->nmachs = (int)strtol(p, &end, 10);
+    if (end == p) return 0;
+    p = end;
+    shop->nops = shop->nmachs; // Uniform, as in load_problem_seq
+    if (shop->njobs <= 0 || shop->nmachs <= 0 || shop->njobs > JMAX || shop->nmachs > MMAX || shop->nops > OPMAX) {
+        return 0;
+    }
+    for (int i = 0; i < shop->njobs; ++i) {
+        for (int k = 0; k < shop->nops; ++k) {
+            shop->plan[i][k].mach = (int)strtol(p, &end, 10);
+            if (end == p) return 0;
+            p = end;
+            shop->plan[i][k].len = (int)strtol(p, &end, 10);
+            if (end == p) return 0;
+            p = end;
+            if (shop->plan[i][k].mach < 0 || shop->plan[i][k].mach >= shop->nmachs || shop->plan[i][k].len < 0) return 0;
+            shop->plan[i][k].stime = -1;
+        }
+    }
+    shop->nlogs = 0;
+    return 1;
+}
+
 void save_result_seq(const char *filename, Shop *shop) {
     // This function signature matches the header.
     // The call in jobshop_seq_sb.c might need to be adjusted or this function adapted.
@@ -125,6 +180,96 @@ void save_result_seq(const char *filename, Shop *shop) {
 }
 
 
+// Read start times back from a result file into an already loaded shop.
+// Accepts both the save_result_seq layout and the Annex II layout (makespan, then one
+// line of start times per job) written by the Branch & Bound programs.
+int load_result_seq(const char *filename, Shop *shop) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening result file");
+        return 0;
+    }
+    reset_plan_seq(shop);
+
+    char line[1024];
+    if (!fgets(line, sizeof(line), file)) {
+        fprintf(stderr, "Empty result file %s\n", filename);
+        fclose(file);
+        return 0;
+    }
+    int loaded = 0;
+    if (strncmp(line, "Number of jobs", 14) == 0) {
+        while (fgets(line, sizeof(line), file)) {
+            int j, k, mach, len, stime;
+            if (sscanf(line, "Job %d, Op %d: M%d, Len %d, Start %d", &j, &k, &mach, &len, &stime) == 5 &&
+                j >= 0 && j < shop->njobs && k >= 0 && k < shop->nops) {
+                shop->plan[j][k].stime = stime;
+                loaded++;
+            }
+        }
+    } else {
+        for (int i = 0; i < shop->njobs; ++i) {
+            for (int k = 0; k < shop->nops; ++k) {
+                if (fscanf(file, "%d", &shop->plan[i][k].stime) != 1) {
+                    fprintf(stderr, "Error reading start time for job %d, op %d from %s\n", i, k, filename);
+                    fclose(file);
+                    return 0;
+                }
+                loaded++;
+            }
+        }
+    }
+    fclose(file);
+    if (loaded != shop->njobs * shop->nops) {
+        fprintf(stderr, "Result file %s has %d of %d start times\n", filename, loaded, shop->njobs * shop->nops);
+        return 0;
+    }
+    return 1;
+}
+
+// Load a complete schedule written by save_result_seq without the instance file: the
+// header gives the sizes, every operation line its machine, length and start time.
+int load_schedule_seq(const char *filename, Shop *shop) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening schedule file");
+        return 0;
+    }
+    if (fscanf(file, " Number of jobs: %d", &shop->njobs) != 1 ||
+        fscanf(file, " Number of machines: %d", &shop->nmachs) != 1 ||
+        fscanf(file, " Number of operations per job: %d", &shop->nops) != 1) {
+        fprintf(stderr, "%s is not a save_result_seq schedule\n", filename);
+        fclose(file);
+        return 0;
+    }
+    if (shop->njobs > JMAX || shop->nmachs > MMAX || shop->nops > OPMAX ||
+        shop->njobs <= 0 || shop->nmachs <= 0 || shop->nops <= 0) {
+        fprintf(stderr, "Problem size exceeds maximum defined limits (JMAX, MMAX, OPMAX).\n");
+        fclose(file);
+        return 0;
+    }
+    reset_plan_seq(shop);
+
+    char line[1024];
+    int loaded = 0;
+    while (fgets(line, sizeof(line), file)) {
+        int j, k, mach, len, stime;
+        if (sscanf(line, "Job %d, Op %d: M%d, Len %d, Start %d", &j, &k, &mach, &len, &stime) == 5 &&
+            j >= 0 && j < shop->njobs && k >= 0 && k < shop->nops && mach >= 0 && mach < shop->nmachs) {
+            shop->plan[j][k].mach = mach;
+            shop->plan[j][k].len = len;
+            shop->plan[j][k].stime = stime;
+            loaded++;
+        }
+    }
+    fclose(file);
+    if (loaded != shop->njobs * shop->nops) {
+        fprintf(stderr, "Schedule file %s has %d of %d operations\n", filename, loaded, shop->njobs * shop->nops);
+        return 0;
+    }
+    return 1;
+}
+
 void reset_plan_seq(Shop *shop) {
     for (int i = 0; i < shop->njobs; ++i) {
         for (int k = 0; k < shop->nops; ++k) {
@@ -181,6 +326,29 @@ char* extract_basename(const char *filepath) {
     return basename_alloc; // Remember to free this
 }
 
+// Remove "flag value" from the command line wherever it appears and return value, NULL if absent
+char* take_option_value(int *argc, char *argv[], const char *flag) {
+    for (int i = 1; i + 1 < *argc; i++) {
+        if (strcmp(argv[i], flag) != 0) continue;
+        char *value = argv[i + 1];
+        for (int k = i; k + 2 <= *argc; k++) argv[k] = argv[k + 2];
+        *argc -= 2;
+        return value;
+    }
+    return NULL;
+}
+
+// Remove a switch from the command line wherever it appears; 1 if it was there
+int take_option_flag(int *argc, char *argv[], const char *flag) {
+    for (int i = 1; i < *argc; i++) {
+        if (strcmp(argv[i], flag) != 0) continue;
+        for (int k = i; k + 1 <= *argc; k++) argv[k] = argv[k + 1];
+        (*argc)--;
+        return 1;
+    }
+    return 0;
+}
+
 // New utility functions for automatic folder routing
 const char* get_size_category(int njobs, int nmachs) {
     // Placeholder: Implement logic based on njobs/nmachs to categorize
@@ -255,3 +423,60 @@ void get_result_path(char* path_buffer, const char* algorithm, const char* size_
     snprintf(path_buffer, 1024, "../../Results/%s/%s/%s_results.txt", // Standardized result filename
              algorithm, size_category, basename);
 }
+
+// Cut the last path component off path (in place). Returns 0 when there is none.
+static int strip_path_component(char *path) {
+    char *slash = strrchr(path, '/');
+#ifdef _WIN32
+    char *backslash = strrchr(path, '\\');
+    if (backslash > slash) slash = backslash;
+#endif
+    if (!slash) return 0;
+    *slash = '\0';
+    return 1;
+}
+
+// Directory of the running executable, 0 when the platform doesn't tell
+static int executable_dir(char *dir, size_t size) {
+#ifdef _WIN32
+    DWORD len = GetModuleFileNameA(NULL, dir, (DWORD)size);
+    if (len == 0 || len >= size) return 0;
+#elif defined(__linux__)
+    ssize_t len = readlink("/proc/self/exe", dir, size - 1);
+    if (len <= 0) return 0;
+    dir[len] = '\0';
+#else
+    (void)dir; (void)size;
+    return 0;
+#endif
+    return strip_path_component(dir);
+}
+
+// Path of name in the jobshop home: $JOBSHOP_HOME if set, else the repository root when the
+// executable sits in Algorithms/<family>/ as build_all.ps1 places them, else the executable's
+// own directory. Only when none of these is known is name left relative to the current directory.
+void jobshop_home_path(char *path, size_t size, const char *name) {
+    const char *home = getenv("JOBSHOP_HOME");
+    if (home && home[0]) {
+        snprintf(path, size, "%s/%s", home, name);
+        return;
+    }
+    char dir[JOBSHOP_HOME_MAX];
+    if (!executable_dir(dir, sizeof(dir))) {
+        snprintf(path, size, "%s", name);
+        return;
+    }
+    char root[JOBSHOP_HOME_MAX + 16];
+    snprintf(root, sizeof(root), "%s", dir);
+    struct stat st;
+    if (strip_path_component(root) && strip_path_component(root)) {
+        char algorithms[JOBSHOP_HOME_MAX + 32];
+        snprintf(algorithms, sizeof(algorithms), "%s/Algorithms", root);
+        if (stat(algorithms, &st) == 0 && S_ISDIR(st.st_mode)) {
+            snprintf(path, size, "%s/%s", root, name);
+            return;
+        }
+    }
+    snprintf(path, size, "%s/%s", dir, name);
+}
+
@@ -68,15 +68,21 @@ typedef struct {
 // Common function declarations
 void make_logs_dir(void);
 int find_slot_seq(Shop *shop, int mach, int len, int earliest_start);
+double wall_time_seconds(void);
 
 // Sequential version functions
 int load_problem_seq(const char *filename, Shop *shop);
+int parse_problem_seq(const char *text, Shop *shop);
 void save_result_seq(const char *filename, Shop *shop);
+int load_result_seq(const char *filename, Shop *shop);
+int load_schedule_seq(const char *filename, Shop *shop);
 void reset_plan_seq(Shop *shop);
 void dump_logs_seq(Shop *shop, const char *basename);
 
 // Common utility functions
 char* extract_basename(const char *filepath);
+char* take_option_value(int *argc, char *argv[], const char *flag);
+int take_option_flag(int *argc, char *argv[], const char *flag);
 
 // New utility functions for automatic folder routing
 const char* get_size_category(int njobs, int nmachs);
@@ -84,4 +90,9 @@ void create_algorithm_dirs(const char* algorithm);
 void get_log_path(char* path, const char* algorithm, const char* size_category, const char* basename, const char* suffix);
 void get_result_path(char* path, const char* algorithm, const char* size_category, const char* basename);
 
+// Files shared by every executable (calibration, solution cache), independent of the
+// directory an executable is run from
+#define JOBSHOP_HOME_MAX 1024
+void jobshop_home_path(char *path, size_t size, const char *name);
+
 #endif // JOBSHOP_COMMON_H
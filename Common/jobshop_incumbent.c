@@ -0,0 +1,126 @@
+// Implementation of the shared, lock-free incumbent used by the portfolio solver
+
+#include "jobshop_incumbent.h"
+#include "jobshop_trace.h"
+#include <limits.h>
+
+#define PACK_BEST(makespan, slot) (((unsigned long long)(unsigned int)(makespan) << 32) | (unsigned int)(slot))
+#define BEST_MAKESPAN(best) ((int)((best) >> 32))
+#define BEST_SLOT(best) ((int)((best) & 0xffffffffu))
+#define NO_SLOT 0xffffffffu
+
+void incumbent_init(Incumbent *inc, int njobs, int nops, int lower_bound, double budget_seconds) {
+    inc->best = PACK_BEST(INT_MAX, NO_SLOT);
+    inc->stop = 0;
+    inc->optimal = 0;
+    inc->updates = 0;
+    inc->lower_bound = lower_bound;
+    inc->target = 0;
+    inc->target_hit = 0;
+    inc->target_time = 0.0;
+    inc->deadline = (budget_seconds > 0.0) ? wall_time_seconds() + budget_seconds : 0.0;
+    inc->njobs = njobs;
+    inc->nops = nops;
+    for (int s = 0; s < INCUMBENT_SLOTS; s++) {
+        inc->slots[s].seq = 0;
+        inc->slots[s].makespan = INT_MAX;
+        inc->slots[s].source = INCUMBENT_SRC_NONE;
+    }
+}
+
+// Record when a schedule of makespan <= target is first published; the search goes on
+void incumbent_set_target(Incumbent *inc, int target) {
+    inc->target = target;
+}
+
+int incumbent_makespan(const Incumbent *inc) {
+    return BEST_MAKESPAN(__atomic_load_n(&inc->best, __ATOMIC_ACQUIRE));
+}
+
+// Publish a schedule if it beats the current incumbent. Returns 1 when published.
+int incumbent_offer(Incumbent *inc, int makespan, const int *stime, int source) {
+    unsigned long long cur = __atomic_load_n(&inc->best, __ATOMIC_ACQUIRE);
+    if (makespan >= BEST_MAKESPAN(cur)) return 0;
+
+    // Claim a free slot (even seq, not the published one). Slots are only held for
+    // the duration of one copy, so this never waits on a stalled writer for long.
+    int slot = -1;
+    unsigned int seq = 0;
+    for (int attempt = 0; slot < 0; attempt++) {
+        int s = (int)((inc->updates + (unsigned int)attempt) % INCUMBENT_SLOTS);
+        if (s == BEST_SLOT(__atomic_load_n(&inc->best, __ATOMIC_ACQUIRE))) continue;
+        seq = __atomic_load_n(&inc->slots[s].seq, __ATOMIC_ACQUIRE);
+        if ((seq & 1u) == 0 &&
+            __atomic_compare_exchange_n(&inc->slots[s].seq, &seq, seq + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            slot = s;
+        }
+    }
+
+    IncumbentSlot *dst = &inc->slots[slot];
+    int nops_total = inc->njobs * inc->nops;
+    memcpy(dst->stime, stime, sizeof(int) * nops_total);
+    dst->makespan = makespan;
+    dst->source = source;
+
+    // Swap the pointer while still owning the slot; readers that race with us see an
+    // odd seq and retry, other writers skip the slot until we release it below.
+    int published = 0;
+    unsigned long long next = PACK_BEST(makespan, slot);
+    cur = __atomic_load_n(&inc->best, __ATOMIC_ACQUIRE);
+    while (makespan < BEST_MAKESPAN(cur)) {
+        if (__atomic_compare_exchange_n(&inc->best, &cur, next, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            published = 1;
+            break;
+        }
+    }
+    __atomic_store_n(&dst->seq, seq + 2, __ATOMIC_RELEASE);
+    if (!published) return 0;
+    __atomic_add_fetch(&inc->updates, 1, __ATOMIC_RELAXED);
+    TRACE_INSTANT("incumbent_update", makespan);
+    if (inc->target > 0 && makespan <= inc->target) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&inc->target_hit, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            inc->target_time = wall_time_seconds();
+        }
+    }
+    if (makespan <= inc->lower_bound) incumbent_stop(inc, 1);
+    return 1;
+}
+
+// Copy the current best schedule. Returns its makespan, or INT_MAX if nothing was published yet.
+int incumbent_snapshot(Incumbent *inc, int *stime_out, int *source_out) {
+    int nops_total = inc->njobs * inc->nops;
+    for (;;) {
+        unsigned long long cur = __atomic_load_n(&inc->best, __ATOMIC_ACQUIRE);
+        if (BEST_SLOT(cur) == (int)NO_SLOT) {
+            if (source_out) *source_out = INCUMBENT_SRC_NONE;
+            return INT_MAX;
+        }
+        IncumbentSlot *src = &inc->slots[BEST_SLOT(cur)];
+        unsigned int before = __atomic_load_n(&src->seq, __ATOMIC_ACQUIRE);
+        if (before & 1u) continue;
+        int makespan = src->makespan;
+        int source = src->source;
+        if (stime_out) memcpy(stime_out, src->stime, sizeof(int) * nops_total);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        unsigned int after = __atomic_load_n(&src->seq, __ATOMIC_RELAXED);
+        if (before == after && makespan == BEST_MAKESPAN(cur)) {
+            if (source_out) *source_out = source;
+            return makespan;
+        }
+    }
+}
+
+int incumbent_should_stop(Incumbent *inc) {
+    if (__atomic_load_n(&inc->stop, __ATOMIC_ACQUIRE)) return 1;
+    if (inc->deadline > 0.0 && wall_time_seconds() >= inc->deadline) {
+        incumbent_stop(inc, 0);
+        return 1;
+    }
+    return 0;
+}
+
+void incumbent_stop(Incumbent *inc, int optimal) {
+    if (optimal) __atomic_store_n(&inc->optimal, 1, __ATOMIC_RELEASE);
+    __atomic_store_n(&inc->stop, 1, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,49 @@
+// jobshop_incumbent.h
+// Shared incumbent (best makespan + schedule) for engines running concurrently
+#ifndef JOBSHOP_INCUMBENT_H
+#define JOBSHOP_INCUMBENT_H
+
+#include "jobshop_common.h"
+
+#define INCUMBENT_SLOTS 8                  // Schedule buffers that writers rotate through
+#define INCUMBENT_MAX_OPS (JMAX * OPMAX)   // Start times are stored as [job * nops + op]
+
+// Engines that can publish into the incumbent (for reporting who found the best)
+#define INCUMBENT_SRC_NONE 0
+#define INCUMBENT_SRC_SB   1
+#define INCUMBENT_SRC_BB   2
+
+// One published schedule. seq is odd while a writer owns the slot.
+typedef struct {
+    volatile unsigned int seq;
+    int makespan;
+    int source;
+    int stime[INCUMBENT_MAX_OPS];
+} IncumbentSlot;
+
+// Lock-free incumbent: 'best' packs (makespan << 32 | slot) and only moves down via CAS,
+// so readers can poll the makespan with a single atomic load on every B&B node.
+typedef struct {
+    volatile unsigned long long best;
+    volatile int stop;             // Budget expired or optimality proven
+    volatile int optimal;          // Set when the stop was caused by a proof
+    volatile unsigned int updates; // Number of successful publications
+    int lower_bound;               // Instance lower bound, reaching it proves optimality
+    int target;                    // Time-to-target makespan, 0 = none (see incumbent_set_target)
+    volatile int target_hit;
+    double target_time;            // wall_time_seconds() of the first publication <= target
+    double deadline;               // wall_time_seconds() deadline, 0 = no budget
+    int njobs;
+    int nops;
+    IncumbentSlot slots[INCUMBENT_SLOTS];
+} Incumbent;
+
+void incumbent_init(Incumbent *inc, int njobs, int nops, int lower_bound, double budget_seconds);
+void incumbent_set_target(Incumbent *inc, int target);
+int incumbent_makespan(const Incumbent *inc);
+int incumbent_offer(Incumbent *inc, int makespan, const int *stime, int source);
+int incumbent_snapshot(Incumbent *inc, int *stime_out, int *source_out);
+int incumbent_should_stop(Incumbent *inc);
+void incumbent_stop(Incumbent *inc, int optimal);
+
+#endif // JOBSHOP_INCUMBENT_H
@@ -0,0 +1,356 @@
+// Implementation of the automatic team sizes, their calibration and thread placement
+
+#ifdef __linux__
+#define _GNU_SOURCE // sched_setaffinity
+#endif
+#include "jobshop_common.h"
+#include "jobshop_parallel.h"
+#include <omp.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#define CALIBRATION_REGIONS 2000   // Empty parallel regions timed for the fork/join cost
+#define CALIBRATION_UNITS 1000000  // Work units per timed probe
+#define CALIBRATION_REPEATS 5      // The fastest repeat counts
+
+// Defaults for an uncalibrated host: a few microseconds per fork/join, about a
+// nanosecond per unit, so regions below 50000 units (a 6x6 SB iteration is ~400) are serial
+static void default_thresholds(ParallelThresholds *t) {
+    t->max_threads = omp_get_num_procs();
+    t->fork_join_seconds = 5e-6;
+    t->unit_seconds = 1e-9;
+    t->serial_cutoff = PARALLEL_OVERHEAD_FACTOR * t->fork_join_seconds / t->unit_seconds;
+    t->units_per_thread = t->serial_cutoff;
+    t->calibrated = 0;
+}
+
+// $JOBSHOP_PARALLEL, else PARALLEL_CONFIG_FILE in the jobshop home (the repository root for
+// the executables), so every executable reads what jobshop_calibrate wrote wherever it runs
+const char *parallel_config_path(void) {
+    static char home_path[JOBSHOP_HOME_MAX];
+    const char *path = getenv("JOBSHOP_PARALLEL");
+    if (path && path[0]) return path;
+    if (!home_path[0]) jobshop_home_path(home_path, sizeof(home_path), PARALLEL_CONFIG_FILE);
+    return home_path;
+}
+
+// Thresholds of this process: the calibration file if there is one, loaded on first use.
+// Without one the defaults are used, and said so once on stderr.
+const ParallelThresholds *parallel_thresholds(void) {
+    static ParallelThresholds thresholds;
+    static volatile int loaded = 0;
+    if (!loaded) {
+        #pragma omp critical (parallel_thresholds)
+        {
+            if (!loaded) {
+                const char *path = parallel_config_path();
+                if (!parallel_load_thresholds(path, &thresholds)) {
+                    default_thresholds(&thresholds);
+                    fprintf(stderr, "Parallel thresholds: no calibration at %s, using defaults (run jobshop_calibrate)\n", path);
+                }
+                loaded = 1;
+            }
+        }
+    }
+    return &thresholds;
+}
+
+// Threads for a region of work_units, at most max_threads (PARALLEL_AUTO: the host's).
+// 1 means the region should run serially, without forking a team.
+int parallel_team_size(double work_units, int max_threads) {
+    if (max_threads == 1) return 1; // Serial callers need no thresholds
+    return parallel_team_size_for(parallel_thresholds(), work_units, max_threads);
+}
+
+int parallel_team_size_for(const ParallelThresholds *t, double work_units, int max_threads) {
+    if (max_threads <= PARALLEL_AUTO) max_threads = t->max_threads;
+    if (max_threads <= 1 || work_units < t->serial_cutoff) return 1;
+    double team = work_units / t->units_per_thread;
+    return team >= max_threads ? max_threads : (team < 2.0 ? 2 : (int)team);
+}
+
+// Probe kernel: the access pattern of the SB machine evaluation, one unit per operation
+static long probe_units(const int *mach, const int *len, int n, long units) {
+    long acc = 0;
+    for (long done = 0; done < units; done += n) {
+        for (int i = 0; i < n; i++) {
+            if (mach[i] == (int)(done & 15)) acc += len[i];
+        }
+    }
+    return acc;
+}
+
+// Measure this host. Returns 1 on success.
+int parallel_calibrate(ParallelThresholds *t) {
+    default_thresholds(t);
+    int n = JMAX * OPMAX;
+    int *mach = (int*)malloc(sizeof(int) * n);
+    int *len = (int*)malloc(sizeof(int) * n);
+    if (!mach || !len) {
+        free(mach); free(len);
+        return 0;
+    }
+    for (int i = 0; i < n; i++) {
+        mach[i] = (i * 7) % 16;
+        len[i] = 1 + (i * 13) % 99;
+    }
+    volatile long sink = 0;
+    double best_unit = -1.0, best_fork = -1.0;
+    for (int r = 0; r < CALIBRATION_REPEATS; r++) {
+        double start = wall_time_seconds();
+        sink += probe_units(mach, len, n, CALIBRATION_UNITS);
+        double unit = (wall_time_seconds() - start) / CALIBRATION_UNITS;
+        if (best_unit < 0.0 || unit < best_unit) best_unit = unit;
+
+        start = wall_time_seconds();
+        for (int k = 0; k < CALIBRATION_REGIONS; k++) {
+            #pragma omp parallel num_threads(t->max_threads)
+            {
+                if (omp_get_thread_num() == 0) sink += k;
+            }
+        }
+        double fork = (wall_time_seconds() - start) / CALIBRATION_REGIONS;
+        if (best_fork < 0.0 || fork < best_fork) best_fork = fork;
+    }
+    free(mach);
+    free(len);
+    (void)sink;
+    if (best_unit <= 0.0) best_unit = 1e-12; // Below the clock resolution
+    t->fork_join_seconds = best_fork;
+    t->unit_seconds = best_unit;
+    t->serial_cutoff = PARALLEL_OVERHEAD_FACTOR * best_fork / best_unit;
+    t->units_per_thread = t->serial_cutoff > 1.0 ? t->serial_cutoff : 1.0;
+    t->calibrated = 1;
+    return 1;
+}
+
+int parallel_save_thresholds(const char *filename, const ParallelThresholds *t) {
+    FILE *f = fopen(filename, "w");
+    if (!f) return 0;
+    fprintf(f, "# OpenMP team size thresholds of this host, written by jobshop_calibrate\n");
+    fprintf(f, "max_threads %d\n", t->max_threads);
+    fprintf(f, "fork_join_seconds %.9g\n", t->fork_join_seconds);
+    fprintf(f, "unit_seconds %.9g\n", t->unit_seconds);
+    fprintf(f, "serial_cutoff %.9g\n", t->serial_cutoff);
+    fprintf(f, "units_per_thread %.9g\n", t->units_per_thread);
+    fclose(f);
+    return 1;
+}
+
+// "key value" lines, # comments; missing keys keep their defaults. Returns 0 if the file
+// cannot be read or holds no usable cutoff.
+int parallel_load_thresholds(const char *filename, ParallelThresholds *t) {
+    FILE *f = fopen(filename, "r");
+    if (!f) return 0;
+    default_thresholds(t);
+    char line[256], key[64];
+    double value;
+    int found = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || sscanf(line, "%63s %lf", key, &value) != 2) continue;
+        if (strcmp(key, "max_threads") == 0 && value >= 1) t->max_threads = (int)value;
+        else if (strcmp(key, "fork_join_seconds") == 0) t->fork_join_seconds = value;
+        else if (strcmp(key, "unit_seconds") == 0) t->unit_seconds = value;
+        else if (strcmp(key, "serial_cutoff") == 0 && value >= 0) { t->serial_cutoff = value; found = 1; }
+        else if (strcmp(key, "units_per_thread") == 0 && value > 0) t->units_per_thread = value;
+    }
+    fclose(f);
+    t->calibrated = found;
+    return found;
+}
+
+// NUMA layout of the host: the processors of every node, in node order
+typedef struct {
+    int nnodes;
+    int ncpus[PARALLEL_MAX_NODES];
+    int cpus[PARALLEL_MAX_NODES][PARALLEL_MAX_CPUS];
+    int node_of_cpu[PARALLEL_MAX_CPUS];
+} NumaTopology;
+
+// Processor the calling thread was placed on, -1 while it floats
+static int thread_cpu = -1;
+#pragma omp threadprivate(thread_cpu)
+
+// "0-3,8,10-11" into out[]; returns the count, -1 on a malformed list or processor id
+static int parse_cpu_list(const char *text, int *out, int max) {
+    int count = 0;
+    const char *s = text;
+    while (*s && *s != '\n' && *s != ';') {
+        char *end;
+        long first = strtol(s, &end, 10);
+        if (end == s) return -1;
+        long last = first;
+        s = end;
+        if (*s == '-') {
+            last = strtol(s + 1, &end, 10);
+            if (end == s + 1) return -1;
+            s = end;
+        }
+        if (first < 0 || last < first || last >= PARALLEL_MAX_CPUS) return -1;
+        for (long c = first; c <= last && count < max; c++) out[count++] = (int)c;
+        if (*s == ',') s++;
+        else if (*s && *s != '\n' && *s != ';') return -1;
+    }
+    return count;
+}
+
+static void add_numa_node(NumaTopology *t, const int *cpus, int n) {
+    if (t->nnodes >= PARALLEL_MAX_NODES || n <= 0) return;
+    int node = t->nnodes++;
+    t->ncpus[node] = n;
+    for (int i = 0; i < n; i++) {
+        t->cpus[node][i] = cpus[i];
+        t->node_of_cpu[cpus[i]] = node;
+    }
+}
+
+static void load_topology(NumaTopology *t) {
+    int cpus[PARALLEL_MAX_CPUS];
+    memset(t, 0, sizeof(*t));
+    const char *emulated = getenv("JOBSHOP_NUMA");
+    if (emulated && emulated[0]) {
+        for (const char *s = emulated; s; ) {
+            add_numa_node(t, cpus, parse_cpu_list(s, cpus, PARALLEL_MAX_CPUS));
+            s = strchr(s, ';');
+            if (s) s++;
+        }
+    }
+#ifdef __linux__
+    for (int node = 0; node < PARALLEL_MAX_NODES && !(emulated && emulated[0]); node++) {
+        char path[64], line[1024];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+        FILE *f = fopen(path, "r");
+        if (!f) continue; // Node ids can have holes
+        if (fgets(line, sizeof(line), f)) add_numa_node(t, cpus, parse_cpu_list(line, cpus, PARALLEL_MAX_CPUS));
+        fclose(f);
+    }
+#endif
+    if (t->nnodes == 0) { // Single node with every processor
+        int n = omp_get_num_procs();
+        if (n > PARALLEL_MAX_CPUS) n = PARALLEL_MAX_CPUS;
+        for (int i = 0; i < n; i++) cpus[i] = i;
+        add_numa_node(t, cpus, n);
+    }
+}
+
+static const NumaTopology *numa_topology(void) {
+    static NumaTopology topology;
+    static volatile int loaded = 0;
+    if (!loaded) {
+        #pragma omp critical (parallel_topology)
+        {
+            if (!loaded) {
+                load_topology(&topology);
+                loaded = 1;
+            }
+        }
+    }
+    return &topology;
+}
+
+int parallel_numa_nodes(void) {
+    return numa_topology()->nnodes;
+}
+
+void parallel_placement_init(ParallelPlacement *p) {
+    p->bind = PARALLEL_BIND_NONE;
+    p->ncpus = 0;
+    p->replicate = 0;
+}
+
+// --affinity value: none, compact, scatter or a processor list ("0,2,4-7"). Returns 1 if valid.
+int parallel_placement_parse(const char *arg, ParallelPlacement *p) {
+    if (strcmp(arg, "none") == 0) p->bind = PARALLEL_BIND_NONE;
+    else if (strcmp(arg, "compact") == 0) p->bind = PARALLEL_BIND_COMPACT;
+    else if (strcmp(arg, "scatter") == 0) p->bind = PARALLEL_BIND_SCATTER;
+    else {
+        int n = parse_cpu_list(arg, p->cpus, PARALLEL_MAX_CPUS);
+        if (n <= 0 || strchr(arg, ';')) return 0;
+        p->bind = PARALLEL_BIND_LIST;
+        p->ncpus = n;
+    }
+    return 1;
+}
+
+int parallel_placement_active(const ParallelPlacement *p) {
+    return p && (p->bind != PARALLEL_BIND_NONE || p->replicate);
+}
+
+// Processor of thread_num in a team of team_size under placement p
+static int placement_cpu(const ParallelPlacement *p, int thread_num, int team_size) {
+    const NumaTopology *t = numa_topology();
+    (void)team_size;
+    switch (p->bind) {
+        case PARALLEL_BIND_COMPACT: {
+            int total = 0;
+            for (int node = 0; node < t->nnodes; node++) total += t->ncpus[node];
+            int k = thread_num % total;
+            for (int node = 0; node < t->nnodes; node++) {
+                if (k < t->ncpus[node]) return t->cpus[node][k];
+                k -= t->ncpus[node];
+            }
+            return -1;
+        }
+        case PARALLEL_BIND_SCATTER: {
+            int node = thread_num % t->nnodes;
+            return t->cpus[node][(thread_num / t->nnodes) % t->ncpus[node]];
+        }
+        case PARALLEL_BIND_LIST:
+            return p->cpus[thread_num % p->ncpus];
+        default:
+            return -1;
+    }
+}
+
+// Pin the calling thread, number thread_num of a team of team_size, where p puts it. The
+// thread counts as placed there even if the OS refuses (a processor it does not have), so
+// an emulated layout still decides which replica the thread reads. Returns 1 if pinned.
+int parallel_bind_thread(const ParallelPlacement *p, int thread_num, int team_size) {
+    if (!p || p->bind == PARALLEL_BIND_NONE) return 0;
+    int cpu = placement_cpu(p, thread_num, team_size);
+    if (cpu < 0) return 0;
+    if (cpu == thread_cpu) return 1; // Already there from an earlier region
+    thread_cpu = cpu;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+    if (cpu >= (int)(sizeof(DWORD_PTR) * 8)) return 0;
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) != 0;
+#else
+    return 0;
+#endif
+}
+
+void parallel_replicas_init(ShopReplicas *r) {
+    for (int node = 0; node < PARALLEL_MAX_NODES; node++) r->copy[node] = NULL;
+}
+
+// The instance for the calling thread: with p->replicate, the copy of its NUMA node, made
+// by the first thread of the node that asks so its pages live there. Threads that were not
+// placed, and nodes without memory for a copy, read shop itself.
+const Shop *parallel_local_shop(ShopReplicas *r, const ParallelPlacement *p, const Shop *shop) {
+    if (!p || !p->replicate || thread_cpu < 0) return shop;
+    int node = numa_topology()->node_of_cpu[thread_cpu];
+    Shop *copy;
+    #pragma omp critical (parallel_replicas)
+    {
+        copy = r->copy[node];
+        if (!copy) {
+            copy = (Shop*)malloc(sizeof(Shop));
+            if (copy) memcpy(copy, shop, sizeof(Shop));
+            r->copy[node] = copy;
+        }
+    }
+    return copy ? copy : shop;
+}
+
+void parallel_replicas_free(ShopReplicas *r) {
+    for (int node = 0; node < PARALLEL_MAX_NODES; node++) {
+        free(r->copy[node]);
+        r->copy[node] = NULL;
+    }
+}
@@ -0,0 +1,70 @@
+// jobshop_parallel.h
+// Automatic team sizes for the OpenMP regions. A region's work is estimated in units (one
+// operation visited by a kernel); below the serial cutoff the fork/join would cost more
+// than a tenth of the work, so the region runs on the calling thread, and above it every
+// thread gets at least units_per_thread. The thresholds come from jobshop_calibrate, which
+// measures them once per host into the jobshop home (jobshop_home_path), or from built-in
+// defaults.
+//
+// Placement: a ParallelPlacement pins the threads of a team to processors (compact, scatter
+// over the NUMA nodes, or an explicit list) and can give every NUMA node its own copy of the
+// read-only instance, first touched by a thread running there. The NUMA layout comes from
+// /sys/devices/system/node on Linux, from $JOBSHOP_NUMA ("0-3;4-7": one processor list per
+// node, to emulate a multi-socket host), or is a single node.
+#ifndef JOBSHOP_PARALLEL_H
+#define JOBSHOP_PARALLEL_H
+
+#include "jobshop_common.h"
+
+#define PARALLEL_AUTO 0                        // num_threads value that sizes every region itself
+#define PARALLEL_CONFIG_FILE "jobshop_parallel.cfg" // Thresholds file in the jobshop home (JOBSHOP_PARALLEL overrides)
+#define PARALLEL_OVERHEAD_FACTOR 10.0          // Work per region at least this many fork/joins
+#define PARALLEL_MAX_CPUS 256                  // Processors a placement can name
+#define PARALLEL_MAX_NODES 16                  // NUMA nodes told apart
+
+// ParallelPlacement.bind
+#define PARALLEL_BIND_NONE 0                   // Threads move freely (the default)
+#define PARALLEL_BIND_COMPACT 1                // Thread i on the i-th processor, one node after the other
+#define PARALLEL_BIND_SCATTER 2                // Threads dealt round-robin over the NUMA nodes
+#define PARALLEL_BIND_LIST 3                   // Thread i on cpus[i % ncpus]
+
+typedef struct {
+    int max_threads;               // Largest team, the host's processors by default
+    double fork_join_seconds;      // Empty parallel region with max_threads threads
+    double unit_seconds;           // One work unit on one thread
+    double serial_cutoff;          // Fewer units run serially
+    double units_per_thread;       // Work each extra thread has to bring
+    int calibrated;                // Loaded from a calibration file
+} ParallelThresholds;
+
+// Where the threads of a parallel engine run
+typedef struct {
+    int bind;                      // PARALLEL_BIND_*
+    int ncpus;                     // PARALLEL_BIND_LIST processors
+    int cpus[PARALLEL_MAX_CPUS];
+    int replicate;                 // One copy of the instance per NUMA node
+} ParallelPlacement;
+
+// Per-solve copies of the instance, made on first use by each node
+typedef struct {
+    Shop *copy[PARALLEL_MAX_NODES];
+} ShopReplicas;
+
+const ParallelThresholds *parallel_thresholds(void);
+int parallel_team_size(double work_units, int max_threads);
+int parallel_team_size_for(const ParallelThresholds *t, double work_units, int max_threads);
+int parallel_calibrate(ParallelThresholds *t);
+int parallel_save_thresholds(const char *filename, const ParallelThresholds *t);
+int parallel_load_thresholds(const char *filename, ParallelThresholds *t);
+const char *parallel_config_path(void);
+
+void parallel_placement_init(ParallelPlacement *p);
+int parallel_placement_parse(const char *arg, ParallelPlacement *p);
+int parallel_placement_active(const ParallelPlacement *p);
+int parallel_numa_nodes(void);
+int parallel_bind_thread(const ParallelPlacement *p, int thread_num, int team_size);
+void parallel_replicas_init(ShopReplicas *r);
+const Shop *parallel_local_shop(ShopReplicas *r, const ParallelPlacement *p, const Shop *shop);
+void parallel_replicas_free(ShopReplicas *r);
+
+#endif // JOBSHOP_PARALLEL_H
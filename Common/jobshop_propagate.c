@@ -0,0 +1,390 @@
+// Implementation of the propagation engine used by the Branch & Bound searches.
+// Filtering on one machine follows Vilim's O(n log n) Theta-Lambda tree algorithms:
+// edge-finding raises heads, not-last lowers latest completion times; running both on the
+// mirrored machine (time reversed) gives the tail side and not-first.
+
+#include "jobshop_propagate.h"
+#include <limits.h>
+
+#define NEG_INF (INT_MIN / 4)   // Empty tree node, far enough from INT_MIN to add to
+#define MAX_ROUNDS_PER_MACHINE 8 // Bound on re-filtering before giving the node back to the search
+
+// Returns 0 when the trail cannot grow; the engine is then marked out_of_memory and must
+// not be used further (the value is left unchanged)
+static int trail_set(PropEngine *pe, int *addr, int value) {
+    if (*addr == value) return 1;
+    if (pe->trail_len == pe->trail_cap) {
+        int cap = pe->trail_cap * 2;
+        PropTrailEntry *grown = (PropTrailEntry*)realloc(pe->trail, sizeof(PropTrailEntry) * cap);
+        if (!grown) {
+            pe->out_of_memory = 1;
+            return 0;
+        }
+        pe->trail = grown;
+        pe->trail_cap = cap;
+    }
+    pe->trail[pe->trail_len].addr = addr;
+    pe->trail[pe->trail_len].old_value = *addr;
+    pe->trail_len++;
+    *addr = value;
+    return 1;
+}
+
+PropEngine *prop_create(const Shop *shop) {
+    PropEngine *pe = (PropEngine*)calloc(1, sizeof(PropEngine));
+    if (!pe) return NULL;
+    int n = shop->njobs * shop->nops;
+    pe->njobs = shop->njobs;
+    pe->nops = shop->nops;
+    pe->nmachs = shop->nmachs;
+    pe->mach = (int*)malloc(sizeof(int) * n);
+    pe->len = (int*)malloc(sizeof(int) * n);
+    pe->head = (int*)malloc(sizeof(int) * n);
+    pe->tail = (int*)malloc(sizeof(int) * n);
+    pe->mach_ops = (int*)malloc(sizeof(int) * n);
+    pe->trail_cap = 4096;
+    pe->trail = (PropTrailEntry*)malloc(sizeof(PropTrailEntry) * pe->trail_cap);
+    if (!pe->mach || !pe->len || !pe->head || !pe->tail || !pe->mach_ops || !pe->trail) {
+        prop_free(pe);
+        return NULL;
+    }
+
+    // Static windows: job predecessors before, job successors after each operation
+    int total = 0;
+    for (int j = 0; j < shop->njobs; j++) {
+        int head = 0, tail = 0;
+        for (int o = 0; o < shop->nops; o++) {
+            int op = j * shop->nops + o;
+            pe->mach[op] = shop->plan[j][o].mach;
+            pe->len[op] = shop->plan[j][o].len;
+            pe->head[op] = head;
+            head += pe->len[op];
+            total += pe->len[op];
+        }
+        for (int o = shop->nops - 1; o >= 0; o--) {
+            int op = j * shop->nops + o;
+            pe->tail[op] = tail;
+            tail += pe->len[op];
+        }
+        pe->progress[j] = 0;
+    }
+    pe->ub = total; // Any appended schedule finishes within the total work
+
+    for (int m = 0; m < shop->nmachs; m++) {
+        pe->mach_count[m] = 0;
+        pe->mach_ready[m] = 0;
+        pe->dirty[m] = 1;
+    }
+    for (int op = 0; op < n; op++) pe->mach_count[pe->mach[op]]++;
+    int first = 0;
+    pe->max_tasks = 1;
+    for (int m = 0; m < shop->nmachs; m++) {
+        pe->mach_first[m] = first;
+        first += pe->mach_count[m];
+        if (pe->mach_count[m] > pe->max_tasks) pe->max_tasks = pe->mach_count[m];
+        pe->mach_count[m] = 0;
+    }
+    for (int op = 0; op < n; op++) {
+        int m = pe->mach[op];
+        pe->mach_ops[pe->mach_first[m] + pe->mach_count[m]++] = op;
+    }
+
+    pe->tree_size = 1;
+    while (pe->tree_size < pe->max_tasks) pe->tree_size *= 2;
+    int t = pe->max_tasks, nodes = 2 * pe->tree_size;
+    int **task_buffers[] = { &pe->task_op, &pe->est, &pe->lct, &pe->p, &pe->new_est, &pe->new_lct,
+                             &pe->order, &pe->order2, &pe->rank, &pe->in_theta };
+    int **tree_buffers[] = { &pe->sum_p, &pe->ect, &pe->sum_p_bar, &pe->ect_bar, &pe->resp_sum, &pe->resp_ect };
+    for (size_t b = 0; b < sizeof(task_buffers) / sizeof(task_buffers[0]); b++) {
+        *task_buffers[b] = (int*)malloc(sizeof(int) * t);
+        if (!*task_buffers[b]) { prop_free(pe); return NULL; }
+    }
+    for (size_t b = 0; b < sizeof(tree_buffers) / sizeof(tree_buffers[0]); b++) {
+        *tree_buffers[b] = (int*)malloc(sizeof(int) * nodes);
+        if (!*tree_buffers[b]) { prop_free(pe); return NULL; }
+    }
+    pe->sort_keys = (PropSortKey*)malloc(sizeof(PropSortKey) * t);
+    if (!pe->sort_keys) { prop_free(pe); return NULL; }
+    return pe;
+}
+
+void prop_free(PropEngine *pe) {
+    if (!pe) return;
+    free(pe->mach); free(pe->len); free(pe->head); free(pe->tail); free(pe->mach_ops); free(pe->trail);
+    free(pe->task_op); free(pe->est); free(pe->lct); free(pe->p); free(pe->new_est); free(pe->new_lct);
+    free(pe->order); free(pe->order2); free(pe->rank); free(pe->in_theta);
+    free(pe->sum_p); free(pe->ect); free(pe->sum_p_bar); free(pe->ect_bar); free(pe->resp_sum); free(pe->resp_ect);
+    free(pe->sort_keys);
+    free(pe);
+}
+
+int prop_trail_mark(const PropEngine *pe) {
+    return pe->trail_len;
+}
+
+void prop_backtrack(PropEngine *pe, int mark) {
+    while (pe->trail_len > mark) {
+        pe->trail_len--;
+        *pe->trail[pe->trail_len].addr = pe->trail[pe->trail_len].old_value;
+    }
+}
+
+// The bound only moves down, so deductions made under an older bound stay valid
+void prop_set_upper_bound(PropEngine *pe, int ub) {
+    if (ub >= pe->ub) return;
+    pe->ub = ub;
+    for (int m = 0; m < pe->nmachs; m++) pe->dirty[m] = 1;
+}
+
+// Raise the head of an operation and push the change down its job
+static int raise_head(PropEngine *pe, int op, int value) {
+    for (int o = op % pe->nops; o < pe->nops; o++, op++) {
+        if (value <= pe->head[op]) return 1;
+        if (value + pe->len[op] + pe->tail[op] > pe->ub) return 0;
+        if (!trail_set(pe, &pe->head[op], value)) return 0;
+        pe->dirty[pe->mach[op]] = 1;
+        value += pe->len[op];
+    }
+    return 1;
+}
+
+// Raise the tail of an operation and push the change up its job (unscheduled part only)
+static int raise_tail(PropEngine *pe, int op, int value) {
+    int j = op / pe->nops;
+    for (int o = op % pe->nops; o >= pe->progress[j]; o--, op--) {
+        if (value <= pe->tail[op]) return 1;
+        if (pe->head[op] + pe->len[op] + value > pe->ub) return 0;
+        if (!trail_set(pe, &pe->tail[op], value)) return 0;
+        pe->dirty[pe->mach[op]] = 1;
+        value += pe->len[op];
+    }
+    return 1;
+}
+
+static int compare_sort_key(const void *a, const void *b) {
+    const PropSortKey *x = (const PropSortKey*)a, *y = (const PropSortKey*)b;
+    if (x->key != y->key) return x->key < y->key ? -1 : 1;
+    return x->task - y->task;
+}
+
+// Task indices 0..n-1 into idx, ascending by key (ties by index), in O(n log n)
+static void sort_tasks(PropEngine *pe, int *idx, int n, const int *key) {
+    for (int i = 0; i < n; i++) {
+        pe->sort_keys[i].key = key[i];
+        pe->sort_keys[i].task = i;
+    }
+    qsort(pe->sort_keys, n, sizeof(PropSortKey), compare_sort_key);
+    for (int i = 0; i < n; i++) idx[i] = pe->sort_keys[i].task;
+}
+
+static void tree_pull(PropEngine *pe, int k) {
+    int l = 2 * k, r = 2 * k + 1;
+    pe->sum_p[k] = pe->sum_p[l] + pe->sum_p[r];
+    pe->ect[k] = pe->ect[r] > pe->ect[l] + pe->sum_p[r] ? pe->ect[r] : pe->ect[l] + pe->sum_p[r];
+    if (pe->sum_p_bar[l] + pe->sum_p[r] >= pe->sum_p[l] + pe->sum_p_bar[r]) {
+        pe->sum_p_bar[k] = pe->sum_p_bar[l] + pe->sum_p[r];
+        pe->resp_sum[k] = pe->resp_sum[l];
+    } else {
+        pe->sum_p_bar[k] = pe->sum_p[l] + pe->sum_p_bar[r];
+        pe->resp_sum[k] = pe->resp_sum[r];
+    }
+    int a = pe->ect_bar[r], b = pe->ect[l] + pe->sum_p_bar[r], c = pe->ect_bar[l] + pe->sum_p[r];
+    if (a >= b && a >= c) {
+        pe->ect_bar[k] = a;
+        pe->resp_ect[k] = pe->resp_ect[r];
+    } else if (b >= c) {
+        pe->ect_bar[k] = b;
+        pe->resp_ect[k] = pe->resp_sum[r];
+    } else {
+        pe->ect_bar[k] = c;
+        pe->resp_ect[k] = pe->resp_ect[l];
+    }
+}
+
+// Leaf states: 0 = empty, 1 = in Theta, 2 = in Lambda (gray)
+static void tree_set_leaf(PropEngine *pe, int rank, int task, int state, int rebuild) {
+    int k = pe->tree_size + rank;
+    if (state == 0) {
+        pe->sum_p[k] = 0; pe->ect[k] = NEG_INF; pe->sum_p_bar[k] = 0; pe->ect_bar[k] = NEG_INF;
+        pe->resp_sum[k] = -1; pe->resp_ect[k] = -1;
+    } else if (state == 1) {
+        pe->sum_p[k] = pe->p[task]; pe->ect[k] = pe->est[task] + pe->p[task];
+        pe->sum_p_bar[k] = pe->sum_p[k]; pe->ect_bar[k] = pe->ect[k];
+        pe->resp_sum[k] = -1; pe->resp_ect[k] = -1;
+    } else {
+        pe->sum_p[k] = 0; pe->ect[k] = NEG_INF;
+        pe->sum_p_bar[k] = pe->p[task]; pe->ect_bar[k] = pe->est[task] + pe->p[task];
+        pe->resp_sum[k] = task; pe->resp_ect[k] = task;
+    }
+    if (!rebuild) return;
+    for (k /= 2; k >= 1; k /= 2) tree_pull(pe, k);
+}
+
+static void tree_reset(PropEngine *pe, int n, int state) {
+    for (int r = 0; r < pe->tree_size; r++) tree_set_leaf(pe, r, r < n ? pe->order[r] : -1, r < n ? state : 0, 0);
+    for (int k = pe->tree_size - 1; k >= 1; k--) tree_pull(pe, k);
+}
+
+// Edge-finding (heads into new_est) and not-last (latest completions into new_lct) on the
+// n tasks in est/lct/p. Returns 0 if the tasks cannot fit their windows.
+static int filter_unary(PropEngine *pe, int n) {
+    for (int i = 0; i < n; i++) {
+        pe->new_est[i] = pe->est[i];
+        pe->new_lct[i] = pe->lct[i];
+        pe->in_theta[i] = 0;
+    }
+    sort_tasks(pe, pe->order, n, pe->est);          // Leaves in est order
+    for (int r = 0; r < n; r++) pe->rank[pe->order[r]] = r;
+    sort_tasks(pe, pe->order2, n, pe->lct);         // Ascending lct
+
+    // Edge-finding: walk lct downwards, gray tasks that would end the set too late must
+    // come after all of it
+    tree_reset(pe, n, 1);
+    for (int k = n - 1; k >= 0; k--) {
+        int j = pe->order2[k];
+        if (pe->ect[1] > pe->lct[j]) return 0;
+        if (k == 0) break;
+        tree_set_leaf(pe, pe->rank[j], j, 2, 1);
+        int next = pe->order2[k - 1];
+        while (pe->ect_bar[1] > pe->lct[next] && pe->resp_ect[1] >= 0) {
+            int i = pe->resp_ect[1];
+            if (pe->ect[1] > pe->new_est[i]) pe->new_est[i] = pe->ect[1];
+            tree_set_leaf(pe, pe->rank[i], i, 0, 1);
+        }
+    }
+
+    // Not-last: Theta holds the tasks that must start before lct_i; if they cannot all end
+    // before i starts, i ends before the latest start among them
+    for (int i = 0; i < n; i++) pe->lct[i] -= pe->p[i];   // Temporarily lst, for the queue order
+    sort_tasks(pe, pe->order, n, pe->lct);
+    for (int i = 0; i < n; i++) pe->lct[i] += pe->p[i];
+    int *queue = pe->order, q = 0, last = -1;
+    for (int r = 0; r < pe->tree_size; r++) tree_set_leaf(pe, r, -1, 0, 0);
+    for (int k = pe->tree_size - 1; k >= 1; k--) tree_pull(pe, k);
+    for (int k = 0; k < n; k++) {
+        int i = pe->order2[k];
+        while (q < n && pe->lct[i] > pe->lct[queue[q]] - pe->p[queue[q]]) {
+            last = queue[q++];
+            tree_set_leaf(pe, pe->rank[last], last, 1, 1);
+            pe->in_theta[last] = 1;
+        }
+        if (last < 0) continue;
+        if (pe->in_theta[i]) tree_set_leaf(pe, pe->rank[i], i, 0, 1);
+        if (pe->ect[1] > pe->lct[i] - pe->p[i]) {
+            int lst = pe->lct[last] - pe->p[last];
+            if (lst < pe->new_lct[i]) pe->new_lct[i] = lst;
+        }
+        if (pe->in_theta[i]) tree_set_leaf(pe, pe->rank[i], i, 1, 1);
+    }
+    return 1;
+}
+
+// Filter the unscheduled operations of one machine in both time directions
+static int propagate_machine(PropEngine *pe, int m) {
+    int n = 0;
+    for (int k = 0; k < pe->mach_count[m]; k++) {
+        int op = pe->mach_ops[pe->mach_first[m] + k];
+        if (op % pe->nops < pe->progress[op / pe->nops]) continue;
+        pe->task_op[n] = op;
+        pe->est[n] = pe->head[op];
+        pe->lct[n] = pe->ub - pe->tail[op];
+        pe->p[n] = pe->len[op];
+        if (pe->est[n] + pe->p[n] > pe->lct[n]) return 0;
+        n++;
+    }
+    if (n <= 1) return 1;
+    pe->filter_calls++;
+
+    if (!filter_unary(pe, n)) return 0;
+    // Mirror: time runs backwards, heads become tails. Edge-finding there tightens the
+    // tails, not-last there is not-first on the original machine.
+    for (int i = 0; i < n; i++) {
+        int est = pe->new_est[i], lct = pe->new_lct[i];
+        pe->est[i] = -lct;
+        pe->lct[i] = -est;
+    }
+    if (!filter_unary(pe, n)) return 0;
+    for (int i = 0; i < n; i++) {
+        int op = pe->task_op[i];
+        if (!raise_head(pe, op, -pe->new_lct[i])) return 0;
+        if (!raise_tail(pe, op, pe->ub + pe->new_est[i])) return 0;
+    }
+    return 1;
+}
+
+// Place the next operation of a job at 'start' (as chosen by the search). Fails when this
+// contradicts the windows, i.e. no schedule <= ub extends the current one this way, or when
+// out_of_memory is set.
+int prop_schedule(PropEngine *pe, int job, int start) {
+    int o = pe->progress[job];
+    if (o >= pe->nops) return 0;
+    int op = job * pe->nops + o;
+    if (start < pe->head[op] || start + pe->len[op] + pe->tail[op] > pe->ub) return 0;
+    int m = pe->mach[op], end = start + pe->len[op];
+    if (!trail_set(pe, &pe->head[op], start) || !trail_set(pe, &pe->progress[job], o + 1) ||
+        !trail_set(pe, &pe->mach_ready[m], end)) {
+        return 0;
+    }
+    pe->dirty[m] = 1;
+    for (int k = 0; k < pe->mach_count[m]; k++) {
+        int other = pe->mach_ops[pe->mach_first[m] + k];
+        if (other % pe->nops < pe->progress[other / pe->nops]) continue;
+        if (!raise_head(pe, other, end)) return 0;
+    }
+    if (o + 1 < pe->nops && !raise_head(pe, op + 1, end)) return 0;
+    return 1;
+}
+
+// Filter dirty machines until nothing changes (or the round limit is hit; the remaining
+// dirty machines are then handled on the next call). Returns 0 on a dead end, or when
+// out_of_memory is set.
+int prop_propagate(PropEngine *pe) {
+    int rounds = MAX_ROUNDS_PER_MACHINE * pe->nmachs;
+    for (int changed = 1; changed && rounds > 0;) {
+        changed = 0;
+        for (int m = 0; m < pe->nmachs && rounds > 0; m++) {
+            if (!pe->dirty[m]) continue;
+            pe->dirty[m] = 0;
+            changed = 1;
+            rounds--;
+            if (!propagate_machine(pe, m)) {
+                if (!pe->out_of_memory) pe->prunes++;
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// Head + body + tail over the unscheduled operations, and the scheduled machine ends
+int prop_lower_bound(const PropEngine *pe) {
+    int bound = 0;
+    for (int m = 0; m < pe->nmachs; m++) {
+        if (pe->mach_ready[m] > bound) bound = pe->mach_ready[m];
+    }
+    for (int j = 0; j < pe->njobs; j++) {
+        for (int o = pe->progress[j]; o < pe->nops; o++) {
+            int op = j * pe->nops + o;
+            int value = pe->head[op] + pe->len[op] + pe->tail[op];
+            if (value > bound) bound = value;
+        }
+    }
+    return bound;
+}
+
+// Can the next operation of the job go before every other unscheduled operation of its
+// machine? No if some operation would then miss its window (a fixed disjunction).
+int prop_can_be_next(const PropEngine *pe, int job) {
+    int o = pe->progress[job];
+    if (o >= pe->nops) return 0;
+    int op = job * pe->nops + o;
+    int m = pe->mach[op];
+    int end = pe->head[op] + pe->len[op];
+    for (int k = 0; k < pe->mach_count[m]; k++) {
+        int other = pe->mach_ops[pe->mach_first[m] + k];
+        if (other == op || other % pe->nops < pe->progress[other / pe->nops]) continue;
+        int start = end > pe->head[other] ? end : pe->head[other];
+        if (start + pe->len[other] + pe->tail[other] > pe->ub) return 0;
+    }
+    return 1;
+}
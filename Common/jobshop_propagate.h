@@ -0,0 +1,64 @@
+// jobshop_propagate.h
+// Constraint propagation for the Branch & Bound searches. Keeps a head (earliest start) and a
+// tail (work that must follow the operation's completion) for every unscheduled operation and
+// tightens them per machine with Theta-tree edge-finding and not-first/not-last. Changes are
+// recorded on a trail, so a depth-first search backtracks by restoring a trail mark.
+#ifndef JOBSHOP_PROPAGATE_H
+#define JOBSHOP_PROPAGATE_H
+
+#include "jobshop_common.h"
+
+typedef struct {
+    int *addr;
+    int old_value;
+} PropTrailEntry;
+
+typedef struct {
+    int key;
+    int task;
+} PropSortKey;
+
+// Per-thread propagation state; create one engine per search thread
+typedef struct {
+    int njobs;
+    int nops;
+    int nmachs;
+    int ub;                     // Target makespan: only schedules <= ub are kept
+    // Operation data, indexed [job * nops + op]
+    int *mach;
+    int *len;
+    int *head;                  // Trailed
+    int *tail;                  // Trailed
+    int progress[JMAX];         // Next unscheduled operation per job (trailed)
+    int mach_ready[MMAX];       // End of the last scheduled operation per machine (trailed)
+    // Operations of each machine: mach_ops[mach_first[m] .. mach_first[m] + mach_count[m])
+    int *mach_ops;
+    int mach_first[MMAX];
+    int mach_count[MMAX];
+    int dirty[MMAX];            // Machines whose windows changed since they were filtered
+    // Trail
+    PropTrailEntry *trail;
+    int trail_len;
+    int trail_cap;
+    int out_of_memory;          // The trail could not grow: a 0 return is not a dead end
+    // Scratch for the per-machine filtering
+    int max_tasks;
+    int tree_size;
+    int *task_op, *est, *lct, *p, *new_est, *new_lct, *order, *order2, *rank, *in_theta;
+    int *sum_p, *ect, *sum_p_bar, *ect_bar, *resp_sum, *resp_ect;
+    PropSortKey *sort_keys;
+    long filter_calls;
+    long prunes;
+} PropEngine;
+
+PropEngine *prop_create(const Shop *shop);
+void prop_free(PropEngine *pe);
+int prop_trail_mark(const PropEngine *pe);
+void prop_backtrack(PropEngine *pe, int mark);
+void prop_set_upper_bound(PropEngine *pe, int ub);
+int prop_schedule(PropEngine *pe, int job, int start);
+int prop_propagate(PropEngine *pe);
+int prop_lower_bound(const PropEngine *pe);
+int prop_can_be_next(const PropEngine *pe, int job);
+
+#endif // JOBSHOP_PROPAGATE_H
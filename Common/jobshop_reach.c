@@ -0,0 +1,133 @@
+// Implementation of the bitset reachability of a DAG
+
+#include "jobshop_reach.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ROW(rows, g, u) ((rows) + (size_t)(u) * (g)->words)
+#define BIT_TEST(row, v) (((row)[(v) >> 6] >> ((v) & 63)) & 1u)
+#define BIT_SET(row, v) ((row)[(v) >> 6] |= (uint64_t)1 << ((v) & 63))
+
+ReachGraph *reach_create(int capacity) {
+    ReachGraph *g = (ReachGraph*)calloc(1, sizeof(ReachGraph));
+    if (!g) return NULL;
+    size_t words = ((size_t)capacity + 63) / 64;
+    g->capacity = capacity;
+    g->desc = (uint64_t*)malloc(sizeof(uint64_t) * words * capacity);
+    g->anc = (uint64_t*)malloc(sizeof(uint64_t) * words * capacity);
+    if (!g->desc || !g->anc) {
+        reach_free(g);
+        return NULL;
+    }
+    reach_clear(g, capacity);
+    return g;
+}
+
+void reach_free(ReachGraph *g) {
+    if (!g) return;
+    free(g->desc);
+    free(g->anc);
+    free(g);
+}
+
+// Start over with nodes isolated nodes (at most the capacity)
+void reach_clear(ReachGraph *g, int nodes) {
+    if (nodes > g->capacity) nodes = g->capacity;
+    g->nodes = nodes;
+    g->words = (nodes + 63) / 64;
+    memset(g->desc, 0, sizeof(uint64_t) * g->words * nodes);
+    memset(g->anc, 0, sizeof(uint64_t) * g->words * nodes);
+    g->arcs_added = 0;
+    g->arcs_rejected = 0;
+}
+
+// A path u -> v of at least one arc exists
+int reach_reaches(const ReachGraph *g, int u, int v) {
+    return (int)BIT_TEST(ROW(g->desc, g, u), v);
+}
+
+// Adding u -> v keeps the graph acyclic
+int reach_can_add(const ReachGraph *g, int u, int v) {
+    return u != v && !reach_reaches(g, v, u);
+}
+
+// Give row the bits of src plus bit, unless it has bit already: then it has all of src too,
+// by transitivity
+static void merge_row(const ReachGraph *g, uint64_t *row, const uint64_t *src, int bit) {
+    if (BIT_TEST(row, bit)) return;
+    for (int k = 0; k < g->words; k++) row[k] |= src[k];
+    BIT_SET(row, bit);
+}
+
+// merge_row into the row of node and of every node in members
+static void merge_rows(const ReachGraph *g, uint64_t *rows, int node, const uint64_t *members,
+                       const uint64_t *src, int bit) {
+    merge_row(g, ROW(rows, g, node), src, bit);
+    for (int w = 0; w < g->words; w++) {
+        uint64_t bits = members[w];
+        while (bits) {
+            merge_row(g, ROW(rows, g, w * 64 + __builtin_ctzll(bits)), src, bit);
+            bits &= bits - 1;
+        }
+    }
+}
+
+// Add the arc u -> v. Returns 1 when the graph stays acyclic (also when the arc was already
+// implied), 0 when v reaches u: the arc is then refused and nothing changes.
+int reach_add_arc(ReachGraph *g, int u, int v) {
+    if (!reach_can_add(g, u, v)) {
+        g->arcs_rejected++;
+        return 0;
+    }
+    if (reach_reaches(g, u, v)) return 1;
+    // u and its ancestors now reach v and its descendants. v is no ancestor of u and u no
+    // descendant of v, so the rows read here are not among the rows written.
+    merge_rows(g, g->desc, u, ROW(g->anc, g, u), ROW(g->desc, g, v), v);
+    merge_rows(g, g->anc, v, ROW(g->desc, g, v), ROW(g->anc, g, u), u);
+    g->arcs_added++;
+    return 1;
+}
+
+// Reorder a sequence of nodes so that no node comes after one it reaches, keeping the given
+// order wherever the graph leaves a choice: repeatedly take the first node no remaining one
+// reaches. Chaining the result with arcs then never closes a cycle. Returns the number of
+// nodes that moved, 0 in the usual case that the order already agrees with the graph.
+int reach_order_sequence(const ReachGraph *g, int *seq, int len) {
+    int consistent = 1;
+    for (int i = 0; i < len && consistent; i++) {
+        for (int k = i + 1; k < len; k++) {
+            if (reach_reaches(g, seq[k], seq[i])) {
+                consistent = 0;
+                break;
+            }
+        }
+    }
+    if (consistent) return 0;
+
+    int *order = (int*)malloc(sizeof(int) * len * 2);
+    if (!order) return 0;
+    int *taken = order + len;
+    for (int i = 0; i < len; i++) taken[i] = 0;
+    for (int pos = 0; pos < len; pos++) {
+        int pick = -1;
+        for (int i = 0; i < len && pick < 0; i++) {
+            if (taken[i]) continue;
+            pick = i;
+            for (int k = 0; k < len; k++) {
+                if (!taken[k] && k != i && reach_reaches(g, seq[k], seq[i])) {
+                    pick = -1;
+                    break;
+                }
+            }
+        }
+        taken[pick] = 1; // The graph is acyclic, so some remaining node has no remaining ancestor
+        order[pos] = seq[pick];
+    }
+    int moved = 0;
+    for (int i = 0; i < len; i++) {
+        if (seq[i] != order[i]) moved++;
+        seq[i] = order[i];
+    }
+    free(order);
+    return moved;
+}
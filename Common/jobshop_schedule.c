@@ -0,0 +1,301 @@
+// Implementation of schedule helpers shared by the improvement drivers
+
+#include "jobshop_schedule.h"
+#include "jobshop_timeline.h"
+#include <stdlib.h>
+
+int schedule_makespan(const Shop *shop) {
+    int makespan = 0;
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int o = 0; o < shop->nops; o++) {
+            int end = shop->plan[j][o].stime + shop->plan[j][o].len;
+            if (end > makespan) makespan = end;
+        }
+    }
+    return makespan;
+}
+
+#define KEY_OP_BITS 25                                   // Up to 2^25 operations per schedule
+#define KEY_OP_MASK ((1ull << KEY_OP_BITS) - 1)
+#define KEY_MACH_SHIFT (32 + KEY_OP_BITS)                  // Leaves 7 bits, enough for MMAX
+
+ScheduleView schedule_view(const Shop *shop) {
+    ScheduleView view = { &shop->plan[0][0], OPMAX, shop->njobs, shop->nops };
+    return view;
+}
+
+static const Step *view_step(const ScheduleView *view, int op) {
+    return &view->steps[(op / view->nops) * view->stride + op % view->nops];
+}
+
+// Sort key (machine, start, op index) packed so qsort needs no shared context
+static unsigned long long machine_order_key(const ScheduleView *view, int op) {
+    const Step *step = view_step(view, op);
+    return ((unsigned long long)step->mach << KEY_MACH_SHIFT) |
+           ((unsigned long long)(unsigned int)step->stime << KEY_OP_BITS) | (unsigned long long)op;
+}
+
+static int compare_keys(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long*)a, y = *(const unsigned long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Machine successor of each operation from the start times, O(n log n). in_degree counts
+// the job and machine predecessors of each operation; order is left sorted by machine and start.
+static void machine_arcs(const ScheduleView *view, unsigned long long *order, int *mach_next, int *in_degree) {
+    int n = view->njobs * view->nops;
+    for (int i = 0; i < n; i++) {
+        order[i] = machine_order_key(view, i);
+        mach_next[i] = -1;
+        in_degree[i] = (i % view->nops) > 0 ? 1 : 0; // Job predecessor
+    }
+    qsort(order, n, sizeof(unsigned long long), compare_keys);
+    for (int i = 0; i + 1 < n; i++) {
+        int u = (int)(order[i] & KEY_OP_MASK), v = (int)(order[i + 1] & KEY_OP_MASK);
+        if ((order[i] >> KEY_MACH_SHIFT) == (order[i + 1] >> KEY_MACH_SHIFT)) {
+            mach_next[u] = v;
+            in_degree[v]++;
+        }
+    }
+}
+
+// Keep the machine sequences implied by the current start times and move every
+// operation to its earliest start (semi-active schedule). Returns the new makespan,
+// or -1 if the sequences contradict the job order.
+int retime_semi_active(Shop *shop) {
+    int n = shop->njobs * shop->nops;
+    unsigned long long *order = (unsigned long long*)malloc(sizeof(unsigned long long) * n);
+    int *mach_next = (int*)malloc(sizeof(int) * n);
+    int *in_degree = (int*)malloc(sizeof(int) * n);
+    int *queue = (int*)malloc(sizeof(int) * n);
+    int *start = (int*)malloc(sizeof(int) * n);
+    if (!order || !mach_next || !in_degree || !queue || !start) {
+        free(order); free(mach_next); free(in_degree); free(queue); free(start);
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) start[i] = 0;
+    ScheduleView view = schedule_view(shop);
+    machine_arcs(&view, order, mach_next, in_degree);
+
+    // Longest path over job and machine arcs (Kahn)
+    int head = 0, tail = 0, makespan = 0;
+    for (int i = 0; i < n; i++) if (in_degree[i] == 0) queue[tail++] = i;
+    while (head < tail) {
+        int u = queue[head++];
+        int end = start[u] + shop->plan[u / shop->nops][u % shop->nops].len;
+        if (end > makespan) makespan = end;
+        int succ[2] = { (u % shop->nops) + 1 < shop->nops ? u + 1 : -1, mach_next[u] };
+        for (int s = 0; s < 2; s++) {
+            int v = succ[s];
+            if (v < 0) continue;
+            if (start[v] < end) start[v] = end;
+            if (--in_degree[v] == 0) queue[tail++] = v;
+        }
+    }
+    if (tail == n) {
+        for (int i = 0; i < n; i++) shop->plan[i / shop->nops][i % shop->nops].stime = start[i];
+    } else {
+        makespan = -1;
+    }
+
+    free(order); free(mach_next); free(in_degree); free(queue); free(start);
+    return makespan;
+}
+
+// Global left shift of a complete schedule: every operation, in start time order, moves to the earliest idle gap
+// of its machine after its job predecessor ends, and sweeps repeat until nothing moves
+// (or max_sweeps, 0 = no limit), or until the makespan is at most target (a lower bound,
+// 0 = none). An operation may jump ahead of others on its machine;
+// no start time ever increases, so the makespan never gets worse. Each sweep costs
+// O(n log n) for the sort and the gap queries, plus for every operation that moves the
+// number of operations it jumps ahead of on its machine (at most ops_per_machine).
+// Returns the new makespan, or -1 when out of memory before the first sweep (the schedule
+// is then unchanged).
+int schedule_left_shift(Shop *shop, int max_sweeps, int target, int *sweeps_done) {
+    int n = shop->njobs * shop->nops;
+    unsigned long long *order = (unsigned long long*)malloc(sizeof(unsigned long long) * n);
+    ShopTimeline *timelines = (ShopTimeline*)malloc(sizeof(ShopTimeline) * shop->nmachs);
+    if (sweeps_done) *sweeps_done = 0;
+    if (!order || !timelines) {
+        free(order); free(timelines);
+        return -1;
+    }
+    for (int m = 0; m < shop->nmachs; m++) timeline_init(&timelines[m]);
+
+    int ok = 1, moved = 1, sweeps = 0;
+    while (ok && moved && (max_sweeps <= 0 || sweeps < max_sweeps)) {
+        // Start time order; job predecessors come first even at equal starts (zero lengths)
+        for (int i = 0; i < n; i++) {
+            order[i] = ((unsigned long long)(unsigned int)shop->plan[i / shop->nops][i % shop->nops].stime << 32) |
+                       (unsigned int)i;
+        }
+        qsort(order, n, sizeof(unsigned long long), compare_keys);
+        for (int m = 0; m < shop->nmachs; m++) timeline_clear(&timelines[m]);
+        for (int k = 0; k < n && ok; k++) {
+            const Step *st = &shop->plan[(order[k] & 0xffffffffu) / shop->nops][(order[k] & 0xffffffffu) % shop->nops];
+            ok = timeline_append(&timelines[st->mach], st->stime, st->stime + st->len);
+        }
+        if (!ok) break;
+        for (int m = 0; m < shop->nmachs; m++) timeline_finish(&timelines[m]);
+
+        moved = 0;
+        sweeps++;
+        for (int k = 0; k < n; k++) {
+            int i = (int)(order[k] & 0xffffffffu);
+            int j = i / shop->nops, o = i % shop->nops;
+            Step *st = &shop->plan[j][o];
+            int ready = o > 0 ? shop->plan[j][o - 1].stime + shop->plan[j][o - 1].len : 0;
+            if (ready >= st->stime) continue; // Already as early as its job allows
+            // Its own slot counts as idle, so start <= stime
+            int start = timeline_move_earliest(&timelines[st->mach], st->stime, st->stime + st->len, ready);
+            if (start >= 0 && start < st->stime) {
+                st->stime = start;
+                moved = 1;
+            }
+        }
+        if (moved && target > 0 && schedule_makespan(shop) <= target) break; // Provably optimal
+    }
+    for (int m = 0; m < shop->nmachs; m++) timeline_free(&timelines[m]);
+    free(timelines);
+    free(order);
+    if (sweeps_done) *sweeps_done = sweeps;
+    return sweeps > 0 ? schedule_makespan(shop) : -1;
+}
+
+static void note_violation(ScheduleCheck *check, int job, int op) {
+    if (check->first_job < 0) {
+        check->first_job = job;
+        check->first_op = op;
+    }
+}
+
+// Check a complete schedule against the instance: every operation started, job order kept and
+// no two operations overlapping on a machine, in O(n log n). Returns 1 when it is feasible.
+int schedule_view_validate(const ScheduleView *view, ScheduleCheck *check) {
+    int n = view->njobs * view->nops;
+    memset(check, 0, sizeof(*check));
+    check->first_job = -1;
+    check->first_op = -1;
+    for (int j = 0; j < view->njobs; j++) {
+        const Step *job = &view->steps[j * view->stride];
+        for (int o = 0; o < view->nops; o++) {
+            const Step *step = &job[o];
+            if (step->stime < 0) {
+                check->unscheduled++;
+                note_violation(check, j, o);
+                continue;
+            }
+            if (step->stime + step->len > check->makespan) check->makespan = step->stime + step->len;
+            if (o > 0 && job[o - 1].stime >= 0 && step->stime < job[o - 1].stime + job[o - 1].len) {
+                check->precedence_violations++;
+                note_violation(check, j, o);
+            }
+        }
+    }
+    if (check->unscheduled) return 0; // Machine order is undefined without every start time
+    unsigned long long *order = (unsigned long long*)malloc(sizeof(unsigned long long) * n);
+    if (!order) return 0;
+    for (int i = 0; i < n; i++) order[i] = machine_order_key(view, i);
+    qsort(order, n, sizeof(unsigned long long), compare_keys);
+    for (int i = 0; i + 1 < n; i++) {
+        if ((order[i] >> KEY_MACH_SHIFT) != (order[i + 1] >> KEY_MACH_SHIFT)) continue;
+        int u = (int)(order[i] & KEY_OP_MASK), v = (int)(order[i + 1] & KEY_OP_MASK);
+        const Step *a = view_step(view, u);
+        const Step *b = view_step(view, v);
+        if (b->stime < a->stime + a->len) {
+            check->overlap_violations++;
+            note_violation(check, v / view->nops, v % view->nops);
+        }
+    }
+    free(order);
+    return check->precedence_violations == 0 && check->overlap_violations == 0;
+}
+
+int schedule_validate(const Shop *shop, ScheduleCheck *check) {
+    ScheduleView view = schedule_view(shop);
+    return schedule_view_validate(&view, check);
+}
+
+// Critical path of a feasible schedule: the longest chain of job and machine arcs of the
+// semi-active schedule with the same machine sequences. path (njobs * nops entries) receives
+// the operations (job * nops + op) from the first to the last; returns its length, -1 on error.
+// The path's total processing time is the semi-active makespan, at most the schedule's.
+int schedule_view_critical_path(const ScheduleView *view, int *path) {
+    int n = view->njobs * view->nops;
+    unsigned long long *order = (unsigned long long*)malloc(sizeof(unsigned long long) * n);
+    int *mach_next = (int*)malloc(sizeof(int) * n);
+    int *in_degree = (int*)malloc(sizeof(int) * n);
+    int *queue = (int*)malloc(sizeof(int) * n);
+    int *start = (int*)malloc(sizeof(int) * n);
+    int *pred = (int*)malloc(sizeof(int) * n);
+    if (!order || !mach_next || !in_degree || !queue || !start || !pred) {
+        free(order); free(mach_next); free(in_degree); free(queue); free(start); free(pred);
+        return -1;
+    }
+    machine_arcs(view, order, mach_next, in_degree);
+    for (int i = 0; i < n; i++) {
+        start[i] = 0;
+        pred[i] = -1;
+    }
+    int head = 0, tail = 0, last = -1, makespan = -1;
+    for (int i = 0; i < n; i++) if (in_degree[i] == 0) queue[tail++] = i;
+    while (head < tail) {
+        int u = queue[head++];
+        int end = start[u] + view_step(view, u)->len;
+        if (end > makespan) {
+            makespan = end;
+            last = u;
+        }
+        int succ[2] = { (u % view->nops) + 1 < view->nops ? u + 1 : -1, mach_next[u] };
+        for (int s = 0; s < 2; s++) {
+            int v = succ[s];
+            if (v < 0) continue;
+            if (start[v] < end || pred[v] < 0) {
+                if (start[v] < end) start[v] = end;
+                pred[v] = u;
+            }
+            if (--in_degree[v] == 0) queue[tail++] = v;
+        }
+    }
+    int len = -1;
+    if (tail == n && last >= 0) {
+        // Walk back over the predecessors that fixed each start, then reverse
+        len = 0;
+        for (int u = last; u >= 0; u = start[u] > 0 ? pred[u] : -1) path[len++] = u;
+        for (int i = 0; i < len / 2; i++) {
+            int t = path[i];
+            path[i] = path[len - 1 - i];
+            path[len - 1 - i] = t;
+        }
+    }
+    free(order); free(mach_next); free(in_degree); free(queue); free(start); free(pred);
+    return len;
+}
+
+int schedule_critical_path(const Shop *shop, int *path) {
+    ScheduleView view = schedule_view(shop);
+    return schedule_view_critical_path(&view, path);
+}
+
+// Split a critical path into blocks: maximal runs of consecutive operations on one machine.
+// block_first / block_len (len entries each) receive the path index and size of every block.
+int schedule_view_critical_blocks(const ScheduleView *view, const int *path, int len, int *block_first, int *block_len) {
+    int nblocks = 0;
+    for (int i = 0; i < len; i++) {
+        int mach = view_step(view, path[i])->mach;
+        int prev_mach = i > 0 ? view_step(view, path[i - 1])->mach : -1;
+        if (i == 0 || mach != prev_mach) {
+            block_first[nblocks] = i;
+            block_len[nblocks] = 0;
+            nblocks++;
+        }
+        block_len[nblocks - 1]++;
+    }
+    return nblocks;
+}
+
+int schedule_critical_blocks(const Shop *shop, const int *path, int len, int *block_first, int *block_len) {
+    ScheduleView view = schedule_view(shop);
+    return schedule_view_critical_blocks(&view, path, len, block_first, block_len);
+}
@@ -0,0 +1,40 @@
+// jobshop_schedule.h
+// Helpers that operate on a complete schedule stored in Shop.plan[][].stime
+#ifndef JOBSHOP_SCHEDULE_H
+#define JOBSHOP_SCHEDULE_H
+
+#include "jobshop_common.h"
+
+// Outcome of schedule_validate
+typedef struct {
+    int makespan;                  // Recomputed from the start times
+    int unscheduled;               // Operations without a start time
+    int precedence_violations;     // Operations starting before their job predecessor ends
+    int overlap_violations;        // Machine neighbours that overlap
+    int first_job;                 // First offending operation, -1 if none
+    int first_op;
+} ScheduleCheck;
+
+// Flat, read-only view of a schedule: operation o of job j is steps[j * stride + o]. A Shop
+// gives the view over its plan (stride OPMAX); the validator points one at arrays sized to
+// the instance, so schedules with more than JMAX jobs can be checked too.
+typedef struct {
+    const Step *steps;
+    int stride;
+    int njobs;
+    int nops;
+} ScheduleView;
+
+ScheduleView schedule_view(const Shop *shop);
+int schedule_view_validate(const ScheduleView *view, ScheduleCheck *check);
+int schedule_view_critical_path(const ScheduleView *view, int *path);
+int schedule_view_critical_blocks(const ScheduleView *view, const int *path, int len, int *block_first, int *block_len);
+
+int schedule_makespan(const Shop *shop);
+int retime_semi_active(Shop *shop);
+int schedule_left_shift(Shop *shop, int max_sweeps, int target, int *sweeps_done);
+int schedule_validate(const Shop *shop, ScheduleCheck *check);
+int schedule_critical_path(const Shop *shop, int *path);
+int schedule_critical_blocks(const Shop *shop, const int *path, int len, int *block_first, int *block_len);
+
+#endif // JOBSHOP_SCHEDULE_H
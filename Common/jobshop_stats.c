@@ -0,0 +1,100 @@
+// Implementation of the solve counters, their merge and their JSON form
+
+#include "jobshop_common.h"
+#include "jobshop_stats.h"
+#ifdef _WIN32
+#define PSAPI_VERSION 2 // GetProcessMemoryInfo from kernel32, no -lpsapi
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+void stats_reset(SolverStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+void stats_merge(SolverStats *into, const SolverStats *from) {
+    into->nodes_explored += from->nodes_explored;
+    into->nodes_generated += from->nodes_generated;
+    into->pruned_bound += from->pruned_bound;
+    into->pruned_overflow += from->pruned_overflow;
+    into->bound_evals += from->bound_evals;
+    into->incumbent_updates += from->incumbent_updates;
+    into->sb_iterations += from->sb_iterations;
+    into->longest_path_runs += from->longest_path_runs;
+    into->sb_sequence_repairs += from->sb_sequence_repairs;
+    into->left_shift_sweeps += from->left_shift_sweeps;
+    into->left_shift_gain += from->left_shift_gain;
+    if (from->bb_kernel_dim > into->bb_kernel_dim) {
+        into->bb_kernel_dim = from->bb_kernel_dim;
+        into->bb_node_bytes = from->bb_node_bytes;
+    }
+    for (int p = 0; p < STATS_PHASES; p++) into->phase_seconds[p] += from->phase_seconds[p];
+    if (from->peak_rss_kb > into->peak_rss_kb) into->peak_rss_kb = from->peak_rss_kb;
+}
+
+const char *stats_phase_name(int phase) {
+    switch (phase) {
+        case STATS_PHASE_SB_EST: return "sb_est";
+        case STATS_PHASE_SB_TAIL: return "sb_tail";
+        case STATS_PHASE_SB_MACHINE_EVAL: return "sb_machine_eval";
+        case STATS_PHASE_SB_COMMIT: return "sb_commit";
+        case STATS_PHASE_SB_FINAL: return "sb_final_schedule";
+        case STATS_PHASE_SB_LEFT_SHIFT: return "sb_left_shift";
+        case STATS_PHASE_BB_SEARCH: return "bb_search";
+        default: return "unknown";
+    }
+}
+
+// Peak resident set size of the process in KB, 0 if unknown
+long stats_peak_rss_kb(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return (long)(pmc.PeakWorkingSetSize / 1024);
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (long)(usage.ru_maxrss / 1024); // Bytes on macOS
+#else
+    return (long)usage.ru_maxrss;
+#endif
+#endif
+}
+
+// Start of a timed phase: the current time, or 0 when no statistics are collected
+double stats_clock(const SolverStats *stats) {
+    return stats ? wall_time_seconds() : 0.0;
+}
+
+// Charge the time since `since` to a phase and return the current time for the next one
+double stats_phase(SolverStats *stats, int phase, double since) {
+    if (!stats) return 0.0;
+    double now = wall_time_seconds();
+    stats->phase_seconds[phase] += now - since;
+    return now;
+}
+
+// Write the counters as the members of a JSON object (no braces), one per line
+void stats_write_json(FILE *f, const SolverStats *stats, const char *indent) {
+    fprintf(f, "%s\"nodes_explored\": %ld,\n", indent, stats->nodes_explored);
+    fprintf(f, "%s\"nodes_generated\": %ld,\n", indent, stats->nodes_generated);
+    fprintf(f, "%s\"pruned_bound\": %ld,\n", indent, stats->pruned_bound);
+    fprintf(f, "%s\"pruned_overflow\": %ld,\n", indent, stats->pruned_overflow);
+    fprintf(f, "%s\"bound_evals\": %ld,\n", indent, stats->bound_evals);
+    fprintf(f, "%s\"incumbent_updates\": %ld,\n", indent, stats->incumbent_updates);
+    fprintf(f, "%s\"sb_iterations\": %ld,\n", indent, stats->sb_iterations);
+    fprintf(f, "%s\"longest_path_runs\": %ld,\n", indent, stats->longest_path_runs);
+    fprintf(f, "%s\"sb_sequence_repairs\": %ld,\n", indent, stats->sb_sequence_repairs);
+    fprintf(f, "%s\"left_shift_sweeps\": %ld,\n", indent, stats->left_shift_sweeps);
+    fprintf(f, "%s\"left_shift_gain\": %ld,\n", indent, stats->left_shift_gain);
+    fprintf(f, "%s\"bb_kernel_dim\": %d,\n", indent, stats->bb_kernel_dim);
+    fprintf(f, "%s\"bb_node_bytes\": %d,\n", indent, stats->bb_node_bytes);
+    fprintf(f, "%s\"phase_seconds\": {", indent);
+    for (int p = 0; p < STATS_PHASES; p++) {
+        fprintf(f, "%s\"%s\": %.6f", p ? ", " : "", stats_phase_name(p), stats->phase_seconds[p]);
+    }
+    fprintf(f, "},\n");
+    fprintf(f, "%s\"peak_rss_kb\": %ld\n", indent, stats->peak_rss_kb);
+}
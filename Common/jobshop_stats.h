@@ -0,0 +1,47 @@
+// jobshop_stats.h
+// Hot-path counters of one solve. Every search thread counts into its own SolverStats and
+// merges it into the caller's at the end, so the counters cost no synchronization while
+// the search runs. Engines take an optional SolverStats pointer; NULL disables the timing.
+#ifndef JOBSHOP_STATS_H
+#define JOBSHOP_STATS_H
+
+#include <stdio.h>
+
+enum {
+    STATS_PHASE_SB_EST,            // Heads: longest path from the source
+    STATS_PHASE_SB_TAIL,           // Reverse graph and tails
+    STATS_PHASE_SB_MACHINE_EVAL,   // One-machine problems of the unsequenced machines
+    STATS_PHASE_SB_COMMIT,         // Fixing the bottleneck sequence in the graph
+    STATS_PHASE_SB_FINAL,          // Final heads and list schedule
+    STATS_PHASE_SB_LEFT_SHIFT,     // Compaction of the SB schedule
+    STATS_PHASE_BB_SEARCH,         // Depth-first search
+    STATS_PHASES
+};
+
+typedef struct {
+    long nodes_explored;           // B&B nodes taken off a stack
+    long nodes_generated;          // B&B children built
+    long pruned_bound;             // Nodes and children cut by the bound (or by propagation)
+    long pruned_overflow;          // Children dropped because the node stack was full
+    long bound_evals;              // Lower bound evaluations
+    long incumbent_updates;        // Improving schedules found
+    long sb_iterations;            // Bottleneck machines sequenced
+    long longest_path_runs;        // Head/tail recomputations on the disjunctive graph
+    long sb_sequence_repairs;      // Bottleneck sequences reordered so they close no cycle
+    long left_shift_sweeps;        // Compaction sweeps over the SB schedule
+    long left_shift_gain;          // Makespan removed by the compaction
+    int bb_kernel_dim;             // Jobs and machines the B&B node layout holds, 0 = no B&B ran
+    int bb_node_bytes;             // Size of one B&B node of that kernel
+    double phase_seconds[STATS_PHASES];
+    long peak_rss_kb;              // Of the whole process, filled in after the solve
+} SolverStats;
+
+void stats_reset(SolverStats *stats);
+void stats_merge(SolverStats *into, const SolverStats *from);
+const char *stats_phase_name(int phase);
+long stats_peak_rss_kb(void);
+double stats_clock(const SolverStats *stats);
+double stats_phase(SolverStats *stats, int phase, double since);
+void stats_write_json(FILE *f, const SolverStats *stats, const char *indent);
+
+#endif // JOBSHOP_STATS_H
@@ -0,0 +1,199 @@
+// Implementation of the per-machine interval timelines
+
+#include "jobshop_timeline.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define TIMELINE_MIN_CAP 16
+
+void timeline_init(ShopTimeline *tl) {
+    memset(tl, 0, sizeof(*tl));
+    tl->sorted = 1;
+}
+
+void timeline_free(ShopTimeline *tl) {
+    free(tl->items);
+    free(tl->gap);
+    timeline_init(tl);
+}
+
+// Forget every interval; the buffers are kept for the next schedule
+void timeline_clear(ShopTimeline *tl) {
+    tl->count = 0;
+    tl->sorted = 1; // Stale leaves are rewritten by the next insert or timeline_finish
+}
+
+static int grow(ShopTimeline *tl, int needed) {
+    if (needed <= tl->cap) return 1;
+    int cap = tl->cap > 0 ? tl->cap : TIMELINE_MIN_CAP;
+    while (cap < needed) cap *= 2;
+    TimelineInterval *items = (TimelineInterval*)realloc(tl->items, sizeof(TimelineInterval) * cap);
+    if (!items) return 0;
+    tl->items = items;
+    int *gap = (int*)realloc(tl->gap, sizeof(int) * 2 * cap);
+    if (!gap) return 0;
+    tl->gap = gap;
+    tl->cap = cap;
+    return 1;
+}
+
+// Recompute the leaves [from, to) and the inner nodes above them, level by level:
+// O(to - from + log cap)
+static void update_gaps(ShopTimeline *tl, int from, int to) {
+    if (to > tl->cap) to = tl->cap;
+    if (from >= to) return;
+    int *leaf = tl->gap + tl->cap;
+    for (int i = from; i < to; i++) {
+        if (i >= tl->count) leaf[i] = -1;
+        else leaf[i] = (i == 0) ? 0 : tl->items[i].start - tl->items[i - 1].end;
+    }
+    for (int lo = (tl->cap + from) / 2, hi = (tl->cap + to - 1) / 2; lo >= 1; lo /= 2, hi /= 2) {
+        for (int n = lo; n <= hi; n++) {
+            tl->gap[n] = tl->gap[2 * n] > tl->gap[2 * n + 1] ? tl->gap[2 * n] : tl->gap[2 * n + 1];
+        }
+    }
+}
+
+static void rebuild_gaps(ShopTimeline *tl) {
+    update_gaps(tl, 0, tl->cap);
+}
+
+// First interval index in [lo, hi) whose preceding gap is at least len, -1 if none
+static int first_gap(const ShopTimeline *tl, int node, int node_lo, int node_hi, int lo, int hi, int len) {
+    if (node_hi <= lo || node_lo >= hi || tl->gap[node] < len) return -1;
+    if (node_hi - node_lo == 1) return node_lo;
+    int mid = (node_lo + node_hi) / 2;
+    int found = first_gap(tl, 2 * node, node_lo, mid, lo, hi, len);
+    return found >= 0 ? found : first_gap(tl, 2 * node + 1, mid, node_hi, lo, hi, len);
+}
+
+// First interval that ends after ready
+static int first_ending_after(const ShopTimeline *tl, int ready) {
+    int lo = 0, hi = tl->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (tl->items[mid].end <= ready) lo = mid + 1; else hi = mid;
+    }
+    return lo;
+}
+
+// Index of the interval [start, end), -1 if it is not there
+static int find_interval(const ShopTimeline *tl, int start, int end) {
+    int lo = 0, hi = tl->count;
+    while (lo < hi) { // First interval starting at or after start
+        int mid = (lo + hi) / 2;
+        if (tl->items[mid].start < start) lo = mid + 1; else hi = mid;
+    }
+    while (lo < tl->count && tl->items[lo].start == start && tl->items[lo].end != end) lo++;
+    return (lo == tl->count || tl->items[lo].start != start) ? -1 : lo;
+}
+
+// Earliest start >= ready at which the machine is idle for len time units
+int timeline_earliest(const ShopTimeline *tl, int ready, int len) {
+    int lo = first_ending_after(tl, ready);
+    if (lo == tl->count || tl->items[lo].start >= ready + len) return ready;
+    // Every later gap starts after ready: take the first one that is long enough
+    int i = first_gap(tl, 1, 0, tl->cap, lo + 1, tl->count, len);
+    return i < 0 ? tl->items[tl->count - 1].end : tl->items[i - 1].end;
+}
+
+// Add an operation occupying [start, end); the machine must be idle there. Returns 0 when out of memory.
+int timeline_insert(ShopTimeline *tl, int start, int end) {
+    int old_cap = tl->cap;
+    if (!grow(tl, tl->count + 1)) return 0;
+    int lo = 0, hi = tl->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (tl->items[mid].start <= start) lo = mid + 1; else hi = mid;
+    }
+    memmove(&tl->items[lo + 1], &tl->items[lo], sizeof(TimelineInterval) * (tl->count - lo));
+    tl->items[lo].start = start;
+    tl->items[lo].end = end;
+    tl->count++;
+    if (tl->cap != old_cap) rebuild_gaps(tl);
+    else update_gaps(tl, lo, tl->count); // Leaves from lo on moved up by one
+    return 1;
+}
+
+// Take the operation occupying [start, end) off the machine. Returns 0 if it is not there.
+int timeline_remove(ShopTimeline *tl, int start, int end) {
+    int lo = find_interval(tl, start, end);
+    if (lo < 0) return 0;
+    memmove(&tl->items[lo], &tl->items[lo + 1], sizeof(TimelineInterval) * (tl->count - lo - 1));
+    tl->count--;
+    update_gaps(tl, lo, tl->count + 1); // Leaves from lo on moved down by one
+    return 1;
+}
+
+// Move the operation occupying [start, end) to the earliest start >= ready at which the
+// machine is idle for its length, its own slot counting as idle; it never moves later.
+// Only the intervals it jumps over shift, so the cost is O(log n) plus that number.
+// Returns the new start, -1 if the interval is not there.
+int timeline_move_earliest(ShopTimeline *tl, int start, int end, int ready) {
+    int p = find_interval(tl, start, end);
+    if (p < 0) return -1;
+    if (ready >= start) return start;
+    int len = end - start;
+    // Idle slots before p are the gaps the tree knows; the one around p is the gap before it
+    // joined with its own slot and so fits the operation from items[p - 1].end on
+    int new_start;
+    int lo = first_ending_after(tl, ready);
+    if (lo >= p || tl->items[lo].start >= ready + len) new_start = ready;
+    else {
+        int i = first_gap(tl, 1, 0, tl->cap, lo + 1, p, len);
+        new_start = i < 0 ? tl->items[p - 1].end : tl->items[i - 1].end;
+    }
+    if (new_start >= start) return start;
+    int q = p; // Position of the moved interval: after every interval starting at or before new_start
+    while (q > 0 && tl->items[q - 1].start > new_start) q--;
+    memmove(&tl->items[q + 1], &tl->items[q], sizeof(TimelineInterval) * (p - q));
+    tl->items[q].start = new_start;
+    tl->items[q].end = new_start + len;
+    update_gaps(tl, q, p + 2); // Leaves q..p+1: the moved one, the shifted ones and the one after p
+    return new_start;
+}
+
+// Block [start, end), merging it with the intervals it overlaps or touches
+int timeline_block(ShopTimeline *tl, int start, int end) {
+    if (end <= start) return 1;
+    int kept = 0;
+    for (int i = 0; i < tl->count; i++) {
+        TimelineInterval it = tl->items[i];
+        if (it.end >= start && it.start <= end) {
+            if (it.start < start) start = it.start;
+            if (it.end > end) end = it.end;
+        } else {
+            tl->items[kept++] = it;
+        }
+    }
+    tl->count = kept;
+    if (!timeline_insert(tl, start, end)) return 0;
+    rebuild_gaps(tl); // Merged intervals moved the ones before the insert position too
+    return 1;
+}
+
+// Bulk loading: append the intervals in any order, then call timeline_finish before querying
+int timeline_append(ShopTimeline *tl, int start, int end) {
+    if (!grow(tl, tl->count + 1)) return 0;
+    tl->items[tl->count].start = start;
+    tl->items[tl->count].end = end;
+    tl->count++;
+    tl->sorted = 0;
+    return 1;
+}
+
+static int compare_intervals(const void *a, const void *b) {
+    const TimelineInterval *x = (const TimelineInterval*)a, *y = (const TimelineInterval*)b;
+    return (x->start > y->start) - (x->start < y->start);
+}
+
+void timeline_finish(ShopTimeline *tl) {
+    if (tl->count == 0) return;
+    if (!tl->sorted) {
+        int in_order = 1; // Mostly the case: intervals arrive in start order
+        for (int i = 1; i < tl->count && in_order; i++) in_order = tl->items[i - 1].start <= tl->items[i].start;
+        if (!in_order) qsort(tl->items, tl->count, sizeof(TimelineInterval), compare_intervals);
+        tl->sorted = 1;
+    }
+    rebuild_gaps(tl);
+}
@@ -0,0 +1,43 @@
+// jobshop_timeline.h
+// Busy intervals of one machine with gap insertion: "earliest start >= ready at which the
+// machine is idle for len time units" is answered in O(log n) from a max-gap segment tree
+// over the sorted intervals, so list schedulers can place an operation into an idle gap
+// instead of only after the machine's last operation. The intervals are a sorted array, so an
+// insert or remove shifts the ones after it and updates their leaves and the tree paths above
+// them; timeline_move_earliest only shifts the intervals an operation jumps over. Blocked
+// windows (maintenance calendars) are busy intervals that belong to no operation.
+#ifndef JOBSHOP_TIMELINE_H
+#define JOBSHOP_TIMELINE_H
+
+typedef struct {
+    int start;
+    int end;
+} TimelineInterval;
+
+// A machine that is unavailable during [start, end), e.g. for maintenance
+typedef struct {
+    int mach;
+    int start;
+    int end;
+} TimelineWindow;
+
+typedef struct {
+    TimelineInterval *items;       // Sorted by start; they never overlap, so ends are sorted too
+    int count;
+    int cap;                       // Power of two, also the number of tree leaves
+    int *gap;                      // Segment tree, 2 * cap entries: leaf i = idle time before items[i]
+    int sorted;                    // 0 after timeline_append until timeline_finish
+} ShopTimeline;
+
+void timeline_init(ShopTimeline *tl);
+void timeline_free(ShopTimeline *tl);
+void timeline_clear(ShopTimeline *tl);
+int timeline_earliest(const ShopTimeline *tl, int ready, int len);
+int timeline_insert(ShopTimeline *tl, int start, int end);
+int timeline_remove(ShopTimeline *tl, int start, int end);
+int timeline_move_earliest(ShopTimeline *tl, int start, int end, int ready);
+int timeline_block(ShopTimeline *tl, int start, int end);
+int timeline_append(ShopTimeline *tl, int start, int end);
+void timeline_finish(ShopTimeline *tl);
+
+#endif // JOBSHOP_TIMELINE_H
@@ -0,0 +1,128 @@
+// Implementation of the per-thread trace rings and the Chrome trace export
+
+#include "jobshop_trace.h"
+#include "jobshop_common.h"
+
+typedef struct {
+    TraceEvent *events;
+    volatile unsigned long head;   // Events written so far; the ring holds the last TRACE_RING_EVENTS
+} TraceRing;
+
+volatile int trace_enabled = 0;
+static TraceRing rings[TRACE_MAX_THREADS];
+static volatile int nrings = 0;
+static volatile int env_checked = 0;
+static char *export_path = NULL;
+static __thread int my_ring = -1;  // -2: no ring left for this thread, its events are dropped
+
+static void export_at_exit(void) {
+    if (!export_path) return;
+    if (trace_export_chrome(export_path)) fprintf(stderr, "Trace written to %s\n", export_path);
+    else fprintf(stderr, "Error: could not write trace %s\n", export_path);
+}
+
+// Enable tracing when JOBSHOP_TRACE names an output file; safe to call from any thread
+void trace_init_from_env(void) {
+    int expected = 0;
+    if (!__atomic_compare_exchange_n(&env_checked, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) return;
+    const char *path = getenv("JOBSHOP_TRACE");
+    if (!path || !path[0]) return;
+    export_path = (char*)malloc(strlen(path) + 1);
+    if (!export_path) return;
+    strcpy(export_path, path);
+    atexit(export_at_exit);
+    trace_enable(1);
+}
+
+void trace_enable(int on) {
+    __atomic_store_n(&trace_enabled, on, __ATOMIC_RELEASE);
+}
+
+static TraceRing *claim_ring(void) {
+    int idx = __atomic_fetch_add(&nrings, 1, __ATOMIC_ACQ_REL);
+    if (idx >= TRACE_MAX_THREADS) {
+        my_ring = -2;
+        return NULL;
+    }
+    TraceEvent *events = (TraceEvent*)malloc(sizeof(TraceEvent) * TRACE_RING_EVENTS);
+    if (!events) {
+        my_ring = -2;
+        return NULL;
+    }
+    rings[idx].head = 0;
+    __atomic_store_n(&rings[idx].events, events, __ATOMIC_RELEASE);
+    my_ring = idx;
+    return &rings[idx];
+}
+
+void trace_record(const char *name, char phase, long arg) {
+    TraceRing *ring;
+    if (my_ring >= 0) ring = &rings[my_ring];
+    else if (my_ring == -1) ring = claim_ring();
+    else return;
+    if (!ring) return;
+    unsigned long head = ring->head;
+    TraceEvent *e = &ring->events[head & (TRACE_RING_EVENTS - 1)];
+    e->ts = wall_time_seconds();
+    e->name = name;
+    e->arg = arg;
+    e->phase = phase;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+// Drop all recorded events (the rings stay allocated for their threads)
+void trace_reset(void) {
+    int n = nrings < TRACE_MAX_THREADS ? nrings : TRACE_MAX_THREADS;
+    for (int r = 0; r < n; r++) __atomic_store_n(&rings[r].head, 0, __ATOMIC_RELEASE);
+}
+
+// Write every ring as Chrome trace JSON: one tid per ring, timestamps in microseconds from
+// the first event. Call once the traced threads are done.
+int trace_export_chrome(const char *filename) {
+    FILE *f = fopen(filename, "w");
+    if (!f) return 0;
+    int n = nrings < TRACE_MAX_THREADS ? nrings : TRACE_MAX_THREADS;
+    double origin = 0.0;
+    int have_origin = 0;
+    for (int r = 0; r < n; r++) {
+        TraceEvent *events = __atomic_load_n(&rings[r].events, __ATOMIC_ACQUIRE);
+        unsigned long head = __atomic_load_n(&rings[r].head, __ATOMIC_ACQUIRE);
+        if (!events || head == 0) continue;
+        unsigned long first = head > TRACE_RING_EVENTS ? head - TRACE_RING_EVENTS : 0;
+        double ts = events[first & (TRACE_RING_EVENTS - 1)].ts;
+        if (!have_origin || ts < origin) origin = ts;
+        have_origin = 1;
+    }
+    fprintf(f, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    int written = 0;
+    for (int r = 0; r < n; r++) {
+        TraceEvent *events = __atomic_load_n(&rings[r].events, __ATOMIC_ACQUIRE);
+        unsigned long head = __atomic_load_n(&rings[r].head, __ATOMIC_ACQUIRE);
+        if (!events) continue;
+        fprintf(f, "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"thread %d\"}}",
+                written++ ? "," : "", r, r);
+        unsigned long first = head > TRACE_RING_EVENTS ? head - TRACE_RING_EVENTS : 0;
+        for (unsigned long i = first; i < head; i++) {
+            const TraceEvent *e = &events[i & (TRACE_RING_EVENTS - 1)];
+            double us = (e->ts - origin) * 1e6;
+            switch (e->phase) {
+                case 'C':
+                    fprintf(f, ",\n{\"name\": \"%s\", \"ph\": \"C\", \"ts\": %.3f, \"pid\": 1, \"tid\": %d, \"args\": {\"value\": %ld}}",
+                            e->name, us, r, e->arg);
+                    break;
+                case 'i':
+                    fprintf(f, ",\n{\"name\": \"%s\", \"ph\": \"i\", \"s\": \"t\", \"ts\": %.3f, \"pid\": 1, \"tid\": %d, \"args\": {\"value\": %ld}}",
+                            e->name, us, r, e->arg);
+                    break;
+                default:
+                    fprintf(f, ",\n{\"name\": \"%s\", \"ph\": \"%c\", \"ts\": %.3f, \"pid\": 1, \"tid\": %d, \"args\": {\"value\": %ld}}",
+                            e->name, e->phase, us, r, e->arg);
+                    break;
+            }
+        }
+    }
+    fprintf(f, "\n]}\n");
+    int ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
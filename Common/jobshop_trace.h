@@ -0,0 +1,52 @@
+// jobshop_trace.h
+// Per-thread event tracing for the solver engines, exported as Chrome / Perfetto trace JSON
+// (chrome://tracing, ui.perfetto.dev). Every thread that records an event gets its own ring
+// buffer, written only by that thread, so recording takes no lock. When tracing is off each
+// TRACE_* macro is a single load and branch; building with -DJOBSHOP_NO_TRACE removes them.
+//
+// Any libjobshop program traces when JOBSHOP_TRACE=<file.json> is set in its environment;
+// the trace is written when the program exits.
+#ifndef JOBSHOP_TRACE_H
+#define JOBSHOP_TRACE_H
+
+#define TRACE_MAX_THREADS 256
+#define TRACE_RING_EVENTS 65536    // Per thread, power of two; the oldest events are overwritten
+#define TRACE_BB_BATCH 1024        // B&B nodes per traced expansion batch
+
+typedef struct {
+    double ts;                     // wall_time_seconds()
+    const char *name;              // Static string
+    long arg;
+    char phase;                    // 'B' begin, 'E' end, 'i' instant, 'C' counter
+} TraceEvent;
+
+extern volatile int trace_enabled;
+
+void trace_init_from_env(void);
+void trace_enable(int on);
+void trace_record(const char *name, char phase, long arg);
+int trace_export_chrome(const char *filename);
+void trace_reset(void);
+
+#ifdef JOBSHOP_NO_TRACE
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_INSTANT(name, arg) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_BATCH(name, count) ((void)0)
+#define TRACE_BATCH_CLOSE(name, count) ((void)0)
+#else
+#define TRACE_BEGIN(name) do { if (trace_enabled) trace_record((name), 'B', 0); } while (0)
+#define TRACE_END(name) do { if (trace_enabled) trace_record((name), 'E', 0); } while (0)
+#define TRACE_INSTANT(name, arg) do { if (trace_enabled) trace_record((name), 'i', (long)(arg)); } while (0)
+#define TRACE_COUNTER(name, value) do { if (trace_enabled) trace_record((name), 'C', (long)(value)); } while (0)
+// Call right after incrementing a node counter: one span per TRACE_BB_BATCH nodes
+#define TRACE_BATCH(name, count) do { if (trace_enabled) { \
+        if (((count) & (TRACE_BB_BATCH - 1)) == 1) trace_record((name), 'B', (long)(count)); \
+        else if (((count) & (TRACE_BB_BATCH - 1)) == 0) trace_record((name), 'E', (long)(count)); } } while (0)
+// Ends the last, partial batch once the search loop is left
+#define TRACE_BATCH_CLOSE(name, count) do { if (trace_enabled && ((count) & (TRACE_BB_BATCH - 1)) != 0) \
+        trace_record((name), 'E', (long)(count)); } while (0)
+#endif
+
+#endif // JOBSHOP_TRACE_H
@@ -0,0 +1,283 @@
+// jobshop_batch.c
+// Batch runner behind --batch: double-buffered instance loading, one reused solver handle,
+// consolidated CSV/JSON output.
+
+#include "jobshop_batch.h"
+#include "jobshop_solver.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <omp.h>
+
+#define BATCH_LINE 1024
+
+typedef struct {
+    char instance[512];
+    int algorithms[BATCH_MAX_ALGORITHMS];
+    int nalgorithms;
+    int threads[BATCH_MAX_THREAD_COUNTS];
+    int nthreads;
+    int repetitions;
+    double budget_seconds;
+    int propagate;
+    int deterministic;
+} BatchEntry;
+
+// One (instance, algorithm, threads) combination over all its repetitions
+typedef struct {
+    int entry;
+    int algorithm;
+    int threads;
+    int runs;
+    int best_makespan;
+    int worst_makespan;
+    double min_seconds;
+    double total_seconds;
+} BatchSummary;
+
+typedef struct {
+    FILE *file;
+    int json;
+    int rows;
+} BatchOutput;
+
+static int is_sequential(int algorithm) {
+    return algorithm == JOBSHOP_ALGO_SB_SEQ || algorithm == JOBSHOP_ALGO_BB_SEQ;
+}
+
+// Parses a comma list of algorithm names; '*' stands for the executable's own algorithm
+static int parse_algorithms(char *list, BatchEntry *e, int default_algorithm) {
+    e->nalgorithms = 0;
+    for (char *tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+        int a = strcmp(tok, "*") == 0 ? default_algorithm : jobshop_algorithm_from_name(tok);
+        if (!a || e->nalgorithms == BATCH_MAX_ALGORITHMS) return 0;
+        e->algorithms[e->nalgorithms++] = a;
+    }
+    return e->nalgorithms > 0;
+}
+
+static int parse_threads(char *list, BatchEntry *e) {
+    e->nthreads = 0;
+    for (char *tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+        int t = jobshop_threads_from_arg(tok); // "auto" is JOBSHOP_THREADS_AUTO (0)
+        if (t < 0 || e->nthreads == BATCH_MAX_THREAD_COUNTS) return 0;
+        e->threads[e->nthreads++] = t;
+    }
+    return e->nthreads > 0;
+}
+
+// Parses the comma list of run flags: propagate, deterministic
+static int parse_flags(char *list, BatchEntry *e) {
+    e->propagate = 0;
+    e->deterministic = 0;
+    for (char *tok = strtok(list, ","); tok; tok = strtok(NULL, ",")) {
+        if (strcmp(tok, "propagate") == 0) e->propagate = 1;
+        else if (strcmp(tok, "deterministic") == 0) e->deterministic = 1;
+        else return 0;
+    }
+    return 1;
+}
+
+static BatchEntry *load_manifest(const char *filename, int default_algorithm, int *count) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error: cannot open manifest %s\n", filename);
+        return NULL;
+    }
+    int cap = 16, n = 0, line_no = 0, ok = 1;
+    BatchEntry *entries = (BatchEntry*)malloc(sizeof(BatchEntry) * cap);
+    char line[BATCH_LINE];
+    while (entries && ok && fgets(line, sizeof(line), file)) {
+        line_no++;
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char instance[512], algorithms[128] = "*", threads[128] = "1", extra[32] = "";
+        int repetitions = 1;
+        double budget = 0.0;
+        int fields = sscanf(line, "%511s %127s %127s %d %lf %31s", instance, algorithms, threads, &repetitions, &budget, extra);
+        if (fields <= 0) continue;
+        if (n == cap) {
+            BatchEntry *grown = (BatchEntry*)realloc(entries, sizeof(BatchEntry) * cap * 2);
+            if (!grown) { free(entries); entries = NULL; break; }
+            entries = grown;
+            cap *= 2;
+        }
+        BatchEntry *e = &entries[n];
+        strcpy(e->instance, instance);
+        e->repetitions = repetitions;
+        e->budget_seconds = budget;
+        if (!parse_algorithms(algorithms, e, default_algorithm) || !parse_threads(threads, e) ||
+            !parse_flags(extra, e) || repetitions <= 0) {
+            fprintf(stderr, "Error: manifest %s line %d: expected <instance> [algorithms] [threads] [repetitions] [budget_seconds] [flags]\n",
+                    filename, line_no);
+            ok = 0;
+        }
+        n++;
+    }
+    fclose(file);
+    if (!entries || !ok || n == 0) {
+        if (ok && entries) fprintf(stderr, "Error: manifest %s lists no instance\n", filename);
+        free(entries);
+        return NULL;
+    }
+    *count = n;
+    return entries;
+}
+
+static void write_header(BatchOutput *out) {
+    if (out->json) fprintf(out->file, "{\n  \"runs\": [");
+    else fprintf(out->file, "instance,algorithm,threads,repetition,makespan,lower_bound,optimal,truncated,nodes,seconds\n");
+}
+
+static void write_run(BatchOutput *out, const BatchEntry *e, int algorithm, int threads, int rep, const JobshopResult *r, int solved) {
+    int makespan = solved ? r->makespan : -1;
+    if (out->json) {
+        fprintf(out->file, "%s\n    {\"instance\": \"%s\", \"algorithm\": \"%s\", \"threads\": %d, \"repetition\": %d, "
+                "\"makespan\": %d, \"lower_bound\": %d, \"optimal\": %d, \"truncated\": %d, \"nodes\": %ld, \"seconds\": %.6f}",
+                out->rows ? "," : "", e->instance, jobshop_algorithm_name(algorithm), threads, rep,
+                makespan, r->lower_bound, r->optimal, r->truncated, r->nodes, r->seconds);
+    } else {
+        fprintf(out->file, "%s,%s,%d,%d,%d,%d,%d,%d,%ld,%.6f\n", e->instance, jobshop_algorithm_name(algorithm),
+                threads, rep, makespan, r->lower_bound, r->optimal, r->truncated, r->nodes, r->seconds);
+    }
+    out->rows++;
+}
+
+static void write_summaries(BatchOutput *out, const BatchEntry *entries, const BatchSummary *s, int nsummaries) {
+    if (out->json) fprintf(out->file, "\n  ],\n  \"summary\": [");
+    for (int i = 0; i < nsummaries; i++) {
+        double mean = s[i].runs ? s[i].total_seconds / s[i].runs : 0.0;
+        printf("%-32s %-30s threads=%-3d runs=%-6d best=%-7d worst=%-7d min=%.6fs mean=%.6fs\n",
+               entries[s[i].entry].instance, jobshop_algorithm_name(s[i].algorithm), s[i].threads, s[i].runs,
+               s[i].best_makespan, s[i].worst_makespan, s[i].min_seconds, mean);
+        if (out->json) {
+            fprintf(out->file, "%s\n    {\"instance\": \"%s\", \"algorithm\": \"%s\", \"threads\": %d, \"runs\": %d, "
+                    "\"best_makespan\": %d, \"worst_makespan\": %d, \"min_seconds\": %.6f, \"mean_seconds\": %.6f}",
+                    i ? "," : "", entries[s[i].entry].instance, jobshop_algorithm_name(s[i].algorithm), s[i].threads,
+                    s[i].runs, s[i].best_makespan, s[i].worst_makespan, s[i].min_seconds, mean);
+        }
+    }
+    if (out->json) fprintf(out->file, "\n  ]\n}\n");
+}
+
+// All runs of one manifest line on the already loaded problem; returns 0 if any run failed
+static int run_entry(JobshopSolver *solver, const BatchEntry *e, int index, BatchOutput *out,
+                     BatchSummary *summaries, int *nsummaries) {
+    int ok = 1;
+    for (int a = 0; a < e->nalgorithms; a++) {
+        int algorithm = e->algorithms[a];
+        int nthreads = is_sequential(algorithm) ? 1 : e->nthreads;
+        for (int t = 0; t < nthreads; t++) {
+            int threads = is_sequential(algorithm) ? 1 : e->threads[t];
+            BatchSummary *s = &summaries[(*nsummaries)++];
+            s->entry = index;
+            s->algorithm = algorithm;
+            s->threads = threads;
+            s->runs = 0;
+            s->best_makespan = INT_MAX;
+            s->worst_makespan = 0;
+            s->min_seconds = 0.0;
+            s->total_seconds = 0.0;
+
+            JobshopOptions opt;
+            jobshop_options_init(&opt);
+            opt.algorithm = algorithm;
+            opt.threads = threads;
+            opt.budget_seconds = e->budget_seconds;
+            opt.propagate = e->propagate;
+            opt.deterministic = e->deterministic;
+            for (int rep = 1; rep <= e->repetitions; rep++) {
+                JobshopResult result;
+                int solved = jobshop_solver_solve(solver, &opt, &result);
+                write_run(out, e, algorithm, threads, rep, &result, solved);
+                if (!solved) {
+                    ok = 0;
+                    continue;
+                }
+                if (result.makespan < s->best_makespan) s->best_makespan = result.makespan;
+                if (result.makespan > s->worst_makespan) s->worst_makespan = result.makespan;
+                if (s->runs == 0 || result.seconds < s->min_seconds) s->min_seconds = result.seconds;
+                s->total_seconds += result.seconds;
+                s->runs++;
+            }
+        }
+    }
+    return ok;
+}
+
+int jobshop_batch_run(const char *manifest_file, const char *output_file, int default_algorithm) {
+    int nentries = 0;
+    BatchEntry *entries = load_manifest(manifest_file, default_algorithm, &nentries);
+    if (!entries) return 1;
+
+    int max_summaries = 0;
+    for (int i = 0; i < nentries; i++) max_summaries += entries[i].nalgorithms * entries[i].nthreads;
+    BatchSummary *summaries = (BatchSummary*)malloc(sizeof(BatchSummary) * max_summaries);
+    JobshopSolver *solver = jobshop_solver_create();
+    Shop *slot[2] = { (Shop*)malloc(sizeof(Shop)), (Shop*)malloc(sizeof(Shop)) };
+    BatchOutput out;
+    out.file = fopen(output_file, "w");
+    size_t len = strlen(output_file);
+    out.json = len >= 5 && strcmp(output_file + len - 5, ".json") == 0;
+    out.rows = 0;
+    if (!summaries || !solver || !slot[0] || !slot[1] || !out.file) {
+        fprintf(stderr, out.file ? "Error: out of memory\n" : "Error: cannot open %s for writing\n", output_file);
+        if (out.file) fclose(out.file);
+        free(summaries);
+        jobshop_solver_destroy(solver);
+        free(slot[0]);
+        free(slot[1]);
+        free(entries);
+        return 1;
+    }
+    write_header(&out);
+
+    // The solve owns the outer thread team; the prefetch section needs one more level
+    int saved_levels = omp_get_max_active_levels();
+    if (saved_levels < 3) omp_set_max_active_levels(3);
+
+    int nsummaries = 0, failures = 0, cur = 0;
+    int loaded[2] = { load_problem_seq(entries[0].instance, slot[0]), 0 };
+    double start = wall_time_seconds();
+    for (int i = 0; i < nentries; i++) {
+        int next = cur ^ 1;
+        // Consecutive lines on the same instance keep the parsed copy
+        int same_next = (i + 1 < nentries) && strcmp(entries[i + 1].instance, entries[i].instance) == 0;
+        int entry_ok = 1;
+        #pragma omp parallel sections num_threads(2)
+        {
+            #pragma omp section
+            {
+                if (loaded[cur] && jobshop_solver_set_problem(solver, slot[cur])) {
+                    entry_ok = run_entry(solver, &entries[i], i, &out, summaries, &nsummaries);
+                } else {
+                    fprintf(stderr, "Error: cannot load %s, skipping its runs\n", entries[i].instance);
+                    entry_ok = 0;
+                }
+            }
+            #pragma omp section
+            {
+                if (i + 1 < nentries && !same_next) loaded[next] = load_problem_seq(entries[i + 1].instance, slot[next]);
+            }
+        }
+        if (!entry_ok) failures++;
+        if (!same_next) cur = next;
+        printf("[%d/%d] %s done\n", i + 1, nentries, entries[i].instance);
+        fflush(stdout);
+    }
+    omp_set_max_active_levels(saved_levels);
+
+    write_summaries(&out, entries, summaries, nsummaries);
+    fclose(out.file);
+    printf("Batch: %d runs over %d instance line(s) in %.3f seconds, %d line(s) with failures\n",
+           out.rows, nentries, wall_time_seconds() - start, failures);
+    printf("Results written to %s\n", output_file);
+
+    free(summaries);
+    jobshop_solver_destroy(solver);
+    free(slot[0]);
+    free(slot[1]);
+    free(entries);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,24 @@
+// jobshop_batch.h
+// Batch mode of the solver executables (--batch <manifest>): every instance is parsed once and
+// all its (algorithm, threads, repetition) runs share one solver handle, while the next
+// instance is parsed on a second thread. One consolidated CSV or JSON file holds all runs.
+//
+// Manifest: one instance per line, '#' starts a comment
+//   <instance_file> [algorithms] [threads] [repetitions] [budget_seconds] [flags]
+//   algorithms: comma list of sb_seq, sb_par, bb_seq, bb_par, portfolio; '*' = the executable's own
+//   threads:    comma list, e.g. 1,2,4,8 or auto (reported as 0); sequential algorithms
+//               always run once with 1
+//   flags:      comma list of propagate (B&B filtering) and deterministic (bb_par result
+//               independent of the thread count)
+//   e.g.  ../../Data/3_Big_sample.jss  sb_seq,sb_par  1,2,4  100
+#ifndef JOBSHOP_BATCH_H
+#define JOBSHOP_BATCH_H
+
+#define BATCH_MAX_ALGORITHMS 8
+#define BATCH_MAX_THREAD_COUNTS 16
+
+// Runs the manifest; the output is JSON when output_file ends in .json, CSV otherwise.
+// Returns 0 when every instance loaded and solved, 1 otherwise (the other runs still happen).
+int jobshop_batch_run(const char *manifest_file, const char *output_file, int default_algorithm);
+
+#endif // JOBSHOP_BATCH_H
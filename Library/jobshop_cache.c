@@ -0,0 +1,299 @@
+// jobshop_cache.c
+// Persistent solution cache: content-addressed entries, validated hits and LRU eviction
+
+#include "jobshop_cache.h"
+#include "../Common/jobshop_schedule.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <dirent.h>
+#include <utime.h>
+#endif
+
+#define CACHE_PATH_MAX 1100
+#define CACHE_SUFFIX ".jsc"
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+// One file of the cache directory, for eviction
+typedef struct {
+    char name[32];
+    long long size;
+    long long used;                // Modification time: the last store or hit
+} CacheEntry;
+
+// $JOBSHOP_CACHE, else JOBSHOP_CACHE_DIR in the jobshop home (the repository root for the
+// executables), so all of them share one cache wherever they run
+const char *jobshop_cache_dir(void) {
+    static char home_dir[JOBSHOP_HOME_MAX];
+    const char *dir = getenv("JOBSHOP_CACHE");
+    if (dir && dir[0]) return dir;
+    if (!home_dir[0]) jobshop_home_path(home_dir, sizeof(home_dir), JOBSHOP_CACHE_DIR);
+    return home_dir;
+}
+
+int jobshop_cache_max_mb(void) {
+    const char *mb = getenv("JOBSHOP_CACHE_MB");
+    int value = mb ? atoi(mb) : 0;
+    return value > 0 ? value : JOBSHOP_CACHE_MAX_MB;
+}
+
+static unsigned long long fnv_mix(unsigned long long h, long long value) {
+    for (int b = 0; b < 8; b++) {
+        h ^= (unsigned long long)(value >> (8 * b)) & 0xff;
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+// Hash of what defines the instance; the start times and logs don't take part
+static unsigned long long instance_hash(const Shop *shop) {
+    unsigned long long h = FNV_OFFSET;
+    h = fnv_mix(h, shop->njobs);
+    h = fnv_mix(h, shop->nmachs);
+    h = fnv_mix(h, shop->nops);
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int o = 0; o < shop->nops; o++) {
+            h = fnv_mix(h, shop->plan[j][o].mach);
+            h = fnv_mix(h, shop->plan[j][o].len);
+        }
+    }
+    return h;
+}
+
+// Key of a solve: the instance and only the options its engine reads, so options an
+// algorithm ignores don't split its entries. The placement and the target never change
+// the schedule.
+unsigned long long jobshop_cache_key(const Shop *shop, const JobshopOptions *opt) {
+    int algorithm = opt->algorithm;
+    int is_sb = (algorithm == JOBSHOP_ALGO_SB_SEQ || algorithm == JOBSHOP_ALGO_SB_PAR);
+    int is_bb = (algorithm == JOBSHOP_ALGO_BB_SEQ || algorithm == JOBSHOP_ALGO_BB_PAR ||
+                 algorithm == JOBSHOP_ALGO_PORTFOLIO);
+    int threads = opt->threads > 0 ? opt->threads : JOBSHOP_THREADS_AUTO;
+    if (algorithm == JOBSHOP_ALGO_SB_SEQ || algorithm == JOBSHOP_ALGO_BB_SEQ) threads = 1;
+    if (algorithm == JOBSHOP_ALGO_BB_PAR && opt->deterministic) threads = 1; // Same tree for any count
+    long long budget_ms = algorithm == JOBSHOP_ALGO_SB_SEQ ? 0 : (long long)(opt->budget_seconds * 1000.0 + 0.5);
+
+    unsigned long long h = fnv_mix(FNV_OFFSET, JOBSHOP_CACHE_VERSION);
+    h = fnv_mix(h, (long long)instance_hash(shop));
+    h = fnv_mix(h, algorithm);
+    h = fnv_mix(h, threads);
+    h = fnv_mix(h, budget_ms > 0 ? budget_ms : 0);
+    h = fnv_mix(h, is_bb ? opt->node_limit : 0);
+    h = fnv_mix(h, is_bb ? opt->propagate : 0);
+    h = fnv_mix(h, (is_sb || algorithm == JOBSHOP_ALGO_PORTFOLIO) ? opt->left_shift : 0);
+    h = fnv_mix(h, algorithm == JOBSHOP_ALGO_BB_PAR ? opt->deterministic : 0);
+    return h;
+}
+
+// A result goes into the cache only if the same solve would give it again: parallel B&B
+// without --deterministic and the portfolio depend on thread timing, and a wall-clock budget
+// cuts a run wherever the load of the moment lets it get to. A proven optimum holds either way.
+int jobshop_cache_storable(const JobshopOptions *opt, const JobshopResult *result) {
+    if (result->optimal) return 1;
+    if (result->truncated && opt->budget_seconds > 0.0) return 0;
+    if (opt->algorithm == JOBSHOP_ALGO_PORTFOLIO) return 0;
+    if (opt->algorithm == JOBSHOP_ALGO_BB_PAR && !opt->deterministic) return 0;
+    return 1;
+}
+
+static void entry_name(char *name, size_t size, unsigned long long key) {
+    snprintf(name, size, "%08x%08x" CACHE_SUFFIX, (unsigned int)(key >> 32), (unsigned int)(key & 0xffffffffu));
+}
+
+static void entry_path(char *path, const char *dir, const char *name) {
+    snprintf(path, CACHE_PATH_MAX, "%s/%s", dir, name);
+}
+
+// Read and check an entry. On a hit the start times are in shop->plan and the fields of the
+// original solve in result (the caller times the lookup itself).
+int jobshop_cache_lookup(const char *dir, unsigned long long key, Shop *shop, JobshopResult *result) {
+    char name[32], path[CACHE_PATH_MAX];
+    entry_name(name, sizeof(name), key);
+    entry_path(path, dir, name);
+    FILE *file = fopen(path, "r");
+    if (!file) return 0; // Miss
+
+    int makespan = 0;
+    int ok = fscanf(file, "%d", &makespan) == 1;
+    for (int j = 0; j < shop->njobs && ok; j++) {
+        for (int o = 0; o < shop->nops && ok; o++) ok = fscanf(file, "%d", &shop->plan[j][o].stime) == 1;
+    }
+    unsigned int key_hi = 0, key_lo = 0, inst_hi = 0, inst_lo = 0;
+    int version = 0, njobs = 0, nops = 0;
+    ShopBounds bounds;
+    int optimal = 0, truncated = 0, source = 0;
+    long nodes = 0;
+    ok = ok && fscanf(file, " # jobshop_cache %d %8x%8x %8x%8x %d %d lb %d %d %d %d %d optimal %d truncated %d source %d nodes %ld",
+                      &version, &key_hi, &key_lo, &inst_hi, &inst_lo, &njobs, &nops, &bounds.best, &bounds.job,
+                      &bounds.machine, &bounds.jackson, &bounds.jackson_machine, &optimal, &truncated, &source,
+                      &nodes) == 16;
+    fclose(file);
+
+    // The validator's checks: the schedule must be feasible for this instance and have the
+    // makespan it was stored with, which its bound can't exceed
+    unsigned long long inst = instance_hash(shop);
+    ScheduleCheck check;
+    ok = ok && version == JOBSHOP_CACHE_VERSION && njobs == shop->njobs && nops == shop->nops &&
+         key_hi == (unsigned int)(key >> 32) && key_lo == (unsigned int)(key & 0xffffffffu) &&
+         inst_hi == (unsigned int)(inst >> 32) && inst_lo == (unsigned int)(inst & 0xffffffffu) &&
+         schedule_validate(shop, &check) && check.makespan == makespan && bounds.best <= makespan;
+    if (!ok) {
+        fprintf(stderr, "Solution cache: entry %s does not hold for this instance, removed\n", path);
+        remove(path);
+        reset_plan_seq(shop);
+        return 0;
+    }
+    utime(path, NULL); // Most recently used
+    result->makespan = makespan;
+    result->lower_bound = bounds.best;
+    result->bounds = bounds;
+    result->optimal = optimal;
+    result->truncated = truncated;
+    result->source = source;
+    result->nodes = nodes;
+    result->cached = 1;
+    return 1;
+}
+
+static int compare_entries(const void *a, const void *b) {
+    const CacheEntry *x = (const CacheEntry*)a, *y = (const CacheEntry*)b;
+    if (x->used != y->used) return (x->used > y->used) - (x->used < y->used);
+    return strcmp(x->name, y->name);
+}
+
+static int is_entry_name(const char *name) {
+    size_t len = strlen(name), suffix = strlen(CACHE_SUFFIX);
+    return len > suffix && len < sizeof(((CacheEntry*)0)->name) && strcmp(name + len - suffix, CACHE_SUFFIX) == 0;
+}
+
+static int add_entry(CacheEntry **entries, int *count, int *cap, const char *name, long long size, long long used) {
+    if (*count == *cap) {
+        int grown_cap = *cap ? *cap * 2 : 64;
+        CacheEntry *grown = (CacheEntry*)realloc(*entries, sizeof(CacheEntry) * grown_cap);
+        if (!grown) return 0;
+        *entries = grown;
+        *cap = grown_cap;
+    }
+    CacheEntry *e = &(*entries)[(*count)++];
+    snprintf(e->name, sizeof(e->name), "%s", name);
+    e->size = size;
+    e->used = used;
+    return 1;
+}
+
+// Every entry of the directory with its size and last use; returns the count, -1 on error
+static int list_entries(const char *dir, CacheEntry **entries) {
+    int count = 0, cap = 0;
+    *entries = NULL;
+#ifdef _WIN32
+    char pattern[CACHE_PATH_MAX];
+    snprintf(pattern, sizeof(pattern), "%s\\*" CACHE_SUFFIX, dir);
+    WIN32_FIND_DATAA found;
+    HANDLE h = FindFirstFileA(pattern, &found);
+    if (h == INVALID_HANDLE_VALUE) return 0;
+    do {
+        if (!is_entry_name(found.cFileName)) continue;
+        long long size = ((long long)found.nFileSizeHigh << 32) | found.nFileSizeLow;
+        long long used = ((long long)found.ftLastWriteTime.dwHighDateTime << 32) | found.ftLastWriteTime.dwLowDateTime;
+        if (!add_entry(entries, &count, &cap, found.cFileName, size, used)) {
+            FindClose(h);
+            return -1;
+        }
+    } while (FindNextFileA(h, &found));
+    FindClose(h);
+#else
+    DIR *d = opendir(dir);
+    if (!d) return 0;
+    struct dirent *e;
+    while ((e = readdir(d)) != NULL) {
+        if (!is_entry_name(e->d_name)) continue;
+        char path[CACHE_PATH_MAX];
+        struct stat st;
+        entry_path(path, dir, e->d_name);
+        if (stat(path, &st) != 0) continue; // Evicted by another process meanwhile
+        if (!add_entry(entries, &count, &cap, e->d_name, (long long)st.st_size, (long long)st.st_mtime)) {
+            closedir(d);
+            return -1;
+        }
+    }
+    closedir(d);
+#endif
+    return count;
+}
+
+// Remove the least recently used entries, never keep, until the directory fits max_bytes
+static int evict(const char *dir, long long max_bytes, const char *keep) {
+    CacheEntry *entries;
+    int count = list_entries(dir, &entries);
+    if (count < 0) {
+        free(entries);
+        return 0;
+    }
+    long long total = 0;
+    for (int i = 0; i < count; i++) total += entries[i].size;
+    qsort(entries, count, sizeof(CacheEntry), compare_entries);
+    int evicted = 0;
+    for (int i = 0; i < count && total > max_bytes; i++) {
+        if (strcmp(entries[i].name, keep) == 0) continue;
+        char path[CACHE_PATH_MAX];
+        entry_path(path, dir, entries[i].name);
+        if (remove(path) == 0) evicted++;
+        total -= entries[i].size; // Gone either way: removed here or by another process
+    }
+    free(entries);
+    return evicted;
+}
+
+// Write the entry of a finished solve. The file is written under a name private to this
+// process and thread and then renamed, so concurrent solvers never read half an entry.
+// Returns 1 when the entry was stored.
+int jobshop_cache_store(const char *dir, int max_mb, unsigned long long key, const Shop *shop,
+                        const JobshopResult *result) {
+    struct stat st = {0};
+    if (stat(dir, &st) == -1) {
+#ifdef _WIN32
+        _mkdir(dir);
+#else
+        mkdir(dir, 0777);
+#endif
+    }
+    char name[32], path[CACHE_PATH_MAX], tmp[CACHE_PATH_MAX + 64];
+    entry_name(name, sizeof(name), key);
+    entry_path(path, dir, name);
+#ifdef _WIN32
+    snprintf(tmp, sizeof(tmp), "%s.%lu.%d.tmp", path, (unsigned long)GetCurrentProcessId(), omp_get_thread_num());
+#else
+    snprintf(tmp, sizeof(tmp), "%s.%ld.%d.tmp", path, (long)getpid(), omp_get_thread_num());
+#endif
+    FILE *file = fopen(tmp, "w");
+    if (!file) return 0;
+    fprintf(file, "%d\n", result->makespan);
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int o = 0; o < shop->nops; o++) fprintf(file, "%d ", shop->plan[j][o].stime);
+        fprintf(file, "\n");
+    }
+    unsigned long long inst = instance_hash(shop);
+    const ShopBounds *b = &result->bounds;
+    fprintf(file, "# jobshop_cache %d %08x%08x %08x%08x %d %d lb %d %d %d %d %d optimal %d truncated %d source %d nodes %ld\n",
+            JOBSHOP_CACHE_VERSION, (unsigned int)(key >> 32), (unsigned int)(key & 0xffffffffu),
+            (unsigned int)(inst >> 32), (unsigned int)(inst & 0xffffffffu), shop->njobs, shop->nops,
+            b->best, b->job, b->machine, b->jackson, b->jackson_machine, result->optimal, result->truncated,
+            result->source, result->nodes);
+    int written = (fclose(file) == 0);
+#ifdef _WIN32
+    written = written && MoveFileExA(tmp, path, MOVEFILE_REPLACE_EXISTING);
+#else
+    written = written && rename(tmp, path) == 0;
+#endif
+    if (!written) {
+        remove(tmp);
+        return 0;
+    }
+    evict(dir, (long long)max_mb * 1024 * 1024, name);
+    return 1;
+}
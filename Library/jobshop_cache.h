@@ -0,0 +1,33 @@
+// jobshop_cache.h
+// Persistent solution cache of libjobshop. An entry is keyed by a 64-bit FNV-1a hash of the
+// instance contents (sizes, machines and durations) and of the options that change the
+// answer, and holds the schedule in the Annex II layout (makespan, then start times per job)
+// followed by one comment line with the rest of the result, so jobshop_validate can check an
+// entry like any result file. Entries are <key>.jsc files in one directory: a hit refreshes
+// the file's modification time, a store evicts the least recently used entries until the
+// directory fits its size cap. Every hit is validated against the instance and dropped when
+// it doesn't hold, so a corrupted or colliding entry costs one solve, never a wrong answer.
+// Only reproducible answers are stored (jobshop_cache_storable): not those cut short by the
+// wall clock, nor those of the timing-dependent engines unless they are proven optimal.
+//
+// The executables cache in $JOBSHOP_CACHE (default jobshop_cache at the repository root)
+// capped at $JOBSHOP_CACHE_MB (default 64) unless run with --no-cache; library callers opt in
+// with JobshopOptions.cache_dir.
+#ifndef JOBSHOP_CACHE_H
+#define JOBSHOP_CACHE_H
+
+#include "jobshop_solver.h"
+
+#define JOBSHOP_CACHE_DIR "jobshop_cache"      // Directory in the jobshop home (JOBSHOP_CACHE overrides)
+#define JOBSHOP_CACHE_MAX_MB 64                // Default size cap (JOBSHOP_CACHE_MB overrides)
+#define JOBSHOP_CACHE_VERSION 2                // Part of every key; bump when the entry layout or what is stored changes
+
+const char *jobshop_cache_dir(void);
+int jobshop_cache_max_mb(void);
+unsigned long long jobshop_cache_key(const Shop *shop, const JobshopOptions *opt);
+int jobshop_cache_storable(const JobshopOptions *opt, const JobshopResult *result);
+int jobshop_cache_lookup(const char *dir, unsigned long long key, Shop *shop, JobshopResult *result);
+int jobshop_cache_store(const char *dir, int max_mb, unsigned long long key, const Shop *shop,
+                        const JobshopResult *result);
+
+#endif // JOBSHOP_CACHE_H
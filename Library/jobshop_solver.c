@@ -0,0 +1,404 @@
+// jobshop_solver.c
+// libjobshop handle: owns the problem, the schedule and the engine buffers of one solver,
+// and dispatches jobshop_solver_solve to the selected engine.
+
+#include "jobshop_solver.h"
+#include "jobshop_cache.h"
+#include "../Common/jobshop_incumbent.h"
+#include "../Common/jobshop_schedule.h"
+#include "../Common/jobshop_trace.h"
+#include "../Algorithms/ShiftingBottleneck/jobshop_seq_sb.h"
+#include "../Algorithms/ShiftingBottleneck/jobshop_par_sb.h"
+#include "../Algorithms/BranchAndBound/jobshop_seq_bb.h"
+#include "../Algorithms/BranchAndBound/jobshop_par_bb.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <omp.h>
+
+struct JobshopSolver {
+    Shop shop;                     // Problem; the last schedule lives in plan[][].stime
+    int loaded;
+    int *stime;                    // [job * nops + op] scratch shared with the engines
+    int stime_cap;
+    SBWorkspace *sb_ws;            // Disjunctive graph, kept while the problem fits
+    Incumbent *incumbent;          // Budget and engine sharing, allocated on first use
+    Shop *sb_shop;                 // Portfolio: SB writes its start times into this copy
+};
+
+void jobshop_options_init(JobshopOptions *opt) {
+    opt->algorithm = JOBSHOP_ALGO_SB_SEQ;
+    opt->threads = 1;
+    opt->budget_seconds = 0.0;
+    opt->node_limit = 0;
+    opt->propagate = 0;
+    opt->target_makespan = 0;
+    opt->left_shift = 1;
+    parallel_placement_init(&opt->placement);
+    opt->deterministic = 0;
+    opt->cache_dir = NULL;
+    opt->cache_max_mb = JOBSHOP_CACHE_MAX_MB;
+}
+
+const char *jobshop_algorithm_name(int algorithm) {
+    switch (algorithm) {
+        case JOBSHOP_ALGO_SB_SEQ: return "ShiftingBottleneck_Sequential";
+        case JOBSHOP_ALGO_SB_PAR: return "ShiftingBottleneck_OpenMP";
+        case JOBSHOP_ALGO_BB_SEQ: return "BranchAndBound_Sequential";
+        case JOBSHOP_ALGO_BB_PAR: return "BranchAndBound_OpenMP";
+        case JOBSHOP_ALGO_PORTFOLIO: return "Portfolio";
+        default: return "unknown";
+    }
+}
+
+// Short names used on command lines and in protocols; returns 0 for an unknown name
+int jobshop_algorithm_from_name(const char *name) {
+    if (strcmp(name, "sb_seq") == 0) return JOBSHOP_ALGO_SB_SEQ;
+    if (strcmp(name, "sb_par") == 0) return JOBSHOP_ALGO_SB_PAR;
+    if (strcmp(name, "bb_seq") == 0) return JOBSHOP_ALGO_BB_SEQ;
+    if (strcmp(name, "bb_par") == 0) return JOBSHOP_ALGO_BB_PAR;
+    if (strcmp(name, "portfolio") == 0) return JOBSHOP_ALGO_PORTFOLIO;
+    return 0;
+}
+
+// Thread count of a command line: a positive number, or "auto" (JOBSHOP_THREADS_AUTO).
+// Returns -1 for anything else.
+int jobshop_threads_from_arg(const char *arg) {
+    if (strcmp(arg, "auto") == 0) return JOBSHOP_THREADS_AUTO;
+    int threads = atoi(arg);
+    return threads > 0 ? threads : -1;
+}
+
+JobshopSolver *jobshop_solver_create(void) {
+    trace_init_from_env(); // JOBSHOP_TRACE=<file.json> records a Chrome trace of the solves
+    JobshopSolver *solver = (JobshopSolver*)calloc(1, sizeof(JobshopSolver));
+    return solver;
+}
+
+void jobshop_solver_destroy(JobshopSolver *solver) {
+    if (!solver) return;
+    free(solver->stime);
+    sb_workspace_free(solver->sb_ws);
+    free(solver->incumbent);
+    free(solver->sb_shop);
+    free(solver);
+}
+
+// Size the buffers for the current problem; they only grow, so repeated solves reuse them
+static int ensure_buffers(JobshopSolver *solver, int need_graph) {
+    int n = solver->shop.njobs * solver->shop.nops;
+    if (n > solver->stime_cap) {
+        int *grown = (int*)realloc(solver->stime, sizeof(int) * n);
+        if (!grown) return 0;
+        solver->stime = grown;
+        solver->stime_cap = n;
+    }
+    if (need_graph && (!solver->sb_ws || solver->sb_ws->nodes < n + 2)) {
+        sb_workspace_free(solver->sb_ws);
+        solver->sb_ws = sb_workspace_create(n);
+        if (!solver->sb_ws) return 0;
+    }
+    if (!solver->incumbent) {
+        solver->incumbent = (Incumbent*)malloc(sizeof(Incumbent));
+        if (!solver->incumbent) return 0;
+    }
+    return 1;
+}
+
+int jobshop_solver_load(JobshopSolver *solver, const char *filename) {
+    solver->loaded = load_problem_seq(filename, &solver->shop);
+    return solver->loaded;
+}
+
+int jobshop_solver_set_problem(JobshopSolver *solver, const Shop *shop) {
+    if (shop->njobs <= 0 || shop->njobs > JMAX || shop->nops <= 0 || shop->nops > OPMAX ||
+        shop->nmachs <= 0 || shop->nmachs > MMAX) {
+        solver->loaded = 0;
+        return 0;
+    }
+    solver->shop = *shop;
+    solver->loaded = 1;
+    reset_plan_seq(&solver->shop);
+    return 1;
+}
+
+// Forget the last schedule; the problem and the buffers are kept for the next solve
+void jobshop_solver_reset(JobshopSolver *solver) {
+    if (solver->loaded) reset_plan_seq(&solver->shop);
+}
+
+const Shop *jobshop_solver_shop(const JobshopSolver *solver) {
+    return &solver->shop;
+}
+
+static void stime_to_plan(JobshopSolver *solver, const int *stime) {
+    Shop *shop = &solver->shop;
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int o = 0; o < shop->nops; o++) {
+            shop->plan[j][o].stime = stime[j * shop->nops + o];
+        }
+    }
+}
+
+// Move the operations of the SB schedule into earlier idle gaps until none moves, or the
+// schedule reaches the lower bound
+static int left_shift_sb(Shop *shop, int makespan, int lower_bound, SolverStats *stats) {
+    if (makespan <= lower_bound) return makespan; // Nothing to gain
+    TRACE_BEGIN("sb_left_shift");
+    double since = stats_clock(stats);
+    int sweeps = 0;
+    int shifted = schedule_left_shift(shop, 0, lower_bound, &sweeps);
+    stats_phase(stats, STATS_PHASE_SB_LEFT_SHIFT, since);
+    TRACE_END("sb_left_shift");
+    if (shifted < 0) return makespan; // Out of memory: the schedule is unchanged
+    stats->left_shift_sweeps += sweeps;
+    stats->left_shift_gain += makespan - shifted;
+    return shifted;
+}
+
+// Portfolio SB engine: one full heuristic pass, compacted like the SB algorithms' result
+// (left_shift) and published as soon as it is done
+static void run_portfolio_sb(JobshopSolver *solver, int num_threads, int left_shift, int lower_bound) {
+    Shop *shop = solver->sb_shop;
+    if (!shifting_bottleneck_schedule_par(shop, solver->sb_ws, num_threads, solver->incumbent, NULL)) return;
+    int makespan = schedule_makespan(shop);
+    if (left_shift) makespan = left_shift_sb(shop, makespan, lower_bound, solver->sb_ws->stats);
+    int *stime = (int*)malloc(sizeof(int) * shop->njobs * shop->nops);
+    if (!stime) return;
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int o = 0; o < shop->nops; o++) {
+            stime[j * shop->nops + o] = shop->plan[j][o].stime;
+        }
+    }
+    if (incumbent_offer(solver->incumbent, makespan, stime, INCUMBENT_SRC_SB)) {
+        TRACE_INSTANT("portfolio_sb_publish", makespan);
+    }
+    free(stime);
+}
+
+// Portfolio B&B engine: prunes with whatever the incumbent holds; an exhausted tree is a proof
+static void run_portfolio_bb(JobshopSolver *solver, int num_threads, BBRun *run) {
+    branch_and_bound_solve(&solver->shop, num_threads, run, NULL);
+    if (!run->truncated && !incumbent_should_stop(solver->incumbent)) {
+        incumbent_stop(solver->incumbent, 1);
+    }
+}
+
+static int solve_portfolio(JobshopSolver *solver, int num_threads, int left_shift, BBRun *run, JobshopResult *result) {
+    if (!solver->sb_shop) {
+        solver->sb_shop = (Shop*)malloc(sizeof(Shop));
+        if (!solver->sb_shop) return INT_MAX;
+    }
+    *solver->sb_shop = solver->shop;
+    SolverStats sb_stats; // The engines run concurrently, so SB counts apart from B&B
+    stats_reset(&sb_stats);
+    solver->sb_ws->stats = &sb_stats;
+    // Disjoint thread groups: SB only parallelizes over machines, B&B gets the rest
+    if (num_threads == JOBSHOP_THREADS_AUTO) num_threads = parallel_thresholds()->max_threads;
+    if (num_threads < 2) num_threads = 2; // One thread per engine at least
+    int sb_threads = num_threads / 4;
+    if (sb_threads < 1) sb_threads = 1;
+    int bb_threads = num_threads - sb_threads;
+    result->sb_threads = sb_threads;
+
+    omp_set_max_active_levels(2);
+    #pragma omp parallel sections num_threads(2)
+    {
+        #pragma omp section
+        run_portfolio_sb(solver, sb_threads, left_shift, result->lower_bound);
+        #pragma omp section
+        run_portfolio_bb(solver, bb_threads, run);
+    }
+    solver->sb_ws->stats = NULL;
+    stats_merge(&result->stats, &sb_stats);
+    result->bb_threads = run->threads;
+    result->optimal = solver->incumbent->optimal;
+    return incumbent_snapshot(solver->incumbent, solver->stime, &result->source);
+}
+
+// Solve the loaded problem with the given options. Returns 1 when a schedule was found; it
+// is then in jobshop_solver_shop(solver)->plan and result->makespan.
+int jobshop_solver_solve(JobshopSolver *solver, const JobshopOptions *opt, JobshopResult *result) {
+    memset(result, 0, sizeof(*result));
+    result->makespan = INT_MAX;
+    result->time_to_target = -1.0;
+    if (!solver->loaded) {
+        fprintf(stderr, "jobshop_solver_solve: no problem loaded\n");
+        return 0;
+    }
+    int algorithm = opt->algorithm;
+    int need_graph = (algorithm == JOBSHOP_ALGO_SB_SEQ || algorithm == JOBSHOP_ALGO_SB_PAR ||
+                      algorithm == JOBSHOP_ALGO_PORTFOLIO);
+    if (!ensure_buffers(solver, need_graph)) {
+        fprintf(stderr, "jobshop_solver_solve: out of memory\n");
+        return 0;
+    }
+    Shop *shop = &solver->shop;
+    int threads = opt->threads > 0 ? opt->threads : JOBSHOP_THREADS_AUTO;
+    reset_plan_seq(shop);
+    unsigned long long cache_key = 0;
+    if (opt->cache_dir) {
+        double lookup_start = wall_time_seconds();
+        cache_key = jobshop_cache_key(shop, opt);
+        if (jobshop_cache_lookup(opt->cache_dir, cache_key, shop, result)) {
+            result->seconds = wall_time_seconds() - lookup_start;
+            if (opt->target_makespan > 0 && result->makespan <= opt->target_makespan) result->time_to_target = result->seconds;
+            return 1;
+        }
+    }
+    shop_lower_bounds(shop, &result->bounds);
+    result->lower_bound = result->bounds.best;
+    double budget_seconds = opt->budget_seconds > 0.0 ? opt->budget_seconds : 0.0;
+    // The portfolio's B&B has no other stopping rule: without a budget or a node limit it
+    // would search the whole tree
+    if (algorithm == JOBSHOP_ALGO_PORTFOLIO && budget_seconds <= 0.0 && opt->node_limit <= 0) {
+        budget_seconds = JOBSHOP_PORTFOLIO_BUDGET;
+    }
+    incumbent_init(solver->incumbent, shop->njobs, shop->nops, result->lower_bound, budget_seconds);
+    incumbent_set_target(solver->incumbent, opt->target_makespan);
+    // The engines only consult the incumbent when there is a budget or a target to watch
+    Incumbent *budget = (budget_seconds > 0.0 || opt->target_makespan > 0) ? solver->incumbent : NULL;
+
+    BBRun run;
+    bb_run_init(&run);
+    run.use_propagation = opt->propagate;
+    run.deterministic = opt->deterministic;
+    run.stop_at = result->lower_bound;
+    if (opt->node_limit > 0) run.node_limit = opt->node_limit;
+    run.incumbent = budget;
+    run.stats = &result->stats;
+    if (algorithm == JOBSHOP_ALGO_SB_SEQ || algorithm == JOBSHOP_ALGO_SB_PAR) solver->sb_ws->stats = &result->stats;
+
+    double start_time = wall_time_seconds();
+    int makespan = INT_MAX;
+    switch (algorithm) {
+        case JOBSHOP_ALGO_SB_SEQ:
+            if (shifting_bottleneck_schedule_ws(shop, solver->sb_ws, NULL, NULL)) makespan = schedule_makespan(shop);
+            if (makespan != INT_MAX && opt->left_shift) makespan = left_shift_sb(shop, makespan, result->lower_bound, &result->stats);
+            result->source = INCUMBENT_SRC_SB;
+            result->sb_threads = 1;
+            break;
+        case JOBSHOP_ALGO_SB_PAR:
+            solver->sb_ws->placement = &opt->placement;
+            if (shifting_bottleneck_schedule_par(shop, solver->sb_ws, threads, budget, NULL)) makespan = schedule_makespan(shop);
+            solver->sb_ws->placement = NULL;
+            if (makespan != INT_MAX && opt->left_shift) makespan = left_shift_sb(shop, makespan, result->lower_bound, &result->stats);
+            result->truncated = budget && incumbent_should_stop(budget);
+            result->source = INCUMBENT_SRC_SB;
+            result->sb_threads = threads; // JOBSHOP_THREADS_AUTO (0): every pass sizes its team
+            break;
+        case JOBSHOP_ALGO_BB_SEQ:
+        case JOBSHOP_ALGO_BB_PAR:
+            if (algorithm == JOBSHOP_ALGO_BB_SEQ) makespan = solve_branch_and_bound(shop, &run, solver->stime);
+            else {
+                run.placement = &opt->placement;
+                makespan = branch_and_bound_solve(shop, threads, &run, solver->stime);
+            }
+            if (makespan != INT_MAX) stime_to_plan(solver, solver->stime);
+            result->truncated = run.truncated;
+            result->optimal = (makespan != INT_MAX && !run.truncated);
+            result->source = INCUMBENT_SRC_BB;
+            result->bb_threads = run.threads;
+            break;
+        case JOBSHOP_ALGO_PORTFOLIO:
+            // The budget is the limit here unless a node limit was asked for
+            if (opt->node_limit <= 0) run.node_limit = LONG_MAX;
+            run.incumbent = solver->incumbent;
+            makespan = solve_portfolio(solver, threads, opt->left_shift, &run, result);
+            if (makespan != INT_MAX) stime_to_plan(solver, solver->stime);
+            result->truncated = run.truncated;
+            break;
+        default:
+            fprintf(stderr, "jobshop_solver_solve: unknown algorithm %d\n", algorithm);
+            return 0;
+    }
+    result->seconds = wall_time_seconds() - start_time;
+    result->nodes = run.nodes;
+    if (solver->sb_ws) solver->sb_ws->stats = NULL;
+    if (algorithm == JOBSHOP_ALGO_PORTFOLIO) result->stats.incumbent_updates = solver->incumbent->updates;
+    result->stats.peak_rss_kb = stats_peak_rss_kb();
+    result->makespan = makespan;
+    // Engines that publish report the moment they reached the target; SB only has its final answer
+    result->time_to_target = -1.0;
+    if (solver->incumbent->target_hit) result->time_to_target = solver->incumbent->target_time - start_time;
+    else if (opt->target_makespan > 0 && makespan <= opt->target_makespan) result->time_to_target = result->seconds;
+    if (makespan == INT_MAX) return 0;
+    if (makespan == result->lower_bound) result->optimal = 1;
+    if (opt->cache_dir && jobshop_cache_storable(opt, result) &&
+        !jobshop_cache_store(opt->cache_dir, opt->cache_max_mb, cache_key, shop, result)) {
+        fprintf(stderr, "Solution cache: cannot write to %s\n", opt->cache_dir);
+    }
+    return 1;
+}
+
+// Create the directory of an output file if it doesn't exist
+static void ensure_output_dir(const char *filename) {
+    const char *last_slash = strrchr(filename, '/');
+#ifdef _WIN32
+    const char *last_backslash = strrchr(filename, '\\');
+    if (last_backslash > last_slash) last_slash = last_backslash;
+#endif
+    if (last_slash == NULL || last_slash - filename >= 256) return;
+    char dir_path[256];
+    strncpy(dir_path, filename, last_slash - filename);
+    dir_path[last_slash - filename] = '\0';
+    struct stat st = {0};
+    if (stat(dir_path, &st) == -1) {
+#ifdef _WIN32
+        _mkdir(dir_path);
+#else
+        mkdir(dir_path, 0777);
+#endif
+    }
+}
+
+// Full result layout of save_result_seq (the SB executables)
+int jobshop_solver_save_result(const JobshopSolver *solver, const char *filename) {
+    ensure_output_dir(filename);
+    FILE *file = fopen(filename, "a");
+    if (!file) return 0;
+    fclose(file);
+    save_result_seq(filename, (Shop*)&solver->shop);
+    return 1;
+}
+
+// Annex II layout (the B&B and portfolio executables): makespan, then start times per job
+int jobshop_solver_save_start_times(const JobshopSolver *solver, const char *filename) {
+    const Shop *shop = &solver->shop;
+    ensure_output_dir(filename);
+    FILE *file = fopen(filename, "w");
+    if (!file) return 0;
+    fprintf(file, "%d\n", schedule_makespan(shop));
+    for (int j = 0; j < shop->njobs; j++) {
+        for (int op = 0; op < shop->nops; op++) {
+            fprintf(file, "%d ", shop->plan[j][op].stime);
+        }
+        fprintf(file, "\n");
+    }
+    fclose(file);
+    return 1;
+}
+
+// --stats report of the executables: what was solved, how, and the counters of the solve
+int jobshop_result_save_stats(const JobshopResult *result, const JobshopOptions *opt, const char *instance,
+                              const char *filename) {
+    ensure_output_dir(filename);
+    FILE *file = fopen(filename, "w");
+    if (!file) return 0;
+    char *name = extract_basename(instance); // No path separators to escape in the JSON
+    fprintf(file, "{\n  \"instance\": \"%s\",\n  \"algorithm\": \"%s\",\n  \"threads\": %d,\n",
+            name ? name : "unknown", jobshop_algorithm_name(opt->algorithm), opt->threads);
+    free(name);
+    fprintf(file, "  \"makespan\": %d,\n  \"lower_bound\": %d,\n  \"optimal\": %d,\n  \"truncated\": %d,\n  \"seconds\": %.6f,\n  \"cached\": %d,\n",
+            result->makespan == INT_MAX ? -1 : result->makespan, result->lower_bound, result->optimal,
+            result->truncated, result->seconds, result->cached);
+    fprintf(file, "  \"bounds\": {\"job\": %d, \"machine\": %d, \"jackson\": %d},\n  \"gap_percent\": %.4f,\n",
+            result->bounds.job, result->bounds.machine, result->bounds.jackson,
+            result->makespan == INT_MAX ? -1.0 : bound_gap_percent(result->makespan, result->lower_bound));
+    fprintf(file, "  \"stats\": {\n");
+    stats_write_json(file, &result->stats, "    ");
+    fprintf(file, "  }\n}\n");
+    fclose(file);
+    return 1;
+}
@@ -0,0 +1,83 @@
+// jobshop_solver.h
+// libjobshop: handle-based API over all solver engines. Each JobshopSolver owns its problem,
+// its schedule and every work buffer the engines need, and the engines keep no global state,
+// so any number of handles can be created and solved concurrently in one process.
+//
+//   JobshopSolver *s = jobshop_solver_create();
+//   jobshop_solver_load(s, "instance.jss");
+//   JobshopOptions opt;  jobshop_options_init(&opt);  opt.algorithm = JOBSHOP_ALGO_BB_PAR;
+//   JobshopResult res;   jobshop_solver_solve(s, &opt, &res);
+//   ... jobshop_solver_shop(s)->plan[j][o].stime ...
+//   jobshop_solver_destroy(s);
+//
+// Build: static libjobshop.a and shared jobshop.dll / libjobshop.so (see Scripts/build_all.ps1)
+#ifndef JOBSHOP_SOLVER_H
+#define JOBSHOP_SOLVER_H
+
+#include "../Common/jobshop_common.h"
+#include "../Common/jobshop_stats.h"
+#include "../Common/jobshop_parallel.h"
+#include "../Common/jobshop_bounds.h"
+
+#define JOBSHOP_ALGO_SB_SEQ    1   // Shifting Bottleneck, sequential
+#define JOBSHOP_ALGO_SB_PAR    2   // Shifting Bottleneck, machines evaluated in parallel
+#define JOBSHOP_ALGO_BB_SEQ    3   // Depth-first Branch & Bound
+#define JOBSHOP_ALGO_BB_PAR    4   // Branch & Bound, one thread per first-level subtree
+#define JOBSHOP_ALGO_PORTFOLIO 5   // SB and B&B side by side on a shared incumbent
+
+#define JOBSHOP_THREADS_AUTO PARALLEL_AUTO // Size every parallel region from its work
+#define JOBSHOP_PORTFOLIO_BUDGET 60.0      // Portfolio seconds when neither a budget nor a node limit is set
+
+// Per-call options; start from jobshop_options_init
+typedef struct {
+    int algorithm;                 // JOBSHOP_ALGO_*
+    int threads;                   // OpenMP threads for the parallel algorithms, or JOBSHOP_THREADS_AUTO
+    double budget_seconds;         // Wall-clock budget, 0 = none (SB_SEQ always runs one full pass;
+                                   // the portfolio then stops at node_limit or JOBSHOP_PORTFOLIO_BUDGET)
+    long node_limit;               // B&B nodes (per first-level subtree for BB_PAR), 0 = default
+    int propagate;                 // B&B: edge-finding and not-first/not-last at every node
+    int target_makespan;           // Report when a schedule this good is first found, 0 = none
+    int left_shift;                // SB, portfolio: compact the SB schedule with global left shifts (default on)
+    ParallelPlacement placement;   // SB_PAR, BB_PAR: thread pinning and per-node instance copies
+    int deterministic;             // BB_PAR: same schedule for any thread count (without a budget)
+    const char *cache_dir;         // Solution cache (jobshop_cache.h), NULL = always solve
+    int cache_max_mb;              // Size cap of the cache directory
+} JobshopOptions;
+
+typedef struct {
+    int makespan;                  // INT_MAX when no schedule was found
+    int lower_bound;               // Best instance bound; every engine stops when it reaches it
+    ShopBounds bounds;             // Job, machine and Jackson bounds behind lower_bound
+    int optimal;                   // Proven: exhausted B&B tree or makespan == lower_bound
+    int truncated;                 // A node limit or the budget cut the search
+    int source;                    // INCUMBENT_SRC_* engine that produced the schedule
+    long nodes;                    // B&B nodes explored
+    int sb_threads;                // SB team (portfolio: its share), 0 = no SB ran or sized per pass
+    int bb_threads;                // B&B team (BB_PAR: after auto sizing), 0 = no B&B ran
+    double seconds;                // Wall-clock time of the solve
+    double time_to_target;         // Seconds until target_makespan was reached, -1 if never
+    SolverStats stats;             // Search counters, phase times and peak RSS of the solve
+    int cached;                    // Served from the solution cache; seconds is the lookup
+} JobshopResult;
+
+typedef struct JobshopSolver JobshopSolver;
+
+void jobshop_options_init(JobshopOptions *opt);
+const char *jobshop_algorithm_name(int algorithm);
+int jobshop_algorithm_from_name(const char *name);
+int jobshop_threads_from_arg(const char *arg);
+
+JobshopSolver *jobshop_solver_create(void);
+void jobshop_solver_destroy(JobshopSolver *solver);
+int jobshop_solver_load(JobshopSolver *solver, const char *filename);
+int jobshop_solver_set_problem(JobshopSolver *solver, const Shop *shop);
+int jobshop_solver_solve(JobshopSolver *solver, const JobshopOptions *opt, JobshopResult *result);
+void jobshop_solver_reset(JobshopSolver *solver);
+
+const Shop *jobshop_solver_shop(const JobshopSolver *solver);
+int jobshop_solver_save_result(const JobshopSolver *solver, const char *filename);
+int jobshop_solver_save_start_times(const JobshopSolver *solver, const char *filename);
+int jobshop_result_save_stats(const JobshopResult *result, const JobshopOptions *opt, const char *instance,
+                              const char *filename);
+
+#endif // JOBSHOP_SOLVER_H
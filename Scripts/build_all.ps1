@@ -24,17 +24,30 @@ catch {
 }
 
 # Script parameters
-# Define the absolute path to jobshop_common.c
-$CommonCFile = Join-Path $PSScriptRoot "..\\Common\\jobshop_common.c" | Resolve-Path -ErrorAction Stop
+# Define the absolute paths to the shared sources (jobshop_common.c and friends)
+$CommonCFiles = Get-ChildItem -Path (Join-Path $PSScriptRoot "..\\Common") -Filter "*.c" -ErrorAction Stop | ForEach-Object { $_.FullName }
 $CommonHFileDir = Join-Path $PSScriptRoot "..\\Common" | Resolve-Path -ErrorAction Stop # For -I include path
+# libjobshop: the shared sources plus every solver engine; the executables are thin CLIs over it
+$LibDir = Join-Path $PSScriptRoot "..\\Library" | Resolve-Path -ErrorAction Stop
+$LibCFiles = @($CommonCFiles) + @(
+    (Join-Path $PSScriptRoot "..\\Algorithms\\ShiftingBottleneck\\jobshop_seq_sb.c"),
+    (Join-Path $PSScriptRoot "..\\Algorithms\\ShiftingBottleneck\\jobshop_par_sb.c"),
+    (Join-Path $PSScriptRoot "..\\Algorithms\\BranchAndBound\\jobshop_seq_bb.c"),
+    (Join-Path $PSScriptRoot "..\\Algorithms\\BranchAndBound\\jobshop_par_bb.c"),
+    (Join-Path $LibDir "jobshop_solver.c"),
+    (Join-Path $LibDir "jobshop_cache.c"),
+    (Join-Path $LibDir "jobshop_batch.c")
+)
+$LibJobshop = Join-Path $LibDir "libjobshop.a"
 
 # Clean up old executables
 Write-Host "`nCleaning up old executables..." -ForegroundColor White
 Get-ChildItem -Path "../Algorithms" -Filter "*.exe" -Recurse -ErrorAction SilentlyContinue | Remove-Item -Force -ErrorAction SilentlyContinue
+Get-ChildItem -Path "../Library" -Include "*.o", "*.a", "*.dll" -Recurse -ErrorAction SilentlyContinue | Remove-Item -Force -ErrorAction SilentlyContinue
 Write-Host "SUCCESS: Old executables removed" -ForegroundColor Green
 
 # Build counters
-$totalBuilds = 4 # SB Sequential, SB Parallel, BB Sequential, BB Parallel
+$totalBuilds = 17 # libjobshop, SB Sequential, SB Parallel, BB Sequential, BB Parallel, Portfolio, LNS, Rolling Horizon, Reschedule, Streaming, Daemon, Daemon Client, Benchmark, Benchmark Suite, Generator, Validator, Calibration
 $currentBuild = 0
 $successfulBuilds = 0
 $failedBuilds = 0
@@ -42,6 +55,36 @@ $failedBuilds = 0
 
 Pop-Location
 
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING LIBJOBSHOP ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build libjobshop (static libjobshop.a and shared jobshop.dll from the same objects)
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building libjobshop..." -ForegroundColor White
+Push-Location $LibDir
+$libObjects = @()
+$result = ""
+$libOk = $true
+foreach ($src in $LibCFiles) {
+    $obj = [System.IO.Path]::GetFileNameWithoutExtension($src) + ".o"
+    $result = gcc -c -fopenmp -fPIC -o $obj $src -I"$CommonHFileDir" -std=c99 -O2 -Wall 2>&1
+    if ($LASTEXITCODE -ne 0) { $libOk = $false; break }
+    $libObjects += $obj
+}
+if ($libOk) { $result = ar rcs libjobshop.a $libObjects 2>&1; $libOk = ($LASTEXITCODE -eq 0) }
+if ($libOk) { $result = gcc -shared -fopenmp -o jobshop.dll $libObjects -lm 2>&1; $libOk = ($LASTEXITCODE -eq 0) }
+if ($libOk) {
+    Write-Host "SUCCESS: libjobshop compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: libjobshop compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
 Write-Host "`n===========================================" -ForegroundColor Magenta
 Write-Host "=== BUILDING SHIFTING BOTTLENECK ALGORITHMS ===" -ForegroundColor Magenta
 Write-Host "===========================================" -ForegroundColor Magenta
@@ -50,7 +93,7 @@ Write-Host "===========================================" -ForegroundColor Magent
 $currentBuild++
 Write-Host "`n[$currentBuild/$totalBuilds] Building Shifting Bottleneck Sequential Algorithm..." -ForegroundColor White
 Push-Location "$PSScriptRoot/../Algorithms/ShiftingBottleneck"
-$result = gcc -o jobshop_seq_sb.exe jobshop_seq_sb.c "$CommonCFile" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+$result = gcc -fopenmp -o jobshop_seq_sb.exe jobshop_seq_sb_cli.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
 if ($LASTEXITCODE -eq 0) {
     Write-Host "SUCCESS: Shifting Bottleneck Sequential compiled successfully" -ForegroundColor Green
     $successfulBuilds++
@@ -64,7 +107,7 @@ else {
 # Build Shifting Bottleneck Parallel
 $currentBuild++
 Write-Host "`n[$currentBuild/$totalBuilds] Building Shifting Bottleneck Parallel Algorithm..." -ForegroundColor White
-$result = gcc -fopenmp -o jobshop_par_sb.exe jobshop_par_sb.c "$CommonCFile" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+$result = gcc -fopenmp -o jobshop_par_sb.exe jobshop_par_sb_cli.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
 if ($LASTEXITCODE -eq 0) {
     Write-Host "SUCCESS: Shifting Bottleneck Parallel compiled successfully" -ForegroundColor Green
     $successfulBuilds++
@@ -84,7 +127,7 @@ Write-Host "=========================================" -ForegroundColor Magenta
 $currentBuild++
 Write-Host "`n[$currentBuild/$totalBuilds] Building Branch & Bound Sequential Algorithm..." -ForegroundColor White
 Push-Location "$PSScriptRoot/../Algorithms/BranchAndBound"
-$result = gcc -o jobshop_seq_bb.exe jobshop_seq_bb.c "$CommonCFile" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+$result = gcc -fopenmp -o jobshop_seq_bb.exe jobshop_seq_bb_cli.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
 if ($LASTEXITCODE -eq 0) {
     Write-Host "SUCCESS: Branch & Bound Sequential compiled successfully" -ForegroundColor Green
     $successfulBuilds++
@@ -98,7 +141,7 @@ else {
 # Build Branch & Bound Parallel
 $currentBuild++
 Write-Host "`n[$currentBuild/$totalBuilds] Building Branch & Bound Parallel Algorithm..." -ForegroundColor White
-$result = gcc -fopenmp -o jobshop_par_bb.exe jobshop_par_bb.c "$CommonCFile" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+$result = gcc -fopenmp -o jobshop_par_bb.exe jobshop_par_bb_cli.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
 if ($LASTEXITCODE -eq 0) {
     Write-Host "SUCCESS: Branch & Bound Parallel compiled successfully" -ForegroundColor Green
     $successfulBuilds++
@@ -110,6 +153,246 @@ else {
 }
 Pop-Location
 
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING PORTFOLIO SOLVER ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Portfolio
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Portfolio Solver..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Portfolio"
+$result = gcc -fopenmp -o jobshop_portfolio.exe jobshop_portfolio.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Portfolio Solver compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Portfolio Solver compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING LARGE NEIGHBOURHOOD SEARCH ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build LNS
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building LNS..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/LNS"
+$result = gcc -fopenmp -o jobshop_lns.exe jobshop_lns.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: LNS compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: LNS compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING ROLLING HORIZON DECOMPOSITION ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Rolling Horizon
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Rolling Horizon..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/RollingHorizon"
+$result = gcc -fopenmp -o jobshop_rolling_sb.exe jobshop_rolling_sb.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Rolling Horizon compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Rolling Horizon compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING INCREMENTAL RESCHEDULING ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Reschedule
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Reschedule..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Reschedule"
+$result = gcc -fopenmp -o jobshop_reschedule.exe jobshop_reschedule.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Reschedule compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Reschedule compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING STREAMING SCHEDULER ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Streaming
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Streaming..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Streaming"
+$result = gcc -fopenmp -o jobshop_stream.exe jobshop_stream.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Streaming compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Streaming compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING SCHEDULING DAEMON ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Daemon
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Daemon..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Daemon"
+$result = gcc -fopenmp -o jobshop_daemon.exe jobshop_daemon.c jobshop_socket.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm -lws2_32 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Daemon compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Daemon compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING DAEMON CLIENT ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Daemon Client
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Daemon Client..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Daemon"
+$result = gcc -fopenmp -o jobshop_client.exe jobshop_client.c jobshop_socket.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm -lws2_32 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Daemon Client compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Daemon Client compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING BENCHMARK DRIVER ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Benchmark
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Benchmark..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Benchmark"
+$result = gcc -fopenmp -o jobshop_bench.exe jobshop_bench.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Benchmark compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Benchmark compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING CLASSIC BENCHMARK SUITE ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Benchmark Suite
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Benchmark Suite..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Benchmark"
+$result = gcc -fopenmp -o jobshop_suite.exe jobshop_suite.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Benchmark Suite compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Benchmark Suite compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING INSTANCE GENERATOR ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Generator
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Generator..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Generator"
+$result = gcc -fopenmp -o jobshop_generate.exe jobshop_generate.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Generator compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Generator compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING SCHEDULE VALIDATOR ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Validator
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Validator..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Validator"
+$result = gcc -fopenmp -o jobshop_validate.exe jobshop_validate.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Validator compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Validator compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
+Write-Host "`n=========================================" -ForegroundColor Magenta
+Write-Host "=== BUILDING CALIBRATION ===" -ForegroundColor Magenta
+Write-Host "=========================================" -ForegroundColor Magenta
+
+# Build Calibration
+$currentBuild++
+Write-Host "`n[$currentBuild/$totalBuilds] Building Calibration..." -ForegroundColor White
+Push-Location "$PSScriptRoot/../Algorithms/Calibration"
+$result = gcc -fopenmp -o jobshop_calibrate.exe jobshop_calibrate.c "$LibJobshop" -I"$CommonHFileDir" -std=c99 -O2 -Wall -lm 2>&1
+if ($LASTEXITCODE -eq 0) {
+    Write-Host "SUCCESS: Calibration compiled successfully" -ForegroundColor Green
+    $successfulBuilds++
+}
+else {
+    Write-Host "ERROR: Calibration compilation failed" -ForegroundColor Red
+    Write-Host $result -ForegroundColor Red
+    $failedBuilds++
+}
+Pop-Location
+
 # Build Summary
 Write-Host "`n==========================================" -ForegroundColor Cyan
 Write-Host "=== BUILD SUMMARY ===" -ForegroundColor Cyan
@@ -126,10 +409,24 @@ Write-Host "  -> Success rate: $successRate%" -ForegroundColor White
 # Verify executables exist
 Write-Host "`nVerifying built executables:" -ForegroundColor White
 $executables = @(
+    @{Path = "$PSScriptRoot/../Library/libjobshop.a"; Name = "libjobshop (static)" },
+    @{Path = "$PSScriptRoot/../Library/jobshop.dll"; Name = "libjobshop (shared)" },
     @{Path = "$PSScriptRoot/../Algorithms/ShiftingBottleneck/jobshop_seq_sb.exe"; Name = "SB Sequential" },
     @{Path = "$PSScriptRoot/../Algorithms/ShiftingBottleneck/jobshop_par_sb.exe"; Name = "SB Parallel" },
     @{Path = "$PSScriptRoot/../Algorithms/BranchAndBound/jobshop_seq_bb.exe"; Name = "BB Sequential" },
-    @{Path = "$PSScriptRoot/../Algorithms/BranchAndBound/jobshop_par_bb.exe"; Name = "BB Parallel" }
+    @{Path = "$PSScriptRoot/../Algorithms/BranchAndBound/jobshop_par_bb.exe"; Name = "BB Parallel" },
+    @{Path = "$PSScriptRoot/../Algorithms/Portfolio/jobshop_portfolio.exe"; Name = "Portfolio" },
+    @{Path = "$PSScriptRoot/../Algorithms/LNS/jobshop_lns.exe"; Name = "LNS" },
+    @{Path = "$PSScriptRoot/../Algorithms/RollingHorizon/jobshop_rolling_sb.exe"; Name = "Rolling Horizon" },
+    @{Path = "$PSScriptRoot/../Algorithms/Reschedule/jobshop_reschedule.exe"; Name = "Reschedule" },
+    @{Path = "$PSScriptRoot/../Algorithms/Streaming/jobshop_stream.exe"; Name = "Streaming" },
+    @{Path = "$PSScriptRoot/../Algorithms/Daemon/jobshop_daemon.exe"; Name = "Daemon" },
+    @{Path = "$PSScriptRoot/../Algorithms/Daemon/jobshop_client.exe"; Name = "Daemon Client" },
+    @{Path = "$PSScriptRoot/../Algorithms/Benchmark/jobshop_bench.exe"; Name = "Benchmark" },
+    @{Path = "$PSScriptRoot/../Algorithms/Benchmark/jobshop_suite.exe"; Name = "Benchmark Suite" },
+    @{Path = "$PSScriptRoot/../Algorithms/Generator/jobshop_generate.exe"; Name = "Generator" },
+    @{Path = "$PSScriptRoot/../Algorithms/Validator/jobshop_validate.exe"; Name = "Validator" },
+    @{Path = "$PSScriptRoot/../Algorithms/Calibration/jobshop_calibrate.exe"; Name = "Calibration" }
 )
 
 foreach ($exe in $executables) {
@@ -0,0 +1,114 @@
+# =============================================================================
+# FETCH CLASSIC JOB SHOP BENCHMARK INSTANCES
+# =============================================================================
+# Downloads the classic instances listed in Data/Classic/bks.csv and converts them to the
+# .jss format of Data/ (first line "jobs machines", then one line of "machine duration"
+# pairs per job, machines 0-based):
+#   OR-Library jobshop1.txt: ft06/ft10/ft20, la01-la40, abz5-abz9, orb01-orb10, swv01-swv20
+#   Taillard's files:        ta01-ta80 (times matrix + 1-based machines matrix per instance)
+# Existing files are kept unless -Force is given.
+
+param(
+    [string]$OutputDir = (Join-Path $PSScriptRoot "..\Data\Classic"),
+    [string]$OrLibraryUrl = "http://people.brunel.ac.uk/~mastjjb/jeb/orlib/files/jobshop1.txt",
+    [string]$TaillardBaseUrl = "http://mistic.heig-vd.ch/taillard/problemes.dir/ordonnancement.dir/jobshop.dir",
+    [switch]$Force
+)
+
+Write-Host "=============================================" -ForegroundColor Cyan
+Write-Host "=== FETCHING CLASSIC BENCHMARK INSTANCES ===" -ForegroundColor Cyan
+Write-Host "=============================================" -ForegroundColor Cyan
+
+$bksFile = Join-Path $OutputDir "bks.csv"
+if (!(Test-Path $bksFile)) {
+    Write-Host "ERROR: $bksFile not found" -ForegroundColor Red
+    exit 1
+}
+$wanted = @{}
+Get-Content $bksFile | Where-Object { $_ -notmatch '^\s*#' -and $_ -notmatch '^name,' -and $_.Trim() } | ForEach-Object {
+    $wanted[($_ -split ',')[0]] = $true
+}
+
+$written = 0
+$skipped = 0
+
+function Save-Instance {
+    param($name, $jobs, $machines, $lines)
+    $file = Join-Path $OutputDir "$name.jss"
+    if (-not $wanted.ContainsKey($name)) {
+        return
+    }
+    if ((Test-Path $file) -and -not $Force) {
+        $script:skipped++
+        return
+    }
+    @("$jobs $machines") + $lines | Out-File -FilePath $file -Encoding ascii
+    $script:written++
+}
+
+# OR-Library: "instance <name>", a description, "<jobs> <machines>", then one row per job
+Write-Host "`nDownloading OR-Library jobshop1.txt..." -ForegroundColor White
+try {
+    $orlib = (Invoke-WebRequest -Uri $OrLibraryUrl -UseBasicParsing).Content -split "`r?`n"
+    for ($i = 0; $i -lt $orlib.Count; $i++) {
+        if ($orlib[$i] -match '^\s*instance\s+(\S+)') {
+            $name = $Matches[1]
+            $j = $i + 1
+            while ($j -lt $orlib.Count -and $orlib[$j] -notmatch '^\s*\d+\s+\d+\s*$') { $j++ }
+            if ($j -ge $orlib.Count) { break }
+            $size = $orlib[$j].Trim() -split '\s+'
+            $jobs = [int]$size[0]
+            $machines = [int]$size[1]
+            $rows = @()
+            for ($k = 1; $k -le $jobs; $k++) {
+                $rows += (($orlib[$j + $k].Trim()) -split '\s+') -join ' '
+            }
+            Save-Instance $name $jobs $machines $rows
+            $i = $j + $jobs
+        }
+    }
+    Write-Host "SUCCESS: OR-Library instances processed" -ForegroundColor Green
+}
+catch {
+    Write-Host "ERROR: could not download $OrLibraryUrl ($($_.Exception.Message))" -ForegroundColor Red
+}
+
+# Taillard: per instance a header line, "Times", jobs rows, "Machines", jobs rows (1-based)
+$taillardFiles = @("tai15_15.txt", "tai20_15.txt", "tai20_20.txt", "tai30_15.txt",
+                   "tai30_20.txt", "tai50_15.txt", "tai50_20.txt", "tai100_20.txt")
+$taIndex = 0
+foreach ($taFile in $taillardFiles) {
+    Write-Host "Downloading $taFile..." -ForegroundColor White
+    try {
+        $lines = (Invoke-WebRequest -Uri "$TaillardBaseUrl/$taFile" -UseBasicParsing).Content -split "`r?`n"
+    }
+    catch {
+        Write-Host "ERROR: could not download $taFile ($($_.Exception.Message))" -ForegroundColor Red
+        $taIndex += 10
+        continue
+    }
+    for ($i = 0; $i -lt $lines.Count; $i++) {
+        if ($lines[$i] -notmatch '^\s*Times') { continue }
+        $header = ($lines[$i - 1].Trim()) -split '\s+'
+        $jobs = [int]$header[0]
+        $machines = [int]$header[1]
+        $taIndex++
+        $rows = @()
+        for ($k = 1; $k -le $jobs; $k++) {
+            $times = ($lines[$i + $k].Trim()) -split '\s+'
+            $machs = ($lines[$i + $jobs + 1 + $k].Trim()) -split '\s+'
+            $pairs = @()
+            for ($o = 0; $o -lt $machines; $o++) {
+                $pairs += "$([int]$machs[$o] - 1) $($times[$o])"
+            }
+            $rows += $pairs -join ' '
+        }
+        Save-Instance ("ta{0:D2}" -f $taIndex) $jobs $machines $rows
+        $i += 2 * $jobs + 1
+    }
+}
+
+Write-Host "`n=============================================" -ForegroundColor Cyan
+Write-Host "Instances written: $written, already present: $skipped" -ForegroundColor White
+Write-Host "Output directory: $OutputDir" -ForegroundColor White
+Write-Host "Run: jobshop_suite.exe ..\..\Data\Classic\bks.csv ..\..\Data\Classic results.json" -ForegroundColor Gray
@@ -86,9 +86,13 @@ $defaultConfig = @{
             }
         }
     }
+    benchmark  = @{
+        executable = "..\\\\Algorithms\\\\Benchmark\\\\jobshop_bench.exe"
+    }
     settings   = @{
         verbose         = $true
-        repetitions     = 10000 # Default repetitions, can be overridden by config file
+        warmup          = 1  # Untimed runs before each measurement
+        repetitions     = 10 # Timed runs per algorithm and thread count, can be overridden by config file
         generateReports = $true
         cleanBefore     = $true
     }
@@ -159,7 +163,7 @@ if ($QuickTest) {
         }
     }
     if ($config.settings) {
-        $config.settings.repetitions = 1000
+        $config.settings.repetitions = 3
     }
 }
 
@@ -185,6 +189,10 @@ foreach ($algorithmName in $config.algorithms.PSObject.Properties.Name) {
     }
 }
 
+if (!$config.benchmark -or !(Test-Path $config.benchmark.executable)) {
+    $missingExecutables += if ($config.benchmark) { $config.benchmark.executable } else { "benchmark.executable (missing from $ConfigFile)" }
+}
+
 if ($missingExecutables.Count -gt 0) {
     Write-Host "ERROR: Missing executables:" -ForegroundColor Red
     $missingExecutables | ForEach-Object { Write-Host "  - $_" -ForegroundColor Red }
@@ -222,133 +230,47 @@ foreach ($algorithmName in $config.algorithms.PSObject.Properties.Name) {
     }
 }
 
-# Enhanced makespan extraction with validation
-function Get-Makespan {
-    param($filePath)
-    if (Test-Path $filePath) {
-        try {
-            $content = Get-Content $filePath
-            # Check for different output formats
-            foreach ($line in $content) {
-                # Format 1: Number on first line (original format)
-                if ($line -match '^\d+$') {
-                    return [int]$line
-                }
-                # Format 2: "Best makespan: X" (Branch & Bound format)
-                if ($line -match 'Best makespan:\s*(\d+)') {
-                    return [int]$matches[1]
-                }
-                # Format 3: "Makespan: X" (alternative format)
-                if ($line -match 'Makespan:\s*(\d+)') {
-                    return [int]$matches[1]
-                }
-            }
-        }
-        catch {
-            Write-Warning "Failed to extract makespan from $filePath"
-        }
-    }
-    return $null
+# Benchmark families: config algorithm name -> short names understood by jobshop_bench
+$benchmarkAlgorithms = @{
+    ShiftingBottleneck = @{ Sequential = "sb_seq"; Parallel = "sb_par" }
+    BranchAndBound     = @{ Sequential = "bb_seq"; Parallel = "bb_par" }
 }
 
-# Enhanced operation distribution analysis
-function Get-OperationDistribution {
-    param($filePath, $threads)
-    if (!(Test-Path $filePath)) {
-        return @{
-            Display         = "No data available"
-            JobCount        = 0
-            TotalOps        = 0
-            AvgOpsPerThread = 0
-        }
-    }
-    
-    try {
-        $content = Get-Content $filePath
-        if ($content.Count -lt 2) {
-            return @{
-                Display         = "Invalid file format"
-                JobCount        = 0
-                TotalOps        = 0
-                AvgOpsPerThread = 0
-            }
-        }
-        
-        # Skip first line (makespan) and count operations per job
-        $jobCount = $content.Count - 1
-        $totalOperations = 0
-        
-        for ($i = 1; $i -lt $content.Count; $i++) {
-            $operations = ($content[$i] -split " ").Count
-            if ($operations -gt 0) {
-                $totalOperations += $operations
-            }
-        }
-        
-        $avgOpsPerThread = if ($threads -gt 0) { [math]::Round($totalOperations / $threads, 1) } else { 0 }
-        
-        return @{
-            Display         = "Jobs: $jobCount, Total Ops: $totalOperations, Avg Ops/Thread: $avgOpsPerThread"
-            JobCount        = $jobCount
-            TotalOps        = $totalOperations
-            AvgOpsPerThread = $avgOpsPerThread
-        }
-    }
-    catch {
-        return @{
-            Display         = "Analysis failed"
-            JobCount        = 0
-            TotalOps        = 0
-            AvgOpsPerThread = 0
-        }
+# Run jobshop_bench for one algorithm family on one dataset and return the parsed JSON
+function Invoke-Benchmark {
+    param($algorithmName, $algorithm, $dataset, $jsonFile, $warmup, $repetitions)
+    $names = @()
+    if ($algorithm.sequential -and $algorithm.sequential.enabled) { $names += $benchmarkAlgorithms[$algorithmName].Sequential }
+    if ($algorithm.parallel -and $algorithm.parallel.enabled) { $names += $benchmarkAlgorithms[$algorithmName].Parallel }
+    $threadList = if ($algorithm.parallel) { ($algorithm.parallel.threadCounts -join ",") } else { "1" }
+
+    & $benchmarkExecutable "../Data/$($dataset.Name).jss" $jsonFile $warmup $repetitions $threadList ($names -join ",") | Out-Null
+    if ($LASTEXITCODE -ne 0 -or !(Test-Path $jsonFile)) {
+        return $null
     }
+    return Get-Content $jsonFile -Raw | ConvertFrom-Json
 }
 
-# Performance metrics calculation
+# Performance metrics straight from the benchmark JSON (wall-clock medians, speedup and
+# efficiency computed by jobshop_bench against the sequential baseline)
 function Get-PerformanceMetrics {
-    param($results, $dataset)
+    param($benchmark)
     
     $metrics = @{
         BestMakespan       = 999999
-        BestAlgorithm      = ""
         BestImplementation = ""
         SpeedupData        = @{}
         EfficiencyData     = @{}
     }
     
-    $sequentialTime = $null
-    
-    # Find best makespan and collect speedup data
-    foreach ($algName in $results.Keys) {
-        if ($results[$algName].ContainsKey("Sequential")) {
-            $seqResult = $results[$algName]["Sequential"]
-            if ($seqResult.Makespan -lt $metrics.BestMakespan) {
-                $metrics.BestMakespan = $seqResult.Makespan
-                $metrics.BestAlgorithm = $algName
-                $metrics.BestImplementation = "Sequential"
-            }
-            
-            if (-not $sequentialTime -or $seqResult.Time -lt $sequentialTime) {
-                $sequentialTime = $seqResult.Time
-            }
+    foreach ($entry in $benchmark.results) {
+        if ($entry.makespan -lt $metrics.BestMakespan) {
+            $metrics.BestMakespan = $entry.makespan
+            $metrics.BestImplementation = $entry.implementation
         }
-        
-        # Check parallel implementations
-        foreach ($implName in $results[$algName].Keys) {
-            $result = $results[$algName][$implName]
-            if ($result.Makespan -lt $metrics.BestMakespan) {
-                $metrics.BestMakespan = $result.Makespan
-                $metrics.BestAlgorithm = $algName
-                $metrics.BestImplementation = $implName
-            }
-            
-            # Calculate speedup for parallel implementations
-            if ($implName -like "Parallel_*" -and $sequentialTime) {
-                $speedup = $sequentialTime / $result.Time
-                $efficiency = $speedup / $result.ThreadCount * 100
-                $metrics.SpeedupData["$algName-$implName"] = [math]::Round($speedup, 2)
-                $metrics.EfficiencyData["$algName-$implName"] = [math]::Round($efficiency, 1)
-            }
+        if ($null -ne $entry.speedup) {
+            $metrics.SpeedupData[$entry.implementation] = [math]::Round($entry.speedup, 2)
+            $metrics.EfficiencyData[$entry.implementation] = [math]::Round($entry.efficiency, 1)
         }
     }
     
@@ -358,175 +280,85 @@ function Get-PerformanceMetrics {
 # Create result storage for analysis
 $results = @{}
 
-# Calculate total tests
-$totalTests = 0
+$benchmarkExecutable = $config.benchmark.executable
+$warmup = if ($config.settings -and $null -ne $config.settings.warmup) { $config.settings.warmup } else { 1 }
+$repetitions = if ($config.settings -and $config.settings.repetitions) { $config.settings.repetitions } else { 10 }
+
+# One benchmark run per enabled algorithm family and dataset
+$enabledAlgorithms = @()
 foreach ($algorithmName in $config.algorithms.PSObject.Properties.Name) {
     $algorithm = $config.algorithms.$algorithmName
-    if ($algorithm.sequential -and $algorithm.sequential.enabled) {
-        $totalTests += $config.datasets.Count
+    if (-not $benchmarkAlgorithms.ContainsKey($algorithmName)) {
+        continue
     }
-    if ($algorithm.parallel -and $algorithm.parallel.enabled) {
-        $totalTests += $config.datasets.Count * $algorithm.parallel.threadCounts.Count
+    if (($algorithm.sequential -and $algorithm.sequential.enabled) -or
+        ($algorithm.parallel -and $algorithm.parallel.enabled)) {
+        $enabledAlgorithms += $algorithmName
     }
 }
+$totalTests = $enabledAlgorithms.Count * @($config.datasets).Count
 
 Write-Host "`n=============================================" -ForegroundColor Magenta
-Write-Host "=== RUNNING ALGORITHM TESTS (Total: $totalTests) ===" -ForegroundColor Magenta
+Write-Host "=== RUNNING BENCHMARKS (Total: $totalTests) ===" -ForegroundColor Magenta
 Write-Host "=============================================" -ForegroundColor Magenta
+Write-Host "Warmup runs: $warmup, timed repetitions: $repetitions" -ForegroundColor Gray
 
 $testCount = 0
 
-# Run sequential tests for each enabled algorithm
-foreach ($algorithmName in $config.algorithms.PSObject.Properties.Name) {
+foreach ($algorithmName in $enabledAlgorithms) {
     $algorithm = $config.algorithms.$algorithmName
+    Write-Host "`n--- Benchmarking $algorithmName ---" -ForegroundColor Yellow
     
-    if ($algorithm.sequential -and $algorithm.sequential.enabled) {
-        Write-Host "`n--- Testing $algorithmName Sequential ---" -ForegroundColor Yellow
+    foreach ($dataset in $config.datasets) {
+        $testCount++
+        Write-Host "`n[$testCount/$totalTests] ${algorithmName}: $($dataset.Category) ($($dataset.Size))" -ForegroundColor White
+        # Verify dataset file exists
+        if (!(Test-Path "../Data/$($dataset.Name).jss")) {
+            Write-Host "  ERROR: Dataset file not found!" -ForegroundColor Red
+            continue
+        }
         
-        foreach ($dataset in $config.datasets) {
-            $testCount++
-            Write-Host "`n[$testCount/$totalTests] $algorithmName Sequential: $($dataset.Category) ($($dataset.Size))" -ForegroundColor White
-            # Verify dataset file exists
-            if (!(Test-Path "../Data/$($dataset.Name).jss")) {
-                Write-Host "  ERROR: Dataset file not found!" -ForegroundColor Red
-                continue
-            }
-            
-            # Create output files
-            $resultFile = "..\Result\$algorithmName\$($dataset.Category)\sequential_result.txt"
-            $logFile = "..\Logs\$algorithmName\$($dataset.Category)\sequential_log.txt"
-            
-            # Run algorithm
-            Write-Host "  -> Executing $algorithmName sequential algorithm..." -ForegroundColor Gray
-            $startTime = Get-Date
-            & ".\$($algorithm.sequential.executable)" "../Data/$($dataset.Name).jss" $resultFile 2>$null
-            $endTime = Get-Date
-            $duration = ($endTime - $startTime).TotalMilliseconds
-            
-            if ($LASTEXITCODE -eq 0) {
-                # Extract makespan
-                $makespan = Get-Makespan $resultFile
-                
-                # Get operation distribution
-                $opDistribution = Get-OperationDistribution $resultFile 1
-                
-                Write-Host "  -> SUCCESS: Completed in $([math]::Round($duration, 0))ms (Makespan: $makespan)" -ForegroundColor Green
-                
-                # Store results
-                if (-not $results.ContainsKey("$algorithmName-$($dataset.Category)")) {
-                    $results["$algorithmName-$($dataset.Category)"] = @{}
-                }
-                $results["$algorithmName-$($dataset.Category)"]["Sequential"] = @{
-                    Time           = $duration
-                    Makespan       = $makespan
-                    OpDistribution = $opDistribution.Display
-                    OpData         = $opDistribution
-                    ResultFile     = $resultFile
-                    Algorithm      = $algorithmName
-                    Implementation = "Sequential"
-                }
-                
-                # Create detailed log
-                $logContent = @"
-=== $algorithmName SEQUENTIAL ALGORITHM RESULTS ===
-Dataset: $($dataset.Category) ($($dataset.Size))
-Input File: Data/$($dataset.Name).jss
-Output File: $resultFile
-Execution Time: $([math]::Round($duration, 2))ms
-Makespan: $makespan
-Operation Distribution: $($opDistribution.Display)
-Algorithm: $algorithmName Sequential
-Timestamp: $(Get-Date)
-
-=== RESULT ANALYSIS ===
-Total scheduling time (makespan): $makespan time units
-Algorithm efficiency: Sequential processing
-All operations executed in single thread
-Jobs processed: $($opDistribution.JobCount)
-Total operations: $($opDistribution.TotalOps)
-"@
-                $logContent | Out-File -FilePath $logFile -Encoding UTF8
-            }
-            else {
-                Write-Host "  -> FAILED: $algorithmName sequential execution failed" -ForegroundColor Red
-            }
+        $jsonFile = "..\Result\$algorithmName\$($dataset.Category)\benchmark.json"
+        $logFile = "..\Logs\$algorithmName\$($dataset.Category)\benchmark_log.txt"
+        
+        Write-Host "  -> Executing jobshop_bench..." -ForegroundColor Gray
+        $benchmark = Invoke-Benchmark $algorithmName $algorithm $dataset $jsonFile $warmup $repetitions
+        if ($null -eq $benchmark) {
+            Write-Host "  -> FAILED: $algorithmName benchmark failed" -ForegroundColor Red
+            continue
         }
-    }
-    
-    # Run parallel tests if enabled
-    if ($algorithm.parallel -and $algorithm.parallel.enabled) {
-        Write-Host "`n--- Testing $algorithmName Parallel ---" -ForegroundColor Yellow
-        foreach ($dataset in $config.datasets) {
-            # Verify dataset file exists
-            if (!(Test-Path "../Data/$($dataset.Name).jss")) {
-                Write-Host "  ERROR: Dataset file not found!" -ForegroundColor Red
-                continue
-            }
-            
-            foreach ($threads in $algorithm.parallel.threadCounts) {
-                $testCount++
-                Write-Host "`n[$testCount/$totalTests] $algorithmName Parallel ($threads threads): $($dataset.Category) ($($dataset.Size))" -ForegroundColor White
-                
-                # Create output files
-                $resultFile = "..\Result\$algorithmName\$($dataset.Category)\parallel_${threads}threads_result.txt"
-                $logFile = "..\Logs\$algorithmName\$($dataset.Category)\parallel_${threads}threads_log.txt"                # Run parallel algorithm
-                Write-Host "  -> Executing $algorithmName parallel algorithm with $threads threads..." -ForegroundColor Gray
-                $startTime = Get-Date
-                & "$($algorithm.parallel.executable)" "../Data/$($dataset.Name).jss" $resultFile $threads 2>$null
-                $endTime = Get-Date
-                $duration = ($endTime - $startTime).TotalMilliseconds
-                
-                if ($LASTEXITCODE -eq 0) {
-                    # Extract makespan
-                    $makespan = Get-Makespan $resultFile
-                    
-                    # Get operation distribution
-                    $opDistribution = Get-OperationDistribution $resultFile $threads
-                    
-                    Write-Host "  -> SUCCESS: Completed in $([math]::Round($duration, 0))ms (Makespan: $makespan)" -ForegroundColor Green
-                    
-                    # Store results
-                    if (-not $results.ContainsKey("$algorithmName-$($dataset.Category)")) {
-                        $results["$algorithmName-$($dataset.Category)"] = @{}
-                    }
-                    $results["$algorithmName-$($dataset.Category)"]["Parallel_${threads}threads"] = @{
-                        Time           = $duration
-                        Makespan       = $makespan
-                        OpDistribution = $opDistribution.Display
-                        OpData         = $opDistribution
-                        ResultFile     = $resultFile
-                        ThreadCount    = $threads
-                        Algorithm      = $algorithmName
-                        Implementation = "Parallel_${threads}threads"
-                    }
-                    
-                    # Create detailed log
-                    $logContent = @"
-=== $algorithmName PARALLEL ALGORITHM RESULTS ===
+        
+        $metrics = Get-PerformanceMetrics $benchmark
+        if (-not $results.ContainsKey("$algorithmName-$($dataset.Category)")) {
+            $results["$algorithmName-$($dataset.Category)"] = @{}
+        }
+        $logContent = @"
+=== $algorithmName BENCHMARK RESULTS ===
 Dataset: $($dataset.Category) ($($dataset.Size))
 Input File: Data/$($dataset.Name).jss
-Output File: $resultFile
-Execution Time: $([math]::Round($duration, 2))ms
-Thread Count: $threads
-Makespan: $makespan
-Operation Distribution: $($opDistribution.Display)
-Algorithm: $algorithmName Parallel
+Benchmark File: $jsonFile
+Warmup: $($benchmark.warmup), Repetitions: $($benchmark.repetitions) (monotonic wall clock)
+Best Makespan: $($metrics.BestMakespan) ($($metrics.BestImplementation))
 Timestamp: $(Get-Date)
 
-=== RESULT ANALYSIS ===
-Total scheduling time (makespan): $makespan time units
-Thread utilization: $threads threads
-Jobs processed: $($opDistribution.JobCount)
-Total operations: $($opDistribution.TotalOps)
-Average operations per thread: $($opDistribution.AvgOpsPerThread)
 "@
-                    $logContent | Out-File -FilePath $logFile -Encoding UTF8
-                }
-                else {
-                    Write-Host "  -> FAILED: $algorithmName parallel execution failed" -ForegroundColor Red
-                }
+        foreach ($entry in $benchmark.results) {
+            $results["$algorithmName-$($dataset.Category)"][$entry.implementation] = @{
+                Time           = $entry.time_ms.median
+                P95            = $entry.time_ms.p95
+                Stddev         = $entry.time_ms.stddev
+                Makespan       = $entry.makespan
+                ThreadCount    = $entry.threads
+                Speedup        = $entry.speedup
+                Efficiency     = $entry.efficiency
+                Algorithm      = $algorithmName
+                Implementation = $entry.implementation
             }
+            $speedupText = if ($null -ne $entry.speedup) { "speedup $([math]::Round($entry.speedup, 2)), efficiency $([math]::Round($entry.efficiency, 1))%" } else { "baseline" }
+            Write-Host "  -> $($entry.implementation): makespan $($entry.makespan), median $([math]::Round($entry.time_ms.median, 3))ms, p95 $([math]::Round($entry.time_ms.p95, 3))ms, $speedupText" -ForegroundColor Green
+            $logContent += "$($entry.implementation): makespan $($entry.makespan), min $($entry.time_ms.min)ms, median $($entry.time_ms.median)ms, p95 $($entry.time_ms.p95)ms, stddev $($entry.time_ms.stddev)ms, $speedupText`n"
         }
+        $logContent | Out-File -FilePath $logFile -Encoding UTF8
     }
 }
 
@@ -563,8 +395,8 @@ foreach ($key in $results.Keys) {
 
 foreach ($dataset in $datasetGroups.Keys | Sort-Object) {
     $reportContent += "`n--- $dataset Results ---`n"
-    $reportContent += "Algorithm".PadRight(20) + "Implementation".PadRight(20) + "Makespan".PadRight(12) + "Time(ms)".PadRight(12) + "Operation Distribution`n"
-    $reportContent += ("-" * 100) + "`n"
+    $reportContent += "Algorithm".PadRight(20) + "Implementation".PadRight(20) + "Makespan".PadRight(12) + "Median(ms)".PadRight(12) + "P95(ms)".PadRight(12) + "Stddev(ms)".PadRight(12) + "Speedup".PadRight(10) + "Efficiency`n"
+    $reportContent += ("-" * 110) + "`n"
     
     foreach ($algorithm in $datasetGroups[$dataset].Keys | Sort-Object) {
         $algorithmResults = $datasetGroups[$dataset][$algorithm]
@@ -572,9 +404,13 @@ foreach ($dataset in $datasetGroups.Keys | Sort-Object) {
         foreach ($implementation in $algorithmResults.Keys | Sort-Object) {
             $result = $algorithmResults[$implementation]
             $makespan = if ($result.Makespan) { $result.Makespan.ToString() } else { "N/A" }
-            $time = [math]::Round($result.Time, 1).ToString()
+            $time = [math]::Round($result.Time, 3).ToString()
+            $p95 = [math]::Round($result.P95, 3).ToString()
+            $stddev = [math]::Round($result.Stddev, 3).ToString()
+            $speedup = if ($null -ne $result.Speedup) { [math]::Round($result.Speedup, 2).ToString() } else { "-" }
+            $efficiency = if ($null -ne $result.Efficiency) { "$([math]::Round($result.Efficiency, 1))%" } else { "-" }
             
-            $reportContent += $algorithm.PadRight(20) + $implementation.PadRight(20) + $makespan.PadRight(12) + $time.PadRight(12) + $result.OpDistribution + "`n"
+            $reportContent += $algorithm.PadRight(20) + $implementation.PadRight(20) + $makespan.PadRight(12) + $time.PadRight(12) + $p95.PadRight(12) + $stddev.PadRight(12) + $speedup.PadRight(10) + $efficiency + "`n"
         }
     }
 }
@@ -585,8 +421,8 @@ $reportContent += @"
 
 This report compares the performance of different scheduling algorithms:
 * Makespan: Lower values indicate better scheduling efficiency
-* Execution Time: Algorithm computational performance
-* Operation Distribution: How work is divided among threads (for parallel implementations)
+* Median/P95/Stddev: Wall-clock solve time over the timed repetitions, after warmup
+* Speedup: Sequential median / parallel median; Efficiency: speedup per thread
 
 === ALGORITHM DESCRIPTIONS ===
 * Greedy: Earliest start time heuristic
@@ -596,7 +432,7 @@ This report compares the performance of different scheduling algorithms:
 * ShiftingBottleneck: Shifting Bottleneck heuristic
 
 === FILES GENERATED ===
-* Results: Result/[Algorithm]/[Category]/
+* Benchmarks: Result/[Algorithm]/[Category]/benchmark.json
 * Logs: Logs/[Algorithm]/[Category]/
 * Configuration: $ConfigFile
 